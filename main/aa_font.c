@@ -0,0 +1,127 @@
+/*
+ * aa_font.c - Anti-aliased proportional bitmap fonts
+ *
+ * See aa_font.h.
+ */
+
+#include <limits.h>
+#include <stddef.h>
+#include "aa_font.h"
+
+static const aa_glyph_t *glyph_for(const aa_font_t *font, char c)
+{
+    uint8_t ch = (uint8_t)c;
+    if (ch < font->first_char || ch > font->last_char) {
+        ch = ' ';
+    }
+    return &font->glyphs[ch - font->first_char];
+}
+
+uint16_t aa_font_text_width(const aa_font_t *font, const char *text)
+{
+    return aa_font_text_width_n(font, text, INT_MAX);
+}
+
+uint16_t aa_font_text_width_n(const aa_font_t *font, const char *text, int len)
+{
+    uint32_t width = 0;
+
+    for (int i = 0; i < len && text[i]; i++) {
+        uint8_t ch = (uint8_t)text[i];
+        if (ch < font->first_char || ch > font->last_char) {
+            ch = ' ';
+        }
+        width += font->advances[ch - font->first_char];
+    }
+    return (width > UINT16_MAX) ? UINT16_MAX : (uint16_t)width;
+}
+
+int aa_font_fit_chars(const aa_font_t *font, const char *text, uint16_t max_width, uint16_t *fit_width)
+{
+    uint32_t width = 0;
+    int count = 0;
+
+    for (; text[count]; count++) {
+        uint8_t advance = glyph_for(font, text[count])->advance;
+        if (width + advance > max_width) {
+            break;
+        }
+        width += advance;
+    }
+    if (fit_width != NULL) {
+        *fit_width = (uint16_t)width;
+    }
+    return count;
+}
+
+/**
+ * Blend a big-endian RGB565 pixel towards color by alpha/15
+ */
+static inline uint16_t blend_be(uint16_t dst_be, int fr, int fg, int fb, int alpha)
+{
+    uint16_t dst = (uint16_t)((dst_be << 8) | (dst_be >> 8));
+    int r = dst >> 11;
+    int g = (dst >> 5) & 0x3F;
+    int b = dst & 0x1F;
+
+    // x * 17 / 256 approximates x / 15 for x up to 15 * 63
+    r += ((fr - r) * alpha * 17 + 128) >> 8;
+    g += ((fg - g) * alpha * 17 + 128) >> 8;
+    b += ((fb - b) * alpha * 17 + 128) >> 8;
+
+    uint16_t out = (uint16_t)((r << 11) | (g << 5) | b);
+    return (uint16_t)((out << 8) | (out >> 8));
+}
+
+void aa_font_draw(const aa_font_t *font, const char *text, int len, uint16_t color,
+                  uint16_t *band, int band_width, int band_height, int band_y, int x, int y)
+{
+    uint16_t color_be = (uint16_t)((color << 8) | (color >> 8));
+    int fr = color >> 11;
+    int fg = (color >> 5) & 0x3F;
+    int fb = color & 0x1F;
+
+    // Nothing on this line can reach the band
+    if (y >= band_y + band_height || y + font->line_height <= band_y) {
+        return;
+    }
+
+    for (int i = 0; i < len && text[i]; i++) {
+        const aa_glyph_t *glyph = glyph_for(font, text[i]);
+        const uint8_t *bits = font->bitmaps + glyph->offset;
+        int gx = x + glyph->x_offset;
+        int gy = y + glyph->y_offset - band_y;     // Glyph top in band rows
+
+        // Visible rows of this glyph within the band
+        int row_start = (gy < 0) ? -gy : 0;
+        int row_end = glyph->height;
+        if (gy + row_end > band_height) {
+            row_end = band_height - gy;
+        }
+
+        for (int row = row_start; row < row_end; row++) {
+            uint16_t *dst = band + (gy + row) * band_width;
+            int index = row * glyph->width;
+
+            for (int col = 0; col < glyph->width; col++, index++) {
+                int px = gx + col;
+                if (px < 0 || px >= band_width) {
+                    continue;
+                }
+
+                uint8_t packed = bits[index >> 1];
+                int alpha = (index & 1) ? (packed & 0x0F) : (packed >> 4);
+                if (alpha == 15) {
+                    dst[px] = color_be;
+                } else if (alpha != 0) {
+                    dst[px] = blend_be(dst[px], fr, fg, fb, alpha);
+                }
+            }
+        }
+
+        x += glyph->advance;
+        if (x >= band_width) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * aa_font.h - Anti-aliased proportional bitmap fonts
+ *
+ * Fonts are generated offline by tools/gen_font.py into const arrays (flash).
+ * Each glyph is a width x height block of 4-bit alpha values, row-major, two
+ * pixels per byte with the first pixel in the high nibble. Glyphs have their
+ * own bounding box, placed relative to the pen position (x) and the top of
+ * the text line (y). There is no kerning; the advance table alone defines
+ * text width, so measuring a string never touches the bitmaps.
+ *
+ * Rendering blends into a caller-owned RGB565 band buffer (a horizontal
+ * slice of the target area, pixels in panel byte order) so text can be
+ * composed with its background and sent to the display in one burst.
+ */
+
+#ifndef AA_FONT_H
+#define AA_FONT_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t offset;        // Byte offset of the glyph in the bitmap array
+    uint8_t width;
+    uint8_t height;
+    int8_t x_offset;        // From the pen position to the left of the bitmap
+    int8_t y_offset;        // From the top of the line to the top of the bitmap
+    uint8_t advance;        // Pen advance in pixels
+} aa_glyph_t;
+
+typedef struct {
+    const uint8_t *bitmaps;
+    const aa_glyph_t *glyphs;
+    const uint8_t *advances;    // Same as glyphs[].advance, packed for width measurement
+    uint8_t first_char;
+    uint8_t last_char;
+    uint8_t ascent;             // Top of line to baseline
+    uint8_t line_height;        // Ascent + descent
+} aa_font_t;
+
+// 15 px sans serif (generated, main/font_sans15.c)
+extern const aa_font_t font_sans15;
+
+/**
+ * Width in pixels of a string (sum of advances, O(n), no rendering)
+ */
+uint16_t aa_font_text_width(const aa_font_t *font, const char *text);
+
+/**
+ * Width in pixels of the first len characters of text (stops early at NUL)
+ */
+uint16_t aa_font_text_width_n(const aa_font_t *font, const char *text, int len);
+
+/**
+ * Number of leading characters of text that fit in max_width pixels.
+ * If fit_width is not NULL it receives the width of those characters.
+ */
+int aa_font_fit_chars(const aa_font_t *font, const char *text, uint16_t max_width, uint16_t *fit_width);
+
+/**
+ * Blend the first len characters of text into a band buffer
+ *
+ * band:        band_width x band_height pixels, RGB565 in panel (big-endian) byte order
+ * band_y:      y coordinate of the band's first row in text coordinates
+ * x, y:        pen position and top of the text line in band coordinates (x) and
+ *              text coordinates (y); everything outside the band is clipped
+ */
+void aa_font_draw(const aa_font_t *font, const char *text, int len, uint16_t color,
+                  uint16_t *band, int band_width, int band_height, int band_y, int x, int y);
+
+#endif // AA_FONT_H
@@ -0,0 +1,66 @@
+/*
+ * cpu_load.c - Per-core and per-task CPU load from run-time counter snapshots
+ *
+ * See cpu_load.h.
+ */
+
+#include <string.h>
+#include "cpu_load.h"
+
+static uint16_t permille(uint32_t part, uint32_t whole)
+{
+    uint64_t value = (uint64_t)part * 1000 / whole;
+    return (value > 1000) ? 1000 : (uint16_t)value;
+}
+
+static const cpu_load_task_t *find_task(const cpu_load_snapshot_t *snapshot, uint32_t id)
+{
+    for (int i = 0; i < snapshot->count; i++) {
+        if (snapshot->tasks[i].id == id) {
+            return &snapshot->tasks[i];
+        }
+    }
+    return NULL;
+}
+
+bool cpu_load_compute(const cpu_load_snapshot_t *before, const cpu_load_snapshot_t *after, cpu_load_t *load)
+{
+    memset(load, 0, sizeof(*load));
+    // Unsigned differences stay correct across one counter wrap
+    load->elapsed = after->total_run_time - before->total_run_time;
+    if (load->elapsed == 0) {
+        return false;
+    }
+
+    for (int c = 0; c < CPU_LOAD_CORES; c++) {
+        load->core_permille[c] = CPU_LOAD_UNKNOWN;
+    }
+
+    for (int i = 0; i < after->count; i++) {
+        const cpu_load_task_t *task = &after->tasks[i];
+        const cpu_load_task_t *earlier = find_task(before, task->id);
+        uint32_t run_time = task->run_time - (earlier ? earlier->run_time : 0);
+
+        if (task->idle) {
+            if (task->core >= 0 && task->core < CPU_LOAD_CORES) {
+                load->core_permille[task->core] = 1000 - permille(run_time, load->elapsed);
+            }
+            continue;
+        }
+        if (load->count == CPU_LOAD_MAX_TASKS) {
+            continue;
+        }
+
+        // Insertion keeps the list sorted, busiest first
+        int pos = load->count++;
+        while (pos > 0 && load->tasks[pos - 1].run_time < run_time) {
+            load->tasks[pos] = load->tasks[pos - 1];
+            pos--;
+        }
+        load->tasks[pos].name = task->name;
+        load->tasks[pos].core = task->core;
+        load->tasks[pos].run_time = run_time;
+        load->tasks[pos].permille = permille(run_time, load->elapsed);
+    }
+    return true;
+}
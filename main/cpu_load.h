@@ -0,0 +1,60 @@
+/*
+ * cpu_load.h - Per-core and per-task CPU load from run-time counter snapshots
+ *
+ * FreeRTOS run-time stats give every task a counter of the time it has spent
+ * running. Two snapshots taken some time apart turn those into loads: each
+ * core's idle task ran for whatever the core did not spend on other work, so
+ * a core's load is 1 - idle / elapsed, and each task's share of one core is
+ * its own delta over the same elapsed time. Tasks are matched by task number;
+ * one created between the snapshots counts from zero, one deleted is dropped.
+ *
+ * The snapshots are filled by the caller (uxTaskGetSystemState() on the
+ * device), so the unit tests compute loads from made-up counter values.
+ */
+
+#ifndef CPU_LOAD_H
+#define CPU_LOAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CPU_LOAD_CORES          2
+#define CPU_LOAD_MAX_TASKS      24
+#define CPU_LOAD_NAME_LEN       16
+#define CPU_LOAD_NO_CORE        (-1)        // Task may run on either core
+#define CPU_LOAD_UNKNOWN        0xFFFF      // Core without an idle task in the snapshots
+
+typedef struct {
+    uint32_t id;                        // Task number (unique for the task's lifetime)
+    char name[CPU_LOAD_NAME_LEN];
+    int8_t core;                        // Pinned core or CPU_LOAD_NO_CORE
+    bool idle;                          // The idle task of its core
+    uint32_t run_time;                  // Run-time counter
+} cpu_load_task_t;
+
+typedef struct {
+    uint32_t total_run_time;            // Run-time clock when the snapshot was taken
+    int count;
+    cpu_load_task_t tasks[CPU_LOAD_MAX_TASKS];
+} cpu_load_snapshot_t;
+
+typedef struct {
+    const char *name;                   // Points into the later snapshot
+    int8_t core;
+    uint32_t run_time;                  // Counter delta between the snapshots
+    uint16_t permille;                  // Share of one core
+} cpu_load_entry_t;
+
+typedef struct {
+    uint32_t elapsed;                           // Run-time clock delta
+    uint16_t core_permille[CPU_LOAD_CORES];     // Busy share, or CPU_LOAD_UNKNOWN
+    int count;
+    cpu_load_entry_t tasks[CPU_LOAD_MAX_TASKS]; // Non-idle tasks, busiest first
+} cpu_load_t;
+
+/**
+ * Loads between two snapshots; false if no run time elapsed between them
+ */
+bool cpu_load_compute(const cpu_load_snapshot_t *before, const cpu_load_snapshot_t *after, cpu_load_t *load);
+
+#endif // CPU_LOAD_H
@@ -0,0 +1,513 @@
+/*
+ * display_list.c - Retained drawing commands rasterized one band at a time
+ *
+ * See display_list.h.
+ */
+
+#include <string.h>
+#include "display_list.h"
+
+#define SWAP16(c)   ((uint16_t)(((c) << 8) | ((c) >> 8)))
+
+#define FNV_OFFSET  2166136261u
+#define FNV_PRIME   16777619u
+
+void dl_init(display_list_t *list, uint16_t width, uint16_t height,
+             const uint8_t (*font)[5], const aa_font_t *aa_font)
+{
+    list->width = width;
+    list->height = height;
+    list->font = font;
+    list->aa_font = aa_font;
+    dl_clear(list, 0x0000);
+}
+
+void dl_clear(display_list_t *list, uint16_t clear_color)
+{
+    list->clear_color = clear_color;
+    list->count = 0;
+    list->pool_used = 0;
+}
+
+bool dl_has_room(const display_list_t *list, size_t text_len)
+{
+    return list->count < DL_MAX_ITEMS && list->pool_used + text_len + 1 <= DL_TEXT_POOL;
+}
+
+/**
+ * Append an item, copying len bytes of text into the pool
+ */
+static dl_item_t *add_item(display_list_t *list, dl_op_t op, const char *text, size_t len)
+{
+    if (!dl_has_room(list, text ? len : 0)) {
+        return NULL;
+    }
+
+    dl_item_t *item = &list->items[list->count++];
+    memset(item, 0, sizeof(*item));
+    item->op = (uint8_t)op;
+    if (text) {
+        item->text = list->pool_used;
+        item->len = (uint16_t)len;
+        memcpy(&list->pool[list->pool_used], text, len);
+        list->pool[list->pool_used + len] = '\0';
+        list->pool_used += (uint16_t)(len + 1);
+    }
+    return item;
+}
+
+/**
+ * Clip a box to the target; false if nothing is left
+ */
+static bool clip_box(const display_list_t *list, dl_item_t *item,
+                     uint16_t x, uint16_t y, uint32_t w, uint32_t h)
+{
+    if (x >= list->width || y >= list->height || w == 0 || h == 0) {
+        return false;
+    }
+    item->x = x;
+    item->y = y;
+    item->w = (uint16_t)((x + w > list->width) ? (uint32_t)(list->width - x) : w);
+    item->h = (uint16_t)((y + h > list->height) ? (uint32_t)(list->height - y) : h);
+    return true;
+}
+
+static uint32_t fnv1a(uint32_t hash, const void *data, size_t len)
+{
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static bool boxes_overlap(const dl_item_t *a, const dl_item_t *b)
+{
+    return a->x < b->x + b->w && b->x < a->x + a->w &&
+           a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+/**
+ * Hash the last item's parameters together with the items painted below it
+ */
+static void seal_item(display_list_t *list)
+{
+    dl_item_t *item = &list->items[list->count - 1];
+    uint16_t fields[] = { item->op, item->size, item->x, item->y, item->w, item->h,
+                          item->color, item->bg, (uint16_t)item->origin_x };
+    uintptr_t icon = (uintptr_t)item->icon;
+    uint32_t hash = FNV_OFFSET;
+
+    hash = fnv1a(hash, fields, sizeof(fields));
+    hash = fnv1a(hash, &icon, sizeof(icon));
+    hash = fnv1a(hash, &list->pool[item->text], item->len);
+    for (uint16_t i = 0; i + 1 < list->count; i++) {
+        if (boxes_overlap(&list->items[i], item)) {
+            hash = fnv1a(hash, &list->items[i].hash, sizeof(uint32_t));
+        }
+    }
+    item->hash = hash;
+}
+
+static bool box_inside(const dl_item_t *item, const dl_rect_t *r)
+{
+    return item->x >= r->x && item->x + item->w <= r->x + r->w &&
+           item->y >= r->y && item->y + item->h <= r->y + r->h;
+}
+
+void dl_copy_except(display_list_t *dst, const display_list_t *src, const dl_rect_t *cut, int cut_count)
+{
+    dl_clear(dst, src->clear_color);
+    for (uint16_t i = 0; i < src->count; i++) {
+        const dl_item_t *from = &src->items[i];
+        bool removed = false;
+        for (int c = 0; c < cut_count && !removed; c++) {
+            removed = box_inside(from, &cut[c]);
+        }
+        if (removed) {
+            continue;
+        }
+
+        // Same capacity as src, so this always fits
+        dl_item_t *item = add_item(dst, (dl_op_t)from->op, from->len ? &src->pool[from->text] : NULL, from->len);
+        uint16_t text = item->text;
+        *item = *from;
+        item->text = text;
+        seal_item(dst);     // What lies below it may have changed
+    }
+}
+
+bool dl_fill(display_list_t *list, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    dl_item_t *item = add_item(list, DL_FILL, NULL, 0);
+    if (!item) {
+        return false;
+    }
+    item->color = color;
+    if (!clip_box(list, item, x, y, w, h)) {
+        list->count--;      // Off screen: accepted, nothing to draw
+    } else {
+        seal_item(list);
+    }
+    return true;
+}
+
+/**
+ * Walk the 5x7 text layout (same wrapping as ili9341_draw_string)
+ *
+ * Calls visit for each character cell; returns the bottom of the last line.
+ */
+typedef void (*text_visit_t)(const display_list_t *list, const dl_item_t *item, char c,
+                             uint16_t x, uint16_t y, void *ctx);
+
+static uint32_t text_layout(const display_list_t *list, const dl_item_t *item, text_visit_t visit, void *ctx)
+{
+    const char *text = &list->pool[item->text];
+    uint16_t size = item->size;
+    uint32_t cursor_x = item->x;
+    uint32_t cursor_y = item->y;
+    uint32_t bottom = item->y;
+
+    for (uint16_t i = 0; i < item->len; i++) {
+        if (text[i] == '\n') {
+            cursor_x = item->x;
+            cursor_y += 8 * size;
+            continue;
+        }
+        if (cursor_x + 6 * size > list->width) {
+            cursor_x = item->x;
+            cursor_y += 8 * size;
+        }
+        if (cursor_y + 7 * size > list->height) {
+            break;
+        }
+        if (visit) {
+            visit(list, item, text[i], (uint16_t)cursor_x, (uint16_t)cursor_y, ctx);
+        }
+        bottom = cursor_y + 7 * size;
+        cursor_x += 6 * size;
+    }
+    return bottom;
+}
+
+bool dl_text(display_list_t *list, uint16_t x, uint16_t y, const char *text,
+             uint16_t color, uint16_t bg, uint8_t size)
+{
+    size_t len = strlen(text);
+    dl_item_t *item = add_item(list, DL_TEXT, text, len);
+    if (!item) {
+        return false;
+    }
+    item->color = color;
+    item->bg = bg;
+    item->size = size ? size : 1;
+    item->x = x;
+    item->y = y;
+
+    // Rows only: wrapped lines restart at x, so the box spans to the right edge
+    uint32_t bottom = text_layout(list, item, NULL, NULL);
+    if (!clip_box(list, item, x, y, list->width - (x < list->width ? x : 0), bottom - y)) {
+        list->count--;
+        list->pool_used -= (uint16_t)(len + 1);
+    } else {
+        seal_item(list);
+    }
+    return true;
+}
+
+bool dl_text_aa(display_list_t *list, uint16_t x, uint16_t y, const char *text, int len, uint16_t color)
+{
+    size_t n = 0;
+    while ((int)n < len && text[n]) {
+        n++;
+    }
+    dl_item_t *item = add_item(list, DL_TEXT_AA, text, n);
+    if (!item) {
+        return false;
+    }
+    item->color = color;
+    item->origin_x = (int16_t)x;
+
+    // Glyph bitmaps may reach slightly past the pen positions on either side
+    uint16_t left = (x > DL_AA_OVERHANG) ? x - DL_AA_OVERHANG : 0;
+    uint32_t width = aa_font_text_width_n(list->aa_font, text, (int)n) + (x - left) + DL_AA_OVERHANG;
+    if (!clip_box(list, item, left, y, width, list->aa_font->line_height)) {
+        list->count--;
+        list->pool_used -= (uint16_t)(n + 1);
+    } else {
+        seal_item(list);
+    }
+    return true;
+}
+
+bool dl_icon(display_list_t *list, uint16_t x, uint16_t y, const icon_t *icon, uint16_t bg)
+{
+    dl_item_t *item = add_item(list, DL_ICON, NULL, 0);
+    if (!item) {
+        return false;
+    }
+    item->icon = icon;
+    item->bg = bg;
+    if (!clip_box(list, item, x, y, icon->width, icon->height)) {
+        list->count--;
+    } else {
+        seal_item(list);
+    }
+    return true;
+}
+
+// =============================================================================
+// RASTERIZATION
+// =============================================================================
+
+typedef struct {
+    uint16_t *buf;
+    dl_rect_t area;
+} area_ctx_t;
+
+static void render_char(const display_list_t *list, const dl_item_t *item, char c,
+                        uint16_t x, uint16_t y, void *ctx)
+{
+    area_ctx_t *a = ctx;
+    uint16_t size = item->size;
+    uint16_t cell_h = 7 * size;
+    uint16_t cell_w = 6 * size;
+    bool opaque = item->bg != item->color;
+    uint16_t fg_be = SWAP16(item->color);
+    uint16_t bg_be = SWAP16(item->bg);
+
+    if (y >= a->area.y + a->area.h || y + cell_h <= a->area.y ||
+        x >= a->area.x + a->area.w || x + cell_w <= a->area.x) {
+        return;
+    }
+    if ((uint8_t)c < 32 || (uint8_t)c > 126) {
+        c = ' ';
+    }
+    const uint8_t *glyph = list->font[c - 32];
+
+    uint16_t row_start = (y < a->area.y) ? a->area.y - y : 0;
+    uint16_t row_end = (y + cell_h > a->area.y + a->area.h) ? a->area.y + a->area.h - y : cell_h;
+    uint16_t col_start = (x < a->area.x) ? a->area.x - x : 0;
+    uint16_t col_end = (x + cell_w > a->area.x + a->area.w) ? a->area.x + a->area.w - x : cell_w;
+
+    for (uint16_t row = row_start; row < row_end; row++) {
+        uint16_t *dst = a->buf + (y + row - a->area.y) * a->area.w + x - a->area.x;
+        uint8_t row_bit = (uint8_t)(1 << (row / size));
+        for (uint16_t col = col_start; col < col_end; col++) {
+            uint16_t dot = col / size;
+            if (dot < 5 && (glyph[dot] & row_bit)) {
+                dst[col] = fg_be;
+            } else if (opaque) {
+                dst[col] = bg_be;
+            }
+        }
+    }
+}
+
+static void render_icon(const dl_item_t *item, area_ctx_t *a)
+{
+    const icon_t *icon = item->icon;
+    icon_decoder_t dec;
+    uint16_t chunk[64];
+    uint32_t pos = 0;
+
+    // Decode from the top up to the end of the area (icons are small)
+    uint32_t last_row = a->area.y + a->area.h - item->y;
+    if (last_row > icon->height) {
+        last_row = icon->height;
+    }
+    uint32_t stop = last_row * icon->width;
+
+    icon_decode_begin(&dec, icon, item->bg);
+    while (pos < stop) {
+        uint32_t want = stop - pos;
+        uint32_t n = icon_decode(&dec, chunk, want < 64 ? want : 64);
+        if (n == 0) {
+            break;
+        }
+        for (uint32_t k = 0; k < n; k++) {
+            uint32_t row = (pos + k) / icon->width;
+            uint32_t col = (pos + k) % icon->width;
+            uint32_t x = item->x + col;
+            uint32_t y = item->y + row;
+            if (y >= a->area.y && col < item->w && x >= a->area.x && x < (uint32_t)(a->area.x + a->area.w)) {
+                a->buf[(y - a->area.y) * a->area.w + x - a->area.x] = chunk[k];
+            }
+        }
+        pos += n;
+    }
+}
+
+void dl_render_rect(const display_list_t *list, const dl_rect_t *rect, uint16_t *buf)
+{
+    uint16_t clear_be = SWAP16(list->clear_color);
+    uint32_t pixels = (uint32_t)rect->w * rect->h;
+    area_ctx_t ctx = { buf, *rect };
+    uint16_t right = rect->x + rect->w;
+    uint16_t bottom = rect->y + rect->h;
+
+    for (uint32_t i = 0; i < pixels; i++) {
+        buf[i] = clear_be;
+    }
+
+    for (uint16_t i = 0; i < list->count; i++) {
+        const dl_item_t *item = &list->items[i];
+
+        // Skip items that do not reach this area
+        if (item->y >= bottom || item->y + item->h <= rect->y ||
+            item->x >= right || item->x + item->w <= rect->x) {
+            continue;
+        }
+
+        switch (item->op) {
+            case DL_FILL: {
+                uint16_t color_be = SWAP16(item->color);
+                uint16_t x0 = (item->x > rect->x) ? item->x : rect->x;
+                uint16_t x1 = (item->x + item->w < right) ? item->x + item->w : right;
+                uint16_t y0 = (item->y > rect->y) ? item->y : rect->y;
+                uint16_t y1 = (item->y + item->h < bottom) ? item->y + item->h : bottom;
+                for (uint16_t y = y0; y < y1; y++) {
+                    uint16_t *dst = buf + (y - rect->y) * rect->w - rect->x;
+                    for (uint16_t x = x0; x < x1; x++) {
+                        dst[x] = color_be;
+                    }
+                }
+                break;
+            }
+
+            case DL_TEXT:
+                text_layout(list, item, render_char, &ctx);
+                break;
+
+            case DL_TEXT_AA:
+                aa_font_draw(list->aa_font, &list->pool[item->text], item->len, item->color,
+                             buf, rect->w, rect->h, rect->y, item->origin_x - rect->x, item->y);
+                break;
+
+            case DL_ICON:
+                render_icon(item, &ctx);
+                break;
+        }
+    }
+}
+
+void dl_render_band(const display_list_t *list, uint16_t band_y, uint16_t rows, uint16_t *band)
+{
+    dl_rect_t rect = { 0, band_y, list->width, rows };
+    dl_render_rect(list, &rect, band);
+}
+
+// =============================================================================
+// DAMAGE
+// =============================================================================
+
+static uint32_t rect_area(const dl_rect_t *r)
+{
+    return (uint32_t)r->w * r->h;
+}
+
+static dl_rect_t rect_union(const dl_rect_t *a, const dl_rect_t *b)
+{
+    uint16_t x0 = (a->x < b->x) ? a->x : b->x;
+    uint16_t y0 = (a->y < b->y) ? a->y : b->y;
+    uint16_t x1 = (a->x + a->w > b->x + b->w) ? a->x + a->w : b->x + b->w;
+    uint16_t y1 = (a->y + a->h > b->y + b->h) ? a->y + a->h : b->y + b->h;
+    dl_rect_t u = { x0, y0, (uint16_t)(x1 - x0), (uint16_t)(y1 - y0) };
+    return u;
+}
+
+static bool rects_overlap(const dl_rect_t *a, const dl_rect_t *b)
+{
+    return a->x < b->x + b->w && b->x < a->x + a->w &&
+           a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+/**
+ * Add r to the damage set, keeping the rectangles disjoint and at most max
+ *
+ * Overlapping rectangles are merged; when the set is full, r is merged with
+ * the rectangle whose union with it adds the least area.
+ */
+static void add_damage(dl_rect_t *rects, int *count, int max, dl_rect_t r)
+{
+    for (;;) {
+        int merge = -1;
+        uint32_t best_cost = UINT32_MAX;
+
+        for (int i = 0; i < *count; i++) {
+            if (rects_overlap(&rects[i], &r)) {
+                merge = i;
+                break;
+            }
+            if (*count == max) {
+                dl_rect_t u = rect_union(&rects[i], &r);
+                uint32_t cost = rect_area(&u) - rect_area(&rects[i]);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    merge = i;
+                }
+            }
+        }
+
+        if (merge < 0) {
+            rects[(*count)++] = r;
+            return;
+        }
+        r = rect_union(&rects[merge], &r);
+        rects[merge] = rects[--*count];
+    }
+}
+
+static bool has_hash(const display_list_t *list, uint32_t hash)
+{
+    for (uint16_t i = 0; i < list->count; i++) {
+        if (list->items[i].hash == hash) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Damage the box of every item of a that has no identical item in b
+ */
+static void diff_items(const display_list_t *a, const display_list_t *b,
+                       dl_rect_t *rects, int *count, int max)
+{
+    for (uint16_t i = 0; i < a->count; i++) {
+        const dl_item_t *item = &a->items[i];
+        if (!has_hash(b, item->hash)) {
+            dl_rect_t box = { item->x, item->y, item->w, item->h };
+            add_damage(rects, count, max, box);
+        }
+    }
+}
+
+int dl_diff(const display_list_t *prev, const display_list_t *next, dl_rect_t *rects, int max_rects)
+{
+    dl_rect_t full = { 0, 0, next->width, next->height };
+    int count = 0;
+
+    if (max_rects > DL_MAX_DAMAGE) {
+        max_rects = DL_MAX_DAMAGE;
+    }
+    if (prev->width != next->width || prev->height != next->height ||
+        prev->clear_color != next->clear_color) {
+        rects[0] = full;
+        return 1;
+    }
+
+    diff_items(next, prev, rects, &count, max_rects);     // Drawn or moved
+    diff_items(prev, next, rects, &count, max_rects);     // Removed (uncovers what was below)
+
+    uint32_t damaged = 0;
+    for (int i = 0; i < count; i++) {
+        damaged += rect_area(&rects[i]);
+    }
+    if (damaged * 100 > rect_area(&full) * DL_FULL_DAMAGE_PERCENT) {
+        rects[0] = full;
+        return 1;
+    }
+    return count;
+}
@@ -0,0 +1,127 @@
+/*
+ * display_list.h - Retained drawing commands rasterized one band at a time
+ *
+ * A screen is recorded as a list of primitives (filled rectangles, 5x7 text,
+ * anti-aliased text, compressed icons) and later rasterized into horizontal
+ * bands of full-width pixels in panel byte order, in painter's order. The
+ * caller sends each band while the next one is rasterized, so a full screen
+ * never needs a framebuffer.
+ *
+ * Text is copied into the list's string pool, so callers may pass temporary
+ * buffers. Icons and fonts are referenced (they live in flash).
+ *
+ * Lists are retained: dl_diff() compares the list of the screen on the panel
+ * with the list of the next one and returns the few rectangles whose pixels
+ * can differ, so a redraw only rasterizes and sends those (dl_render_rect()).
+ * Each item carries a hash of its own parameters combined with the hashes of
+ * the earlier items it overlaps, so an item counts as unchanged only if it and
+ * everything painted below it are unchanged.
+ */
+
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "aa_font.h"
+#include "icon.h"
+
+#define DL_MAX_ITEMS    128
+#define DL_TEXT_POOL    2048    // Bytes of text (including terminators) per list
+#define DL_MAX_DAMAGE   4       // Rectangles returned by dl_diff()
+#define DL_FULL_DAMAGE_PERCENT 60   // Above this much damaged area, dl_diff() returns the full target
+#define DL_AA_OVERHANG  2       // Pixels anti-aliased glyphs may reach outside their advances
+
+typedef enum {
+    DL_FILL,        // Solid rectangle
+    DL_TEXT,        // 5x7 font string (ili9341_draw_string layout)
+    DL_TEXT_AA,     // Anti-aliased string, blended over what is below
+    DL_ICON         // Compressed icon
+} dl_op_t;
+
+typedef struct {
+    uint8_t op;
+    uint8_t size;           // DL_TEXT scale
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;             // Bounding box, clipped to the target
+    uint16_t h;
+    uint16_t color;
+    uint16_t bg;            // DL_TEXT background (== color: transparent), DL_ICON transparent color
+    uint16_t text;          // Offset of the string in the pool
+    uint16_t len;
+    int16_t origin_x;       // DL_TEXT_AA pen start (the box includes DL_AA_OVERHANG)
+    uint32_t hash;          // Item and everything below it (see dl_diff())
+    const icon_t *icon;
+} dl_item_t;
+
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+} dl_rect_t;
+
+typedef struct {
+    uint16_t width;                     // Target size in pixels
+    uint16_t height;
+    uint16_t clear_color;               // Pixels no item covers
+    const uint8_t (*font)[5];           // 5x7 font for DL_TEXT (95 glyphs from ' ')
+    const aa_font_t *aa_font;           // Font for DL_TEXT_AA
+    uint16_t count;
+    uint16_t pool_used;
+    dl_item_t items[DL_MAX_ITEMS];
+    char pool[DL_TEXT_POOL];
+} display_list_t;
+
+/**
+ * Initialize an empty list for a width x height target
+ */
+void dl_init(display_list_t *list, uint16_t width, uint16_t height,
+             const uint8_t (*font)[5], const aa_font_t *aa_font);
+
+/**
+ * Remove all items; clear_color fills whatever the next items leave uncovered
+ */
+void dl_clear(display_list_t *list, uint16_t clear_color);
+
+/**
+ * Whether one more item with text_len bytes of text fits
+ */
+bool dl_has_room(const display_list_t *list, size_t text_len);
+
+/**
+ * Make dst a copy of src without the items lying entirely inside one of the
+ * cut rectangles (the caller repaints those areas by appending to dst)
+ */
+void dl_copy_except(display_list_t *dst, const display_list_t *src, const dl_rect_t *cut, int cut_count);
+
+// Append a primitive; false if the list is full (nothing is added)
+bool dl_fill(display_list_t *list, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+bool dl_text(display_list_t *list, uint16_t x, uint16_t y, const char *text,
+             uint16_t color, uint16_t bg, uint8_t size);
+bool dl_text_aa(display_list_t *list, uint16_t x, uint16_t y, const char *text, int len, uint16_t color);
+bool dl_icon(display_list_t *list, uint16_t x, uint16_t y, const icon_t *icon, uint16_t bg);
+
+/**
+ * Rasterize target rows [band_y, band_y + rows) into band (list->width x rows pixels)
+ */
+void dl_render_band(const display_list_t *list, uint16_t band_y, uint16_t rows, uint16_t *band);
+
+/**
+ * Rasterize the target area inside rect into buf (rect->w x rect->h pixels)
+ */
+void dl_render_rect(const display_list_t *list, const dl_rect_t *rect, uint16_t *buf);
+
+/**
+ * Damage between the screen drawn from prev and the one drawn from next
+ *
+ * Writes at most max_rects (<= DL_MAX_DAMAGE) disjoint rectangles covering every
+ * pixel that can differ and returns how many; 0 if the screens are identical.
+ * Returns a single full-target rectangle if the clear color or size changed or
+ * the damage exceeds DL_FULL_DAMAGE_PERCENT of the target.
+ */
+int dl_diff(const display_list_t *prev, const display_list_t *next, dl_rect_t *rects, int max_rects);
+
+#endif // DISPLAY_LIST_H
@@ -0,0 +1,365 @@
+/*
+ * font_sans15.c - 15 px anti-aliased proportional font (4-bit alpha)
+ *
+ * GENERATED FILE - do not edit. Regenerate with:
+ *   python3 tools/gen_font.py Lato-Regular.ttf 15 sans15 main/font_sans15.c
+ *
+ * Glyph outlines from Lato Regular, Copyright (c) 2010-2013 by tyPoland Lukasz Dziedzic
+ * (http://www.typoland.com/) with Reserved Font Name "Lato". Licensed under the
+ * SIL Open Font License, Version 1.1 (http://scripts.sil.org/OFL).
+ *
+ * Full license text: licenses/OFL-Lato.txt
+ */
+
+#include "aa_font.h"
+
+static const uint8_t sans15_bitmaps[3677] = {
+    0x0B, 0x30, 0xF4, 0x0F, 0x40, 0xF4, 0x0F, 0x40, 0xF4, 0x0F, 0x20, 0x40, 0x00, 0x02, 0xB3, 0x3F,
+    0x70, 0x00, 0x83, 0x38, 0xB4, 0x4B, 0xB4, 0x4B, 0xB3, 0x4A, 0x00, 0x00, 0x00, 0x08, 0x30, 0x93,
+    0x00, 0x00, 0xF2, 0x0F, 0x10, 0x00, 0x3E, 0x04, 0xD0, 0x01, 0x89, 0xD8, 0xAD, 0x82, 0x28, 0xBB,
+    0x8C, 0xB7, 0x10, 0x0B, 0x60, 0xB5, 0x00, 0x24, 0xE7, 0x4F, 0x62, 0x06, 0xCF, 0xBC, 0xFB, 0x80,
+    0x04, 0xC0, 0x5B, 0x00, 0x00, 0x89, 0x08, 0x80, 0x00, 0x0A, 0x70, 0xA6, 0x00, 0x00, 0x00, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0x86, 0x00, 0x00, 0x4A, 0xDC, 0x81, 0x04, 0xF8, 0xA8, 0xC8, 0x0A, 0x90,
+    0xB4, 0x00, 0x0B, 0x90, 0xB1, 0x00, 0x05, 0xF9, 0xC0, 0x00, 0x00, 0x5C, 0xFD, 0x80, 0x00, 0x00,
+    0xE8, 0xE8, 0x00, 0x00, 0xB0, 0x6F, 0x00, 0x00, 0xB0, 0x6D, 0x1E, 0x85, 0xB4, 0xE8, 0x05, 0xCF,
+    0xFE, 0x80, 0x00, 0x04, 0x80, 0x00, 0x00, 0x03, 0x60, 0x00, 0x06, 0xBB, 0x40, 0x00, 0x1A, 0x30,
+    0x3D, 0x23, 0xE1, 0x00, 0xA8, 0x00, 0x88, 0x00, 0xB4, 0x07, 0xC0, 0x00, 0x7A, 0x00, 0xC4, 0x3E,
+    0x20, 0x00, 0x1E, 0x78, 0xC1, 0xD6, 0x00, 0x00, 0x02, 0x87, 0x19, 0x90, 0x43, 0x00, 0x00, 0x00,
+    0x6C, 0x2C, 0xBD, 0x80, 0x00, 0x03, 0xD3, 0x6A, 0x01, 0xE2, 0x00, 0x1C, 0x60, 0x88, 0x00, 0xB4,
+    0x00, 0x99, 0x00, 0x6B, 0x01, 0xE1, 0x06, 0xC1, 0x00, 0x0A, 0xCD, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x18, 0xBB, 0x70, 0x00, 0x00, 0x08, 0xC4, 0x5E, 0x60, 0x00, 0x00, 0xE5, 0x00,
+    0x46, 0x00, 0x00, 0x0D, 0x80, 0x00, 0x00, 0x00, 0x00, 0x6E, 0x30, 0x00, 0x00, 0x00, 0x1B, 0xDE,
+    0x30, 0x06, 0x20, 0x0C, 0x90, 0x9E, 0x30, 0xF3, 0x04, 0xF1, 0x00, 0x9E, 0x8D, 0x00, 0x6F, 0x10,
+    0x00, 0x9F, 0x70, 0x01, 0xE9, 0x10, 0x4C, 0xDE, 0x30, 0x03, 0xDF, 0xFD, 0x60, 0x9E, 0x30, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x83, 0xB4, 0xB4, 0xB3, 0x00, 0x01, 0x50, 0x99, 0x1F, 0x27, 0xC0, 0xA8,
+    0x0D, 0x40, 0xF4, 0x0F, 0x40, 0xF4, 0x0B, 0x60, 0x99, 0x05, 0xE0, 0x0D, 0x60, 0x6A, 0x00, 0x10,
+    0x25, 0x00, 0x4E, 0x10, 0x0B, 0x70, 0x06, 0xD0, 0x01, 0xF2, 0x00, 0xE4, 0x00, 0xB6, 0x00, 0xB8,
+    0x00, 0xB4, 0x00, 0xF4, 0x03, 0xF0, 0x08, 0xA0, 0x1E, 0x40, 0x6B, 0x00, 0x01, 0x00, 0x00, 0x11,
+    0x00, 0x02, 0x44, 0x20, 0x19, 0xAB, 0x91, 0x06, 0xBB, 0x60, 0x16, 0x44, 0x61, 0x00, 0x22, 0x00,
+    0x00, 0x03, 0xB0, 0x00, 0x00, 0x04, 0xF0, 0x00, 0x00, 0x04, 0xF0, 0x00, 0x28, 0x89, 0xF8, 0x88,
+    0x28, 0x89, 0xF8, 0x88, 0x00, 0x04, 0xF0, 0x00, 0x00, 0x04, 0xF0, 0x00, 0x00, 0x03, 0xB0, 0x00,
+    0x2B, 0x33, 0xF8, 0x08, 0x41, 0x90, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFF, 0xF8, 0x00, 0x00, 0x00,
+    0x2B, 0x33, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x87, 0x00, 0x00, 0x1E, 0x10,
+    0x00, 0x06, 0x90, 0x00, 0x00, 0xC4, 0x00, 0x00, 0x3D, 0x00, 0x00, 0x09, 0x70, 0x00, 0x01, 0xE1,
+    0x00, 0x00, 0x69, 0x00, 0x00, 0x0C, 0x40, 0x00, 0x03, 0xD0, 0x00, 0x00, 0x97, 0x00, 0x00, 0x09,
+    0x10, 0x00, 0x00, 0x00, 0x5B, 0xBA, 0x30, 0x00, 0x6E, 0x84, 0xAE, 0x30, 0x1E, 0x70, 0x00, 0xBA,
+    0x05, 0xF1, 0x00, 0x06, 0xF0, 0x8D, 0x00, 0x00, 0x4F, 0x48, 0xB0, 0x00, 0x04, 0xF4, 0x8C, 0x00,
+    0x00, 0x4F, 0x46, 0xF0, 0x00, 0x05, 0xF1, 0x2F, 0x50, 0x00, 0x9C, 0x00, 0x8D, 0x40, 0x7F, 0x50,
+    0x00, 0x8F, 0xFE, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x1A, 0xFB, 0x00,
+    0x1C, 0xC8, 0xB0, 0x03, 0x81, 0x8B, 0x00, 0x00, 0x08, 0xB0, 0x00, 0x00, 0x8B, 0x00, 0x00, 0x08,
+    0xB0, 0x00, 0x00, 0x8B, 0x00, 0x00, 0x08, 0xB0, 0x00, 0x00, 0x8B, 0x00, 0x0B, 0xFF, 0xFF, 0xF0,
+    0x00, 0x5B, 0xBB, 0x50, 0x05, 0xF8, 0x48, 0xF4, 0x0D, 0x80, 0x00, 0xCA, 0x04, 0x10, 0x00, 0xBB,
+    0x00, 0x00, 0x01, 0xE7, 0x00, 0x00, 0x09, 0xC0, 0x00, 0x00, 0x9E, 0x10, 0x00, 0x09, 0xE3, 0x00,
+    0x00, 0x9E, 0x30, 0x00, 0x09, 0xF7, 0x44, 0x43, 0x3F, 0xFF, 0xFF, 0xFF, 0x00, 0x4A, 0xBB, 0x60,
+    0x00, 0x4F, 0x84, 0x8F, 0x60, 0x0A, 0x90, 0x00, 0x9B, 0x00, 0x32, 0x00, 0x08, 0xB0, 0x00, 0x00,
+    0x05, 0xE4, 0x00, 0x00, 0x0F, 0xF8, 0x00, 0x00, 0x00, 0x03, 0xC8, 0x00, 0x00, 0x00, 0x05, 0xF0,
+    0x1E, 0x40, 0x00, 0x6F, 0x00, 0xAC, 0x40, 0x4E, 0x80, 0x01, 0x9F, 0xFF, 0x80, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x07, 0xEB, 0x00, 0x00, 0x03, 0xEA, 0xB0, 0x00,
+    0x01, 0xD7, 0x8B, 0x00, 0x00, 0xAA, 0x08, 0xB0, 0x00, 0x7D, 0x10, 0x8B, 0x00, 0x3F, 0x30, 0x08,
+    0xB0, 0x09, 0xFF, 0xFF, 0xFF, 0xF8, 0x14, 0x44, 0x49, 0xC4, 0x10, 0x00, 0x00, 0x8B, 0x00, 0x00,
+    0x00, 0x08, 0xB0, 0x00, 0x00, 0x8B, 0xBB, 0xB3, 0x00, 0xF8, 0x88, 0x81, 0x02, 0xF0, 0x00, 0x00,
+    0x05, 0xC0, 0x00, 0x00, 0x08, 0xEB, 0xBA, 0x30, 0x03, 0x74, 0x4A, 0xE2, 0x00, 0x00, 0x00, 0xD8,
+    0x00, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x00, 0xD8, 0x0A, 0x60, 0x19, 0xE2, 0x08, 0xEF, 0xFB, 0x30,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3B, 0x60, 0x00, 0x00, 0x0C, 0xB0, 0x00, 0x00, 0x08, 0xE1,
+    0x00, 0x00, 0x05, 0xF3, 0x00, 0x00, 0x02, 0xE9, 0x88, 0x20, 0x00, 0x9F, 0x98, 0x9F, 0x50, 0x1F,
+    0x70, 0x00, 0x9D, 0x04, 0xF1, 0x00, 0x04, 0xF0, 0x1F, 0x40, 0x00, 0x6E, 0x00, 0xAC, 0x20, 0x4E,
+    0x80, 0x01, 0x9F, 0xFE, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3B, 0xBB, 0xBB, 0xBB, 0x31, 0x88,
+    0x88, 0x8A, 0xE0, 0x00, 0x00, 0x00, 0xD8, 0x00, 0x00, 0x00, 0x6E, 0x10, 0x00, 0x00, 0x0D, 0x80,
+    0x00, 0x00, 0x06, 0xE1, 0x00, 0x00, 0x00, 0xD8, 0x00, 0x00, 0x00, 0x6E, 0x10, 0x00, 0x00, 0x0D,
+    0x80, 0x00, 0x00, 0x06, 0xE1, 0x00, 0x00, 0x00, 0xD8, 0x00, 0x00, 0x00, 0x00, 0x6B, 0xBA, 0x30,
+    0x08, 0xE5, 0x48, 0xF2, 0x0D, 0x80, 0x00, 0xC8, 0x0D, 0x80, 0x00, 0xC8, 0x06, 0xE5, 0x17, 0xE2,
+    0x01, 0xAF, 0xFF, 0x80, 0x0C, 0xB1, 0x04, 0xE8, 0x4F, 0x30, 0x00, 0x8E, 0x4F, 0x20, 0x00, 0x8E,
+    0x0D, 0xA1, 0x04, 0xE8, 0x03, 0xBF, 0xFF, 0x81, 0x00, 0x00, 0x00, 0x00, 0x03, 0xAB, 0xB6, 0x00,
+    0x4F, 0x84, 0x6E, 0x80, 0xA9, 0x00, 0x06, 0xE0, 0xD8, 0x00, 0x04, 0xF0, 0xAA, 0x00, 0x08, 0xF0,
+    0x4F, 0xA8, 0x9F, 0x90, 0x02, 0x88, 0x8E, 0x20, 0x00, 0x02, 0xE7, 0x00, 0x00, 0x0C, 0xB0, 0x00,
+    0x00, 0x8E, 0x10, 0x00, 0x05, 0xF5, 0x00, 0x00, 0x04, 0x20, 0xFB, 0x05, 0x40, 0x00, 0x00, 0x00,
+    0x00, 0x08, 0x80, 0xEA, 0x00, 0x00, 0x04, 0x20, 0xFB, 0x05, 0x40, 0x00, 0x00, 0x00, 0x00, 0x08,
+    0x80, 0xCB, 0x04, 0x80, 0x81, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x02, 0x9E, 0x01, 0x8F, 0x92,
+    0x8E, 0x92, 0x00, 0x7E, 0xB4, 0x00, 0x01, 0x8E, 0x92, 0x00, 0x01, 0x8E, 0x00, 0x00, 0x01, 0xBB,
+    0xBB, 0xBB, 0x64, 0x44, 0x44, 0x42, 0x44, 0x44, 0x44, 0x2B, 0xBB, 0xBB, 0xB6, 0x11, 0x00, 0x00,
+    0x04, 0xE8, 0x00, 0x00, 0x04, 0xBD, 0x60, 0x00, 0x00, 0x4B, 0xD4, 0x00, 0x06, 0xDB, 0x30, 0x6D,
+    0xD5, 0x00, 0x4D, 0x60, 0x00, 0x01, 0x00, 0x00, 0x00, 0x19, 0xBB, 0x80, 0x89, 0x46, 0xE7, 0x00,
+    0x00, 0x8B, 0x00, 0x00, 0xB8, 0x00, 0x1A, 0xC1, 0x00, 0xA9, 0x10, 0x00, 0xB4, 0x00, 0x00, 0x31,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0xA5, 0x00, 0x03, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+    0x41, 0x00, 0x00, 0x00, 0x06, 0xDB, 0xBB, 0xD5, 0x00, 0x00, 0x9A, 0x20, 0x00, 0x2A, 0x80, 0x07,
+    0xA0, 0x00, 0x00, 0x00, 0xD3, 0x0E, 0x20, 0x19, 0xDC, 0xC0, 0x68, 0x4B, 0x00, 0xC7, 0x06, 0x90,
+    0x4B, 0x4B, 0x05, 0xC0, 0x0A, 0x60, 0x4B, 0x4B, 0x08, 0x80, 0x0E, 0x20, 0x87, 0x2D, 0x05, 0xD5,
+    0xAD, 0x77, 0xC1, 0x0B, 0x40, 0x68, 0x43, 0x87, 0x10, 0x03, 0xE3, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x5D, 0x84, 0x02, 0x49, 0xB0, 0x00, 0x01, 0x7A, 0xBB, 0x96, 0x00, 0x00, 0x00, 0x9B, 0x00, 0x00,
+    0x00, 0x00, 0x2F, 0xE6, 0x00, 0x00, 0x00, 0x08, 0xD9, 0xB0, 0x00, 0x00, 0x00, 0xE7, 0x4F, 0x20,
+    0x00, 0x00, 0x6F, 0x10, 0xD8, 0x00, 0x00, 0x0B, 0xA0, 0x07, 0xE0, 0x00, 0x02, 0xF5, 0x00, 0x2F,
+    0x60, 0x00, 0x8F, 0xFF, 0xFF, 0xFB, 0x00, 0x0E, 0x80, 0x00, 0x05, 0xF2, 0x06, 0xF2, 0x00, 0x00,
+    0x0D, 0x80, 0xBB, 0x00, 0x00, 0x00, 0x8E, 0x00, 0x8B, 0xBB, 0xB8, 0x20, 0xBD, 0x88, 0x8D, 0xE2,
+    0xBB, 0x00, 0x01, 0xF8, 0xBB, 0x00, 0x00, 0xF8, 0xBB, 0x00, 0x08, 0xE1, 0xBF, 0xFF, 0xFE, 0x40,
+    0xBB, 0x00, 0x26, 0xE6, 0xBB, 0x00, 0x00, 0x8C, 0xBB, 0x00, 0x00, 0x9B, 0xBC, 0x44, 0x48, 0xF8,
+    0xBF, 0xFF, 0xFC, 0x60, 0x00, 0x04, 0xAB, 0xBA, 0x50, 0x00, 0x9F, 0xA8, 0x89, 0xF7, 0x08, 0xF6,
+    0x00, 0x00, 0x21, 0x0E, 0x90, 0x00, 0x00, 0x00, 0x4F, 0x40, 0x00, 0x00, 0x00, 0x4F, 0x40, 0x00,
+    0x00, 0x00, 0x4F, 0x40, 0x00, 0x00, 0x00, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x09, 0xE1, 0x00, 0x00,
+    0x10, 0x01, 0xEE, 0x64, 0x46, 0xE6, 0x00, 0x19, 0xFF, 0xFD, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x8B, 0xBB, 0xB9, 0x60, 0x00, 0xBD, 0x88, 0x88, 0xEC, 0x10, 0xBB, 0x00, 0x00, 0x1D, 0xB0, 0xBB,
+    0x00, 0x00, 0x05, 0xF4, 0xBB, 0x00, 0x00, 0x00, 0xF8, 0xBB, 0x00, 0x00, 0x00, 0xE8, 0xBB, 0x00,
+    0x00, 0x00, 0xF8, 0xBB, 0x00, 0x00, 0x03, 0xF6, 0xBB, 0x00, 0x00, 0x0B, 0xD0, 0xBC, 0x44, 0x45,
+    0xBE, 0x30, 0xBF, 0xFF, 0xFD, 0x92, 0x00, 0x8B, 0xBB, 0xBB, 0xBB, 0xD8, 0x88, 0x88, 0xBB, 0x00,
+    0x00, 0x0B, 0xB0, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x0B, 0xFF, 0xFF, 0xF0, 0xBC, 0x44, 0x44, 0x0B,
+    0xB0, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x0B, 0xC4, 0x44, 0x44, 0xBF, 0xFF, 0xFF, 0xF0, 0x8B, 0xBB,
+    0xBB, 0xBB, 0xD8, 0x88, 0x88, 0xBB, 0x00, 0x00, 0x0B, 0xB0, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x0B,
+    0xEB, 0xBB, 0xB3, 0xBD, 0x88, 0x88, 0x2B, 0xB0, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x0B, 0xB0, 0x00,
+    0x00, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x04, 0xAB, 0xBB, 0x71, 0x00, 0x09, 0xFA, 0x88, 0x8E, 0xB0,
+    0x08, 0xF6, 0x00, 0x00, 0x12, 0x00, 0xE9, 0x00, 0x00, 0x00, 0x00, 0x4F, 0x40, 0x00, 0x00, 0x00,
+    0x04, 0xF4, 0x00, 0x01, 0x44, 0x40, 0x4F, 0x40, 0x00, 0x3F, 0xFF, 0x01, 0xF8, 0x00, 0x00, 0x04,
+    0xF0, 0x09, 0xE1, 0x00, 0x00, 0x4F, 0x00, 0x1C, 0xD6, 0x10, 0x49, 0xF0, 0x00, 0x18, 0xEF, 0xFF,
+    0xC5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x00, 0x00, 0x06, 0xB0, 0xBB, 0x00, 0x00, 0x08,
+    0xF0, 0xBB, 0x00, 0x00, 0x08, 0xF0, 0xBB, 0x00, 0x00, 0x08, 0xF0, 0xBB, 0x00, 0x00, 0x08, 0xF0,
+    0xBF, 0xFF, 0xFF, 0xFF, 0xF0, 0xBB, 0x00, 0x00, 0x08, 0xF0, 0xBB, 0x00, 0x00, 0x08, 0xF0, 0xBB,
+    0x00, 0x00, 0x08, 0xF0, 0xBB, 0x00, 0x00, 0x08, 0xF0, 0xBB, 0x00, 0x00, 0x08, 0xF0, 0x6B, 0x08,
+    0xF0, 0x8F, 0x08, 0xF0, 0x8F, 0x08, 0xF0, 0x8F, 0x08, 0xF0, 0x8F, 0x08, 0xF0, 0x8F, 0x00, 0x00,
+    0x00, 0xB3, 0x00, 0x00, 0xF4, 0x00, 0x00, 0xF4, 0x00, 0x00, 0xF4, 0x00, 0x00, 0xF4, 0x00, 0x00,
+    0xF4, 0x00, 0x00, 0xF4, 0x00, 0x01, 0xF4, 0x00, 0x05, 0xF4, 0x22, 0x3C, 0xD0, 0x8F, 0xFB, 0x30,
+    0x00, 0x00, 0x00, 0x6B, 0x00, 0x00, 0x3B, 0x60, 0x8F, 0x00, 0x01, 0xE9, 0x00, 0x8F, 0x00, 0x1C,
+    0xB0, 0x00, 0x8F, 0x00, 0xBC, 0x10, 0x00, 0x8F, 0x09, 0xE1, 0x00, 0x00, 0x8F, 0xFF, 0x70, 0x00,
+    0x00, 0x8F, 0x09, 0xF4, 0x00, 0x00, 0x8F, 0x00, 0x9E, 0x30, 0x00, 0x8F, 0x00, 0x0C, 0xC1, 0x00,
+    0x8F, 0x00, 0x01, 0xCC, 0x00, 0x8F, 0x00, 0x00, 0x3E, 0x90, 0x88, 0x00, 0x00, 0x0B, 0xB0, 0x00,
+    0x00, 0xBB, 0x00, 0x00, 0x0B, 0xB0, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x0B, 0xB0, 0x00, 0x00, 0xBB,
+    0x00, 0x00, 0x0B, 0xB0, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x0B, 0xC4, 0x44, 0x42, 0xBF, 0xFF, 0xFF,
+    0x80, 0x8A, 0x00, 0x00, 0x00, 0x02, 0xB6, 0xBF, 0x70, 0x00, 0x00, 0x09, 0xF8, 0xBD, 0xE1, 0x00,
+    0x00, 0x3F, 0xD8, 0xB8, 0xD8, 0x00, 0x00, 0xB9, 0xB8, 0xB8, 0x4F, 0x20, 0x04, 0xF2, 0xB8, 0xB8,
+    0x0B, 0xA0, 0x0D, 0x80, 0xB8, 0xB8, 0x02, 0xF4, 0x6E, 0x10, 0xB8, 0xB8, 0x00, 0x9B, 0xD8, 0x00,
+    0xB8, 0xB8, 0x00, 0x1E, 0xD0, 0x00, 0xB8, 0xB8, 0x00, 0x05, 0x30, 0x00, 0xB8, 0xB8, 0x00, 0x00,
+    0x00, 0x00, 0xB8, 0x88, 0x00, 0x00, 0x03, 0xB0, 0xBF, 0x50, 0x00, 0x04, 0xF0, 0xBE, 0xE3, 0x00,
+    0x04, 0xF0, 0xB8, 0xCC, 0x10, 0x04, 0xF0, 0xB8, 0x1E, 0x90, 0x04, 0xF0, 0xB8, 0x04, 0xF6, 0x04,
+    0xF0, 0xB8, 0x00, 0x8F, 0x34, 0xF0, 0xB8, 0x00, 0x0A, 0xD5, 0xF0, 0xB8, 0x00, 0x01, 0xDD, 0xF0,
+    0xB8, 0x00, 0x00, 0x3F, 0xF0, 0xB8, 0x00, 0x00, 0x06, 0xF0, 0x00, 0x04, 0xAB, 0xBA, 0x40, 0x00,
+    0x00, 0x9F, 0x98, 0x89, 0xF9, 0x00, 0x08, 0xF4, 0x00, 0x00, 0x6F, 0x80, 0x0E, 0x90, 0x00, 0x00,
+    0x09, 0xE0, 0x4F, 0x40, 0x00, 0x00, 0x05, 0xF3, 0x4F, 0x40, 0x00, 0x00, 0x04, 0xF4, 0x4F, 0x40,
+    0x00, 0x00, 0x04, 0xF4, 0x1F, 0x80, 0x00, 0x00, 0x08, 0xF0, 0x09, 0xE1, 0x00, 0x00, 0x3E, 0x90,
+    0x01, 0xCE, 0x64, 0x46, 0xEC, 0x10, 0x00, 0x18, 0xEF, 0xFE, 0x81, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x6B, 0xBB, 0xB7, 0x10, 0x8F, 0x88, 0x8D, 0xC1, 0x8F, 0x00, 0x02, 0xF7, 0x8F, 0x00,
+    0x00, 0xB9, 0x8F, 0x00, 0x01, 0xF8, 0x8F, 0x44, 0x5C, 0xE2, 0x8F, 0xFF, 0xE9, 0x20, 0x8F, 0x00,
+    0x00, 0x00, 0x8F, 0x00, 0x00, 0x00, 0x8F, 0x00, 0x00, 0x00, 0x8F, 0x00, 0x00, 0x00, 0x00, 0x04,
+    0xAB, 0xBA, 0x40, 0x00, 0x00, 0x9F, 0x98, 0x89, 0xF9, 0x00, 0x08, 0xF4, 0x00, 0x00, 0x6F, 0x80,
+    0x0E, 0x90, 0x00, 0x00, 0x09, 0xE0, 0x4F, 0x40, 0x00, 0x00, 0x05, 0xF3, 0x4F, 0x40, 0x00, 0x00,
+    0x04, 0xF4, 0x4F, 0x40, 0x00, 0x00, 0x04, 0xF4, 0x1F, 0x80, 0x00, 0x00, 0x08, 0xF0, 0x09, 0xE1,
+    0x00, 0x00, 0x3E, 0x90, 0x01, 0xCE, 0x64, 0x46, 0xEC, 0x10, 0x00, 0x18, 0xEF, 0xFE, 0xF6, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x9E, 0x30, 0x00, 0x00, 0x00, 0x00, 0x09, 0xE3, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x43, 0x6B, 0xBB, 0xB7, 0x10, 0x08, 0xF8, 0x88, 0xEC, 0x10, 0x8F, 0x00, 0x03, 0xF6, 0x08,
+    0xF0, 0x00, 0x0F, 0x70, 0x8F, 0x00, 0x06, 0xF2, 0x08, 0xF8, 0x8A, 0xE6, 0x00, 0x8F, 0x8A, 0xF3,
+    0x00, 0x08, 0xF0, 0x0C, 0xC0, 0x00, 0x8F, 0x00, 0x2E, 0x80, 0x08, 0xF0, 0x00, 0x5F, 0x50, 0x8F,
+    0x00, 0x00, 0x9E, 0x10, 0x00, 0x8B, 0xBA, 0x40, 0x08, 0xE7, 0x59, 0xE0, 0x0F, 0x50, 0x00, 0x20,
+    0x0F, 0x60, 0x00, 0x00, 0x0B, 0xE8, 0x20, 0x00, 0x01, 0x9E, 0xFC, 0x40, 0x00, 0x00, 0x5C, 0xE2,
+    0x00, 0x00, 0x01, 0xF7, 0x01, 0x00, 0x01, 0xF5, 0x6E, 0x61, 0x3A, 0xE1, 0x08, 0xEF, 0xFB, 0x30,
+    0x00, 0x00, 0x00, 0x00, 0x8B, 0xBB, 0xBB, 0xBB, 0x66, 0x88, 0x9F, 0x98, 0x84, 0x00, 0x04, 0xF4,
+    0x00, 0x00, 0x00, 0x4F, 0x40, 0x00, 0x00, 0x04, 0xF4, 0x00, 0x00, 0x00, 0x4F, 0x40, 0x00, 0x00,
+    0x04, 0xF4, 0x00, 0x00, 0x00, 0x4F, 0x40, 0x00, 0x00, 0x04, 0xF4, 0x00, 0x00, 0x00, 0x4F, 0x40,
+    0x00, 0x00, 0x04, 0xF4, 0x00, 0x00, 0x88, 0x00, 0x00, 0x08, 0x8B, 0xB0, 0x00, 0x00, 0xBB, 0xBB,
+    0x00, 0x00, 0x0B, 0xBB, 0xB0, 0x00, 0x00, 0xBB, 0xBB, 0x00, 0x00, 0x0B, 0xBB, 0xB0, 0x00, 0x00,
+    0xBB, 0xBB, 0x00, 0x00, 0x0B, 0xBB, 0xB0, 0x00, 0x00, 0xBB, 0x8F, 0x20, 0x00, 0x2F, 0x71, 0xEC,
+    0x54, 0x5D, 0xC1, 0x02, 0xAF, 0xFF, 0xA1, 0x00, 0x00, 0x01, 0x00, 0x00, 0x98, 0x00, 0x00, 0x00,
+    0x6B, 0x07, 0xF2, 0x00, 0x00, 0x0D, 0x90, 0x1E, 0x80, 0x00, 0x05, 0xF3, 0x00, 0x9D, 0x00, 0x00,
+    0xAC, 0x00, 0x03, 0xF5, 0x00, 0x2F, 0x60, 0x00, 0x0C, 0xA0, 0x08, 0xE1, 0x00, 0x00, 0x6F, 0x20,
+    0xD9, 0x00, 0x00, 0x01, 0xE8, 0x5F, 0x30, 0x00, 0x00, 0x09, 0xDA, 0xB0, 0x00, 0x00, 0x00, 0x2F,
+    0xE6, 0x00, 0x00, 0x00, 0x00, 0xBE, 0x00, 0x00, 0x00, 0x89, 0x00, 0x00, 0x0A, 0x50, 0x00, 0x05,
+    0xB1, 0x8F, 0x10, 0x00, 0x5F, 0xA0, 0x00, 0x0A, 0xC0, 0x3F, 0x60, 0x00, 0x9C, 0xF1, 0x00, 0x1F,
+    0x70, 0x0D, 0xA0, 0x01, 0xE5, 0xE6, 0x00, 0x5F, 0x20, 0x08, 0xE0, 0x06, 0xE0, 0x9A, 0x00, 0x9D,
+    0x00, 0x05, 0xF5, 0x0A, 0x90, 0x5F, 0x10, 0xD8, 0x00, 0x00, 0xE8, 0x1F, 0x50, 0x0E, 0x63, 0xF3,
+    0x00, 0x00, 0x9D, 0x6E, 0x00, 0x09, 0xA8, 0xD0, 0x00, 0x00, 0x5F, 0xC9, 0x00, 0x05, 0xFC, 0x90,
+    0x00, 0x00, 0x1F, 0xF5, 0x00, 0x00, 0xEF, 0x50, 0x00, 0x00, 0x0A, 0xE0, 0x00, 0x00, 0x9E, 0x00,
+    0x00, 0x6B, 0x20, 0x00, 0x05, 0xB2, 0x1D, 0xB0, 0x00, 0x1E, 0x80, 0x04, 0xF7, 0x00, 0xAC, 0x00,
+    0x00, 0x8E, 0x25, 0xF3, 0x00, 0x00, 0x0C, 0xAE, 0x80, 0x00, 0x00, 0x06, 0xFE, 0x10, 0x00, 0x00,
+    0x1D, 0xAE, 0x80, 0x00, 0x00, 0x8E, 0x17, 0xF4, 0x00, 0x04, 0xF5, 0x00, 0xBD, 0x00, 0x1D, 0xA0,
+    0x00, 0x2E, 0x80, 0x8E, 0x10, 0x00, 0x08, 0xF3, 0x89, 0x00, 0x00, 0x05, 0xB2, 0x3F, 0x60, 0x00,
+    0x1D, 0x90, 0x08, 0xE1, 0x00, 0x8E, 0x10, 0x01, 0xE8, 0x02, 0xF7, 0x00, 0x00, 0x6F, 0x2A, 0xC0,
+    0x00, 0x00, 0x0B, 0xCF, 0x30, 0x00, 0x00, 0x02, 0xF9, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00,
+    0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x0B,
+    0xBB, 0xBB, 0xBB, 0x80, 0x88, 0x88, 0x8A, 0xF8, 0x00, 0x00, 0x01, 0xCB, 0x00, 0x00, 0x00, 0x8E,
+    0x20, 0x00, 0x00, 0x5F, 0x50, 0x00, 0x00, 0x1E, 0x90, 0x00, 0x00, 0x0B, 0xD1, 0x00, 0x00, 0x07,
+    0xF3, 0x00, 0x00, 0x03, 0xF8, 0x00, 0x00, 0x00, 0xCD, 0x44, 0x44, 0x43, 0x4F, 0xFF, 0xFF, 0xFF,
+    0xB0, 0x88, 0x6F, 0x95, 0xF4, 0x0F, 0x40, 0xF4, 0x0F, 0x40, 0xF4, 0x0F, 0x40, 0xF4, 0x0F, 0x40,
+    0xF4, 0x0F, 0x40, 0xF4, 0x0F, 0xC8, 0x44, 0x30, 0x00, 0x00, 0x00, 0x00, 0xE2, 0x00, 0x00, 0x08,
+    0x80, 0x00, 0x00, 0x2E, 0x00, 0x00, 0x00, 0xB6, 0x00, 0x00, 0x06, 0xB0, 0x00, 0x00, 0x0E, 0x20,
+    0x00, 0x00, 0x88, 0x00, 0x00, 0x02, 0xE0, 0x00, 0x00, 0x0B, 0x60, 0x00, 0x00, 0x6B, 0x00, 0x00,
+    0x00, 0xE2, 0x00, 0x00, 0x06, 0x60, 0x28, 0x84, 0x18, 0xD8, 0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8,
+    0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8,
+    0x3B, 0xE8, 0x14, 0x42, 0x00, 0x4A, 0x00, 0x00, 0x0C, 0xE7, 0x00, 0x06, 0xD4, 0xE1, 0x01, 0xD5,
+    0x09, 0x80, 0x8B, 0x00, 0x2F, 0x20, 0x00, 0x00, 0x00, 0xBB, 0xBB, 0xBB, 0x44, 0x44, 0x44, 0x3B,
+    0x30, 0x07, 0xB0, 0x00, 0x41, 0x01, 0x7B, 0xA5, 0x00, 0xAB, 0x68, 0xF4, 0x01, 0x00, 0x0B, 0x90,
+    0x00, 0x14, 0xCB, 0x05, 0xDC, 0x9D, 0xB3, 0xF3, 0x00, 0xBB, 0x4F, 0x10, 0x3D, 0xB0, 0xBE, 0xCB,
+    0x8B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x80, 0x00, 0x00, 0xB8, 0x00, 0x00, 0x0B,
+    0x80, 0x00, 0x00, 0xB8, 0x5A, 0xA4, 0x0B, 0xE9, 0x5A, 0xF4, 0xB8, 0x00, 0x0C, 0x9B, 0x80, 0x00,
+    0x8B, 0xB8, 0x00, 0x08, 0xBB, 0x80, 0x00, 0xAA, 0xBC, 0x10, 0x6F, 0x4B, 0x8D, 0xFE, 0x60, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x6A, 0xB7, 0x10, 0x8E, 0x75, 0xA6, 0x2F, 0x40, 0x00, 0x07, 0xF0, 0x00,
+    0x00, 0x8F, 0x00, 0x00, 0x04, 0xF2, 0x00, 0x00, 0x0D, 0xA1, 0x05, 0x60, 0x3B, 0xFF, 0xC3, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF4, 0x00, 0x00, 0x00, 0xF4, 0x00,
+    0x00, 0x00, 0xF4, 0x00, 0x7B, 0xA3, 0xF4, 0x09, 0xE6, 0x5B, 0xF4, 0x3F, 0x40, 0x01, 0xF4, 0x7F,
+    0x00, 0x00, 0xF4, 0x8F, 0x00, 0x00, 0xF4, 0x5F, 0x10, 0x00, 0xF4, 0x1E, 0x90, 0x19, 0xF4, 0x06,
+    0xEF, 0xD5, 0xE4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6A, 0xB6, 0x00, 0x09, 0xC5, 0x5C, 0x80, 0x3F,
+    0x20, 0x02, 0xF2, 0x7F, 0xBB, 0xBB, 0xF4, 0x8F, 0x44, 0x44, 0x41, 0x4F, 0x20, 0x00, 0x00, 0x0C,
+    0xA1, 0x03, 0x90, 0x01, 0xBF, 0xFE, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8D, 0xD0, 0x6E, 0x50,
+    0x08, 0xB0, 0x06, 0xBD, 0x88, 0x6B, 0xD8, 0x80, 0x8B, 0x00, 0x08, 0xB0, 0x00, 0x8B, 0x00, 0x08,
+    0xB0, 0x00, 0x8B, 0x00, 0x08, 0xB0, 0x00, 0x01, 0x8B, 0x95, 0x42, 0x0C, 0x94, 0x7F, 0x93, 0x4F,
+    0x00, 0x0B, 0x80, 0x2F, 0x30, 0x1D, 0x60, 0x07, 0xEB, 0xD8, 0x00, 0x0C, 0x54, 0x10, 0x00, 0x0E,
+    0xD9, 0x88, 0x20, 0x1A, 0x88, 0x8B, 0xE2, 0x88, 0x00, 0x00, 0xF4, 0x5E, 0x64, 0x5A, 0xB0, 0x04,
+    0x9B, 0xA6, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x80, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x0F, 0x80, 0x00,
+    0x00, 0xF8, 0x6B, 0xA3, 0x0F, 0xE9, 0x6A, 0xE1, 0xF8, 0x00, 0x0F, 0x6F, 0x80, 0x00, 0xF8, 0xF8,
+    0x00, 0x0F, 0x8F, 0x80, 0x00, 0xF8, 0xF8, 0x00, 0x0F, 0x8F, 0x80, 0x00, 0xF8, 0x0C, 0x90, 0xC9,
+    0x00, 0x00, 0x64, 0x0B, 0x80, 0xB8, 0x0B, 0x80, 0xB8, 0x0B, 0x80, 0xB8, 0x0B, 0x80, 0x00, 0xC9,
+    0x00, 0xC9, 0x00, 0x00, 0x00, 0x64, 0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8,
+    0x00, 0xB8, 0x00, 0xB8, 0x00, 0xB8, 0x15, 0xE7, 0x5B, 0x80, 0x00, 0x00, 0x00, 0x0B, 0x80, 0x00,
+    0x00, 0xB8, 0x00, 0x00, 0x0B, 0x80, 0x00, 0x00, 0xB8, 0x00, 0x38, 0x1B, 0x80, 0x3E, 0x60, 0xB8,
+    0x2E, 0x60, 0x0B, 0xBC, 0x80, 0x00, 0xB9, 0xBC, 0x10, 0x0B, 0x81, 0xC9, 0x00, 0xB8, 0x03, 0xE7,
+    0x0B, 0x80, 0x04, 0xF3, 0x00, 0xB8, 0xB8, 0xB8, 0xB8, 0xB8, 0xB8, 0xB8, 0xB8, 0xB8, 0xB8, 0xB8,
+    0x82, 0x8B, 0x80, 0x5B, 0xA3, 0x0F, 0xB8, 0x6E, 0x8A, 0x6A, 0xE1, 0xF8, 0x00, 0x8F, 0x10, 0x1F,
+    0x5F, 0x80, 0x08, 0xF0, 0x00, 0xF8, 0xF8, 0x00, 0x8F, 0x00, 0x0F, 0x8F, 0x80, 0x08, 0xF0, 0x00,
+    0xF8, 0xF8, 0x00, 0x8F, 0x00, 0x0F, 0x8F, 0x80, 0x08, 0xF0, 0x00, 0xF8, 0x82, 0x6B, 0xA3, 0x0F,
+    0xC9, 0x6A, 0xE1, 0xF8, 0x00, 0x0F, 0x6F, 0x80, 0x00, 0xF8, 0xF8, 0x00, 0x0F, 0x8F, 0x80, 0x00,
+    0xF8, 0xF8, 0x00, 0x0F, 0x8F, 0x80, 0x00, 0xF8, 0x00, 0x6A, 0xB7, 0x10, 0x08, 0xE7, 0x5B, 0xC1,
+    0x3F, 0x40, 0x01, 0xD7, 0x7F, 0x00, 0x00, 0x9B, 0x8F, 0x00, 0x00, 0x8B, 0x5F, 0x10, 0x00, 0xC9,
+    0x0D, 0x91, 0x06, 0xF4, 0x02, 0xBF, 0xFD, 0x50, 0x00, 0x00, 0x00, 0x00, 0x82, 0x6B, 0xA4, 0x0F,
+    0xC8, 0x5A, 0xF2, 0xF8, 0x00, 0x0D, 0x9F, 0x80, 0x00, 0x9B, 0xF8, 0x00, 0x08, 0xBF, 0x80, 0x00,
+    0xC9, 0xFA, 0x10, 0x6F, 0x4F, 0xBE, 0xFE, 0x60, 0xF8, 0x00, 0x00, 0x0F, 0x80, 0x00, 0x00, 0x84,
+    0x00, 0x00, 0x00, 0x00, 0x7B, 0xA3, 0x82, 0x09, 0xE6, 0x5B, 0xF4, 0x3F, 0x40, 0x01, 0xF4, 0x7F,
+    0x00, 0x00, 0xF4, 0x8F, 0x00, 0x00, 0xF4, 0x5F, 0x10, 0x00, 0xF4, 0x1E, 0x90, 0x19, 0xF4, 0x06,
+    0xEF, 0xD5, 0xF4, 0x00, 0x00, 0x00, 0xF4, 0x00, 0x00, 0x00, 0xF4, 0x00, 0x00, 0x00, 0x82, 0x82,
+    0x5B, 0x7F, 0x8C, 0x86, 0xFB, 0x00, 0x0F, 0x80, 0x00, 0xF8, 0x00, 0x0F, 0x80, 0x00, 0xF8, 0x00,
+    0x0F, 0x80, 0x00, 0x03, 0x9B, 0x82, 0x2E, 0x84, 0x87, 0x4F, 0x00, 0x00, 0x2E, 0xD7, 0x20, 0x02,
+    0x7C, 0xF6, 0x00, 0x00, 0x8B, 0x26, 0x00, 0x9A, 0x3D, 0xDD, 0xC3, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x03, 0xB0, 0x00, 0x04, 0xB0, 0x00, 0x3A, 0xD8, 0x80, 0x6B, 0xD8, 0x80, 0x08, 0xB0, 0x00,
+    0x08, 0xB0, 0x00, 0x08, 0xB0, 0x00, 0x08, 0xB0, 0x00, 0x08, 0xE1, 0x30, 0x02, 0xEF, 0xD1, 0x00,
+    0x00, 0x00, 0x08, 0x20, 0x00, 0x82, 0x0F, 0x40, 0x00, 0xF4, 0x0F, 0x40, 0x00, 0xF4, 0x0F, 0x40,
+    0x00, 0xF4, 0x0F, 0x40, 0x00, 0xF4, 0x0F, 0x40, 0x00, 0xF4, 0x0D, 0xA0, 0x19, 0xF4, 0x05, 0xEF,
+    0xE6, 0xE4, 0x00, 0x00, 0x00, 0x00, 0x65, 0x00, 0x00, 0x83, 0x6E, 0x00, 0x04, 0xF2, 0x1E, 0x60,
+    0x09, 0xA0, 0x09, 0xB0, 0x1F, 0x40, 0x03, 0xF2, 0x7D, 0x00, 0x00, 0xC8, 0xC7, 0x00, 0x00, 0x6D,
+    0xF1, 0x00, 0x00, 0x0E, 0x90, 0x00, 0x65, 0x00, 0x07, 0x40, 0x00, 0x82, 0x8C, 0x00, 0x2F, 0xA0,
+    0x04, 0xF1, 0x3F, 0x20, 0x7B, 0xF1, 0x08, 0xA0, 0x0D, 0x60, 0xC5, 0xC6, 0x0D, 0x60, 0x08, 0xA2,
+    0xE0, 0x7A, 0x2F, 0x10, 0x03, 0xF7, 0x90, 0x2F, 0x7A, 0x00, 0x00, 0xEF, 0x50, 0x0C, 0xF7, 0x00,
+    0x00, 0x9E, 0x00, 0x07, 0xF2, 0x00, 0x38, 0x10, 0x03, 0x80, 0x1D, 0x80, 0x1D, 0x70, 0x04, 0xF4,
+    0x8B, 0x00, 0x00, 0x8D, 0xE2, 0x00, 0x00, 0x7F, 0xE1, 0x00, 0x02, 0xE5, 0xBA, 0x00, 0x0B, 0xA0,
+    0x3F, 0x50, 0x7D, 0x10, 0x08, 0xE1, 0x66, 0x00, 0x00, 0x73, 0x6E, 0x10, 0x04, 0xF2, 0x1E, 0x70,
+    0x09, 0x90, 0x08, 0xD0, 0x1F, 0x40, 0x02, 0xF5, 0x8C, 0x00, 0x00, 0x9A, 0xD6, 0x00, 0x00, 0x4F,
+    0xE0, 0x00, 0x00, 0x0D, 0x80, 0x00, 0x00, 0x3F, 0x20, 0x00, 0x00, 0x99, 0x00, 0x00, 0x00, 0x82,
+    0x00, 0x00, 0x28, 0x88, 0x88, 0x42, 0x88, 0x8A, 0xF3, 0x00, 0x01, 0xD7, 0x00, 0x00, 0xAA, 0x00,
+    0x00, 0x7D, 0x10, 0x00, 0x3F, 0x30, 0x00, 0x1D, 0x70, 0x00, 0x08, 0xFF, 0xFF, 0xF4, 0x00, 0x66,
+    0x08, 0xB5, 0x0F, 0x40, 0x0F, 0x40, 0x0C, 0x50, 0x0B, 0x80, 0x1D, 0x50, 0x8C, 0x10, 0x0B, 0x70,
+    0x0B, 0x80, 0x0D, 0x40, 0x0F, 0x40, 0x0E, 0x50, 0x06, 0xE8, 0x00, 0x03, 0x26, 0x4B, 0x4B, 0x4B,
+    0x4B, 0x4B, 0x4B, 0x4B, 0x4B, 0x4B, 0x4B, 0x4B, 0x4B, 0x4B, 0x26, 0x28, 0x20, 0x01, 0x8E, 0x20,
+    0x00, 0xB8, 0x00, 0x0B, 0x80, 0x00, 0xC5, 0x00, 0x0F, 0x40, 0x00, 0xC7, 0x00, 0x06, 0xD3, 0x00,
+    0xE4, 0x00, 0x0F, 0x40, 0x00, 0xB6, 0x00, 0x0B, 0x80, 0x00, 0xC7, 0x03, 0xCC, 0x10, 0x12, 0x00,
+    0x00, 0x01, 0x55, 0x00, 0x48, 0x0B, 0xDC, 0xE9, 0xD8, 0x1F, 0x10, 0x38, 0x60,
+};
+
+static const aa_glyph_t sans15_glyphs[95] = {
+    // offset  w   h   x    y   adv
+    {     0,  0,  0,   0,   0,  3 },   //  
+    {     0,  3, 12,   1,   4,  5 },   // !
+    {    18,  4,  5,   1,   4,  6 },   // "
+    {    28,  9, 11,   0,   4,  9 },   // #
+    {    78,  8, 15,   0,   2,  9 },   // $
+    {   138, 12, 12,   0,   4, 12 },   // %
+    {   210, 11, 12,   0,   4, 11 },   // &
+    {   276,  2,  5,   1,   4,  3 },   // quote
+    {   281,  3, 15,   1,   3,  4 },   // (
+    {   304,  4, 15,   0,   3,  4 },   // )
+    {   334,  6,  6,   0,   3,  6 },   // *
+    {   352,  8,  8,   0,   6,  9 },   // +
+    {   384,  3,  5,   0,  13,  3 },   // ,
+    {   392,  5,  3,   0,   9,  5 },   // -
+    {   400,  3,  3,   0,  13,  3 },   // .
+    {   405,  7, 13,  -1,   3,  6 },   // /
+    {   451,  9, 12,   0,   4,  9 },   // 0
+    {   505,  7, 11,   1,   4,  9 },   // 1
+    {   544,  8, 11,   0,   4,  9 },   // 2
+    {   588,  9, 12,   0,   4,  9 },   // 3
+    {   642,  9, 11,   0,   4,  9 },   // 4
+    {   692,  8, 12,   0,   4,  9 },   // 5
+    {   740,  9, 12,   0,   4,  9 },   // 6
+    {   794,  9, 11,   0,   4,  9 },   // 7
+    {   844,  8, 12,   0,   4,  9 },   // 8
+    {   892,  8, 11,   1,   4,  9 },   // 9
+    {   936,  3,  9,   0,   7,  4 },   // :
+    {   950,  3, 11,   0,   7,  4 },   // ;
+    {   967,  6,  8,   1,   6,  9 },   // <
+    {   991,  7,  4,   1,   8,  9 },   // =
+    {  1005,  7,  8,   1,   6,  9 },   // >
+    {  1033,  6, 12,   0,   4,  6 },   // ?
+    {  1069, 12, 13,   0,   4, 12 },   // @
+    {  1147, 11, 11,   0,   4, 10 },   // A
+    {  1208,  8, 11,   1,   4, 10 },   // B
+    {  1252, 10, 12,   0,   4, 10 },   // C
+    {  1312, 10, 11,   1,   4, 11 },   // D
+    {  1367,  7, 11,   1,   4,  9 },   // E
+    {  1406,  7, 11,   1,   4,  8 },   // F
+    {  1445, 11, 12,   0,   4, 11 },   // G
+    {  1511, 10, 11,   1,   4, 11 },   // H
+    {  1566,  3, 11,   1,   4,  5 },   // I
+    {  1583,  6, 12,   0,   4,  7 },   // J
+    {  1619, 10, 11,   1,   4, 10 },   // K
+    {  1674,  7, 11,   1,   4,  8 },   // L
+    {  1713, 12, 11,   1,   4, 14 },   // M
+    {  1779, 10, 11,   1,   4, 11 },   // N
+    {  1834, 12, 12,   0,   4, 12 },   // O
+    {  1906,  8, 11,   1,   4,  9 },   // P
+    {  1950, 12, 14,   0,   4, 12 },   // Q
+    {  2034,  9, 11,   1,   4, 10 },   // R
+    {  2084,  8, 12,   0,   4,  8 },   // S
+    {  2132,  9, 11,   0,   4,  9 },   // T
+    {  2182,  9, 12,   1,   4, 11 },   // U
+    {  2236, 11, 11,   0,   4, 10 },   // V
+    {  2297, 16, 11,   0,   4, 15 },   // W
+    {  2385, 10, 11,   0,   4, 10 },   // X
+    {  2440, 10, 11,   0,   4,  9 },   // Y
+    {  2495,  9, 11,   0,   4,  9 },   // Z
+    {  2545,  3, 15,   1,   3,  4 },   // [
+    {  2568,  7, 13,  -1,   3,  6 },   // backslash
+    {  2614,  4, 15,   0,   3,  4 },   // ]
+    {  2644,  7,  6,   1,   4,  9 },   // ^
+    {  2665,  6,  2,   0,  16,  6 },   // _
+    {  2671,  4,  3,   0,   4,  5 },   // `
+    {  2677,  7,  9,   0,   7,  8 },   // a
+    {  2709,  7, 13,   1,   3,  8 },   // b
+    {  2755,  7,  9,   0,   7,  7 },   // c
+    {  2787,  8, 13,   0,   3,  8 },   // d
+    {  2839,  8,  9,   0,   7,  8 },   // e
+    {  2875,  5, 11,   0,   4,  5 },   // f
+    {  2903,  8, 11,   0,   7,  8 },   // g
+    {  2947,  7, 12,   1,   3,  8 },   // h
+    {  2989,  3, 11,   0,   4,  4 },   // i
+    {  3006,  4, 14,  -1,   4,  4 },   // j
+    {  3034,  7, 12,   1,   3,  8 },   // k
+    {  3076,  2, 12,   1,   3,  4 },   // l
+    {  3088, 11,  8,   1,   7, 12 },   // m
+    {  3132,  7,  8,   1,   7,  8 },   // n
+    {  3160,  8,  9,   0,   7,  8 },   // o
+    {  3196,  7, 11,   1,   7,  8 },   // p
+    {  3235,  8, 11,   0,   7,  8 },   // q
+    {  3279,  5,  8,   1,   7,  6 },   // r
+    {  3299,  6,  9,   0,   7,  7 },   // s
+    {  3326,  6, 12,   0,   4,  6 },   // t
+    {  3362,  8,  9,   0,   7,  8 },   // u
+    {  3398,  8,  8,   0,   7,  8 },   // v
+    {  3430, 12,  8,   0,   7, 11 },   // w
+    {  3478,  8,  8,   0,   7,  8 },   // x
+    {  3510,  8, 11,   0,   7,  8 },   // y
+    {  3554,  7,  8,   0,   7,  7 },   // z
+    {  3582,  4, 15,   0,   3,  4 },   // {
+    {  3612,  2, 15,   1,   3,  4 },   // |
+    {  3627,  5, 15,   0,   3,  4 },   // }
+    {  3665,  8,  3,   0,   9,  9 },   // ~
+};
+
+static const uint8_t sans15_advances[95] = {
+    3, 5, 6, 9, 9, 12, 11, 3, 4, 4, 6, 9, 3, 5, 3, 6,
+    9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 4, 4, 9, 9, 9, 6,
+    12, 10, 10, 10, 11, 9, 8, 11, 11, 5, 7, 10, 8, 14, 11, 12,
+    9, 12, 10, 8, 9, 11, 10, 15, 10, 9, 9, 4, 6, 4, 9, 6,
+    5, 8, 8, 7, 8, 8, 5, 8, 8, 4, 4, 8, 4, 12, 8, 8,
+    8, 8, 6, 7, 6, 8, 8, 11, 8, 8, 7, 4, 4, 4, 9,
+};
+
+const aa_font_t font_sans15 = {
+    .bitmaps = sans15_bitmaps,
+    .glyphs = sans15_glyphs,
+    .advances = sans15_advances,
+    .first_char = 32,
+    .last_char = 126,
+    .ascent = 15,
+    .line_height = 19,
+};
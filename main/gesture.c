@@ -0,0 +1,111 @@
+/*
+ * gesture.c - Tap, long-press, swipe and drag recognition on the touch stream
+ *
+ * See gesture.h.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "gesture.h"
+
+void gesture_init(gesture_recognizer_t *g)
+{
+    memset(g, 0, sizeof(*g));
+    g->slop_px = GESTURE_SLOP_PX;
+    g->long_press_ms = GESTURE_LONG_PRESS_MS;
+    g->swipe_min_px = GESTURE_SWIPE_MIN_PX;
+    g->swipe_min_speed = GESTURE_SWIPE_MIN_SPEED;
+    g->state = GESTURE_STATE_IDLE;
+}
+
+static void fill_event(const gesture_recognizer_t *g, gesture_type_t type, uint32_t now_ms,
+                       gesture_event_t *event)
+{
+    memset(event, 0, sizeof(*event));
+    event->type = type;
+    event->x = g->last_x;
+    event->y = g->last_y;
+    event->dx = (int16_t)(g->last_x - g->start_x);
+    event->dy = (int16_t)(g->last_y - g->start_y);
+    event->vx = g->vx;
+    event->vy = g->vy;
+    event->duration_ms = now_ms - g->start_ms;
+}
+
+bool gesture_touch(gesture_recognizer_t *g, int16_t x, int16_t y, uint32_t now_ms, gesture_event_t *event)
+{
+    if (g->state == GESTURE_STATE_IDLE) {
+        g->state = GESTURE_STATE_PRESSED;
+        g->start_x = g->last_x = g->drag_x = x;
+        g->start_y = g->last_y = g->drag_y = y;
+        g->start_ms = g->last_ms = now_ms;
+        g->vx = g->vy = 0;
+        return false;
+    }
+
+    // Velocity of this step, averaged with the previous estimate to ride out jitter
+    uint32_t dt = now_ms - g->last_ms;
+    if (dt > 0) {
+        g->vx = (g->vx + (int32_t)(x - g->last_x) * 1000 / (int32_t)dt) / 2;
+        g->vy = (g->vy + (int32_t)(y - g->last_y) * 1000 / (int32_t)dt) / 2;
+    }
+    g->last_x = x;
+    g->last_y = y;
+    g->last_ms = now_ms;
+
+    if (g->state == GESTURE_STATE_PRESSED) {
+        int32_t dx = x - g->start_x;
+        int32_t dy = y - g->start_y;
+        if (dx * dx + dy * dy <= (int32_t)g->slop_px * g->slop_px) {
+            return false;
+        }
+        // Left the slop circle: the drag starts from the press position
+        g->state = GESTURE_STATE_DRAGGING;
+    }
+
+    if (x == g->drag_x && y == g->drag_y) {
+        return false;
+    }
+    fill_event(g, GESTURE_DRAG, now_ms, event);
+    event->dx = (int16_t)(x - g->drag_x);
+    event->dy = (int16_t)(y - g->drag_y);
+    g->drag_x = x;
+    g->drag_y = y;
+    return true;
+}
+
+bool gesture_release(gesture_recognizer_t *g, uint32_t now_ms, gesture_event_t *event)
+{
+    gesture_state_t state = g->state;
+    g->state = GESTURE_STATE_IDLE;
+
+    if (state == GESTURE_STATE_IDLE) {
+        return false;
+    }
+
+    if (state == GESTURE_STATE_PRESSED) {
+        bool long_press = now_ms - g->start_ms >= g->long_press_ms;
+        fill_event(g, long_press ? GESTURE_LONG_PRESS : GESTURE_TAP, now_ms, event);
+        event->x = g->start_x;
+        event->y = g->start_y;
+        event->vx = event->vy = 0;
+        return true;
+    }
+
+    // Dragging: a swipe if the release is fast and far along its dominant axis
+    fill_event(g, GESTURE_DRAG_END, now_ms, event);
+    bool horizontal = abs(event->dx) >= abs(event->dy);
+    int32_t distance = horizontal ? event->dx : event->dy;
+    int32_t speed = horizontal ? event->vx : event->vy;
+
+    if (abs(distance) >= g->swipe_min_px && (uint32_t)abs(speed) >= g->swipe_min_speed &&
+        (distance > 0) == (speed > 0)) {
+        event->type = GESTURE_SWIPE;
+        if (horizontal) {
+            event->direction = (distance > 0) ? GESTURE_RIGHT : GESTURE_LEFT;
+        } else {
+            event->direction = (distance > 0) ? GESTURE_DOWN : GESTURE_UP;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,98 @@
+/*
+ * gesture.h - Tap, long-press, swipe and drag recognition on the touch stream
+ *
+ * The touch task feeds every pressed sample (screen coordinates) and the
+ * release to a small state machine:
+ *
+ *   IDLE --press--> PRESSED --moved beyond slop--> DRAGGING
+ *     ^                |                              |
+ *     +-- release: TAP / LONG_PRESS       release: SWIPE / DRAG_END
+ *
+ * While dragging, every sample that moves emits DRAG with the movement since
+ * the previous DRAG and a smoothed velocity. A release that is fast enough
+ * and far enough along one axis is a SWIPE in that direction; otherwise the
+ * drag simply ends. A press that never leaves the slop circle is a TAP or,
+ * held past long_press_ms, a LONG_PRESS; both carry the press duration so
+ * callers can apply their own longer thresholds.
+ *
+ * No allocation and no clock reads: timestamps come from the caller, so the
+ * unit tests replay recorded sample sequences and get the device's events.
+ */
+
+#ifndef GESTURE_H
+#define GESTURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define GESTURE_SLOP_PX             12      // Radius of movement still counted as a stationary press
+#define GESTURE_LONG_PRESS_MS       800
+#define GESTURE_SWIPE_MIN_PX        40      // Along the dominant axis, press to release
+#define GESTURE_SWIPE_MIN_SPEED     300     // px/s at release
+
+typedef enum {
+    GESTURE_NONE,
+    GESTURE_TAP,            // Stationary press released before long_press_ms
+    GESTURE_LONG_PRESS,     // Stationary press released after long_press_ms
+    GESTURE_DRAG,           // Finger moved while dragging
+    GESTURE_DRAG_END,       // Drag released slowly
+    GESTURE_SWIPE           // Drag released fast along one axis
+} gesture_type_t;
+
+typedef enum {
+    GESTURE_LEFT,
+    GESTURE_RIGHT,
+    GESTURE_UP,
+    GESTURE_DOWN
+} gesture_dir_t;
+
+typedef struct {
+    gesture_type_t type;
+    gesture_dir_t direction;    // SWIPE
+    int16_t x;                  // TAP/LONG_PRESS: press position; others: current position
+    int16_t y;
+    int16_t dx;                 // DRAG: since the previous DRAG; SWIPE/DRAG_END: whole gesture
+    int16_t dy;
+    int32_t vx;                 // DRAG/SWIPE/DRAG_END: smoothed velocity, px/s
+    int32_t vy;
+    uint32_t duration_ms;       // Press to this event
+} gesture_event_t;
+
+typedef enum {
+    GESTURE_STATE_IDLE,
+    GESTURE_STATE_PRESSED,
+    GESTURE_STATE_DRAGGING
+} gesture_state_t;
+
+typedef struct {
+    // Thresholds (gesture_init() sets the defaults above)
+    uint16_t slop_px;
+    uint32_t long_press_ms;
+    uint16_t swipe_min_px;
+    uint32_t swipe_min_speed;
+
+    gesture_state_t state;
+    int16_t start_x, start_y;
+    uint32_t start_ms;
+    int16_t last_x, last_y;     // Last sample
+    uint32_t last_ms;
+    int16_t drag_x, drag_y;     // Position of the last DRAG event
+    int32_t vx, vy;             // Smoothed velocity, px/s
+} gesture_recognizer_t;
+
+/**
+ * Reset to idle with the default thresholds
+ */
+void gesture_init(gesture_recognizer_t *g);
+
+/**
+ * Feed one pressed sample; returns true and fills event if it produced one
+ */
+bool gesture_touch(gesture_recognizer_t *g, int16_t x, int16_t y, uint32_t now_ms, gesture_event_t *event);
+
+/**
+ * Feed the release; returns true and fills event unless no press was seen
+ */
+bool gesture_release(gesture_recognizer_t *g, uint32_t now_ms, gesture_event_t *event);
+
+#endif // GESTURE_H
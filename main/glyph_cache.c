@@ -0,0 +1,192 @@
+/*
+ * glyph_cache.c - Pre-rendered RGB565 glyph cells for the 5x7 font
+ *
+ * See glyph_cache.h.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "glyph_cache.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#define GLYPH_ALLOC(bytes)  heap_caps_malloc((bytes), MALLOC_CAP_DMA)
+#define GLYPH_FREE(ptr)     heap_caps_free(ptr)
+#else
+#define GLYPH_ALLOC(bytes)  malloc(bytes)
+#define GLYPH_FREE(ptr)     free(ptr)
+#endif
+
+static uint32_t glyph_hash(uint8_t ch, uint16_t fg, uint16_t bg, uint8_t size)
+{
+    uint32_t h = ch;
+    h = h * 31 + size;
+    h = h * 31 + fg;
+    h = h * 31 + bg;
+    return (h ^ (h >> 9)) & (GLYPH_CACHE_BUCKETS - 1);
+}
+
+static void lru_unlink(glyph_cache_t *cache, uint16_t index)
+{
+    glyph_entry_t *e = &cache->entries[index];
+
+    if (e->lru_prev != GLYPH_CACHE_NONE) {
+        cache->entries[e->lru_prev].lru_next = e->lru_next;
+    } else {
+        cache->lru_head = e->lru_next;
+    }
+    if (e->lru_next != GLYPH_CACHE_NONE) {
+        cache->entries[e->lru_next].lru_prev = e->lru_prev;
+    } else {
+        cache->lru_tail = e->lru_prev;
+    }
+}
+
+static void lru_push_front(glyph_cache_t *cache, uint16_t index)
+{
+    glyph_entry_t *e = &cache->entries[index];
+
+    e->lru_prev = GLYPH_CACHE_NONE;
+    e->lru_next = cache->lru_head;
+    if (cache->lru_head != GLYPH_CACHE_NONE) {
+        cache->entries[cache->lru_head].lru_prev = index;
+    } else {
+        cache->lru_tail = index;
+    }
+    cache->lru_head = index;
+}
+
+/**
+ * Drop the least recently used entry
+ */
+static void evict_lru(glyph_cache_t *cache)
+{
+    uint16_t index = cache->lru_tail;
+    glyph_entry_t *e = &cache->entries[index];
+
+    // Unlink from its hash bucket
+    uint16_t *link = &cache->buckets[glyph_hash(e->ch, e->fg, e->bg, e->size)];
+    while (*link != index) {
+        link = &cache->entries[*link].hash_next;
+    }
+    *link = e->hash_next;
+
+    lru_unlink(cache, index);
+
+    GLYPH_FREE(e->pixels);
+    e->pixels = NULL;
+    cache->stats.bytes_used -= e->bytes;
+    cache->stats.entries--;
+    cache->stats.evictions++;
+
+    e->hash_next = cache->free_head;
+    cache->free_head = index;
+}
+
+/**
+ * Expand one 5x7 glyph into a cell, byte-swapped so it can be sent as-is
+ */
+static void render_cell(const uint8_t *glyph, uint16_t *pixels, uint16_t fg, uint16_t bg, uint8_t size)
+{
+    uint16_t fg_be = (uint16_t)((fg << 8) | (fg >> 8));
+    uint16_t bg_be = (uint16_t)((bg << 8) | (bg >> 8));
+    int width = GLYPH_CELL_WIDTH(size);
+    int height = GLYPH_CELL_HEIGHT(size);
+
+    for (int y = 0; y < height; y++) {
+        uint8_t row_bit = (uint8_t)(1 << (y / size));
+        for (int x = 0; x < width; x++) {
+            int col = x / size;
+            bool on = (col < 5) && (glyph[col] & row_bit);
+            *pixels++ = on ? fg_be : bg_be;
+        }
+    }
+}
+
+void glyph_cache_init(glyph_cache_t *cache, const uint8_t (*font)[5], uint32_t budget_bytes)
+{
+    memset(cache, 0, sizeof(*cache));
+    cache->font = font;
+    cache->budget = budget_bytes;
+    cache->lru_head = GLYPH_CACHE_NONE;
+    cache->lru_tail = GLYPH_CACHE_NONE;
+
+    for (int i = 0; i < GLYPH_CACHE_BUCKETS; i++) {
+        cache->buckets[i] = GLYPH_CACHE_NONE;
+    }
+    for (int i = 0; i < GLYPH_CACHE_MAX_ENTRIES; i++) {
+        cache->entries[i].hash_next = (i + 1 < GLYPH_CACHE_MAX_ENTRIES) ? i + 1 : GLYPH_CACHE_NONE;
+    }
+    cache->free_head = 0;
+}
+
+const uint16_t *glyph_cache_get(glyph_cache_t *cache, char c, uint16_t fg, uint16_t bg, uint8_t size)
+{
+    uint8_t ch = (uint8_t)c;
+    if (ch < 32 || ch > 126) {
+        ch = ' ';
+    }
+
+    uint32_t bucket = glyph_hash(ch, fg, bg, size);
+    for (uint16_t i = cache->buckets[bucket]; i != GLYPH_CACHE_NONE; i = cache->entries[i].hash_next) {
+        glyph_entry_t *e = &cache->entries[i];
+        if (e->ch == ch && e->fg == fg && e->bg == bg && e->size == size) {
+            if (cache->lru_head != i) {
+                lru_unlink(cache, i);
+                lru_push_front(cache, i);
+            }
+            cache->stats.hits++;
+            return e->pixels;
+        }
+    }
+
+    cache->stats.misses++;
+
+    uint32_t bytes = (uint32_t)GLYPH_CELL_WIDTH(size) * GLYPH_CELL_HEIGHT(size) * 2;
+    if (size == 0 || bytes > cache->budget || bytes > UINT16_MAX) {
+        cache->stats.uncached++;
+        return NULL;
+    }
+
+    // Make room: free metadata slot and enough budget
+    while (cache->lru_tail != GLYPH_CACHE_NONE &&
+           (cache->free_head == GLYPH_CACHE_NONE || cache->stats.bytes_used + bytes > cache->budget)) {
+        evict_lru(cache);
+    }
+
+    uint16_t *pixels = GLYPH_ALLOC(bytes);
+    if (pixels == NULL) {
+        cache->stats.uncached++;
+        return NULL;
+    }
+    render_cell(cache->font[ch - 32], pixels, fg, bg, size);
+
+    uint16_t index = cache->free_head;
+    glyph_entry_t *e = &cache->entries[index];
+    cache->free_head = e->hash_next;
+
+    e->pixels = pixels;
+    e->fg = fg;
+    e->bg = bg;
+    e->ch = ch;
+    e->size = size;
+    e->bytes = (uint16_t)bytes;
+    e->hash_next = cache->buckets[bucket];
+    cache->buckets[bucket] = index;
+    lru_push_front(cache, index);
+
+    cache->stats.bytes_used += bytes;
+    cache->stats.entries++;
+    return pixels;
+}
+
+void glyph_cache_clear(glyph_cache_t *cache)
+{
+    uint32_t evictions = cache->stats.evictions;
+
+    while (cache->lru_tail != GLYPH_CACHE_NONE) {
+        evict_lru(cache);
+    }
+    cache->stats.evictions = evictions;  // Not a capacity eviction
+}
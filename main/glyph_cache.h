@@ -0,0 +1,75 @@
+/*
+ * glyph_cache.h - Pre-rendered RGB565 glyph cells for the 5x7 font
+ *
+ * Each cache entry holds one character expanded for a (fg, bg, size) tuple
+ * into a 6*size x 7*size cell (5 glyph columns plus the spacing column) in
+ * panel byte order, ready to be sent as a single SPI data transaction after
+ * the address window is set. Entries are kept in LRU order and evicted when
+ * the pixel buffers would exceed the byte budget.
+ *
+ * Pixel buffers are allocated from DMA-capable memory on ESP-IDF builds.
+ * The cache is not thread safe; callers serialize access and must not use a
+ * returned cell after the next glyph_cache_get() call may have evicted it.
+ */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <stdint.h>
+
+#define GLYPH_CACHE_MAX_ENTRIES 192     // Metadata slots (pixel memory is bounded by the budget)
+#define GLYPH_CACHE_BUCKETS     64      // Hash buckets (power of two)
+#define GLYPH_CACHE_NONE        0xFFFF  // Null entry index
+
+#define GLYPH_CELL_WIDTH(size)  (6 * (size))
+#define GLYPH_CELL_HEIGHT(size) (7 * (size))
+
+typedef struct {
+    uint16_t *pixels;       // NULL when the slot is free
+    uint16_t fg;
+    uint16_t bg;
+    uint8_t ch;
+    uint8_t size;
+    uint16_t bytes;
+    uint16_t lru_prev;      // Towards the most recently used entry
+    uint16_t lru_next;      // Towards the least recently used entry
+    uint16_t hash_next;     // Bucket chain, or free list link for free slots
+} glyph_entry_t;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t uncached;      // Cell larger than the budget or allocation failed
+    uint32_t bytes_used;
+    uint32_t entries;
+} glyph_cache_stats_t;
+
+typedef struct {
+    const uint8_t (*font)[5];           // 95 glyphs starting at ' ', column-major, bit 0 = top row
+    uint32_t budget;                    // Maximum pixel buffer bytes
+    glyph_entry_t entries[GLYPH_CACHE_MAX_ENTRIES];
+    uint16_t buckets[GLYPH_CACHE_BUCKETS];
+    uint16_t lru_head;                  // Most recently used
+    uint16_t lru_tail;                  // Least recently used (next victim)
+    uint16_t free_head;
+    glyph_cache_stats_t stats;
+} glyph_cache_t;
+
+/**
+ * Initialize an empty cache for a 5x7 font table
+ */
+void glyph_cache_init(glyph_cache_t *cache, const uint8_t (*font)[5], uint32_t budget_bytes);
+
+/**
+ * Return the cell for a printable character (32-126), rendering it on a miss.
+ * Returns NULL if the cell cannot be cached; the caller draws it directly.
+ */
+const uint16_t *glyph_cache_get(glyph_cache_t *cache, char c, uint16_t fg, uint16_t bg, uint8_t size);
+
+/**
+ * Free all cells (hit/miss/eviction counters are kept)
+ */
+void glyph_cache_clear(glyph_cache_t *cache);
+
+#endif // GLYPH_CACHE_H
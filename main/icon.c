@@ -0,0 +1,54 @@
+/*
+ * icon.c - Palette + run-length compressed RGB565 icons
+ *
+ * See icon.h.
+ */
+
+#include "icon.h"
+
+void icon_decode_begin(icon_decoder_t *dec, const icon_t *icon, uint16_t bg)
+{
+    dec->icon = icon;
+    for (int i = 0; i < ICON_MAX_COLORS; i++) {
+        uint16_t color = (i == icon->transparent || i >= icon->palette_size) ? bg : icon->palette[i];
+        dec->colors[i] = (uint16_t)((color << 8) | (color >> 8));
+    }
+    dec->next = 0;
+    dec->remaining = (uint32_t)icon->width * icon->height;
+    dec->run_color = 0;
+    dec->run_left = 0;
+}
+
+uint32_t icon_decode(icon_decoder_t *dec, uint16_t *out, uint32_t max_pixels)
+{
+    uint32_t count = (max_pixels < dec->remaining) ? max_pixels : dec->remaining;
+    uint32_t written = 0;
+
+    while (written < count) {
+        if (dec->run_left == 0) {
+            if (dec->next >= dec->icon->data_size) {
+                break;      // Truncated data: stop rather than read past the array
+            }
+            uint8_t run = dec->icon->data[dec->next++];
+            dec->run_color = dec->colors[run & 0x0F];
+            dec->run_left = (uint8_t)((run >> 4) + 1);
+        }
+
+        uint32_t n = count - written;
+        if (n > dec->run_left) {
+            n = dec->run_left;
+        }
+        uint16_t color = dec->run_color;
+        for (uint32_t i = 0; i < n; i++) {
+            out[written + i] = color;
+        }
+        written += n;
+        dec->run_left -= (uint8_t)n;
+    }
+
+    dec->remaining -= written;
+    if (written < count) {
+        dec->remaining = 0;
+    }
+    return written;
+}
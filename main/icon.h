@@ -0,0 +1,58 @@
+/*
+ * icon.h - Palette + run-length compressed RGB565 icons
+ *
+ * Icons are generated offline by tools/gen_icons.py from ASCII art into const
+ * arrays (flash). Pixels are indices into a palette of up to 16 RGB565 colors,
+ * stored row-major as runs: each byte holds (run length - 1) in the high
+ * nibble and the palette index in the low nibble, so one byte covers 1-16
+ * pixels. Runs may continue across rows.
+ *
+ * The decoder is incremental: it expands as many pixels as fit in the
+ * caller's buffer and resumes where it stopped, so an icon can be streamed
+ * into small DMA chunks without a full decompressed copy in RAM.
+ */
+
+#ifndef ICON_H
+#define ICON_H
+
+#include <stdint.h>
+
+#define ICON_MAX_COLORS     16
+#define ICON_OPAQUE         0xFF    // transparent value for icons without a transparent color
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    const uint16_t *palette;    // RGB565
+    uint8_t palette_size;
+    uint8_t transparent;        // Palette index replaced by the background, or ICON_OPAQUE
+    const uint8_t *data;        // Run bytes
+    uint32_t data_size;
+} icon_t;
+
+typedef struct {
+    const icon_t *icon;
+    uint16_t colors[ICON_MAX_COLORS];   // Palette in panel byte order, background applied
+    uint32_t next;                      // Next run byte
+    uint32_t remaining;                 // Pixels not yet produced
+    uint16_t run_color;
+    uint8_t run_left;                   // Pixels left in the current run
+} icon_decoder_t;
+
+// Generated icons (main/icons.c)
+extern const icon_t icon_keyboard;
+extern const icon_t icon_bt_on;
+extern const icon_t icon_bt_off;
+
+/**
+ * Start decoding an icon; bg (RGB565) is used for the transparent color
+ */
+void icon_decode_begin(icon_decoder_t *dec, const icon_t *icon, uint16_t bg);
+
+/**
+ * Produce up to max_pixels pixels (panel byte order) into out.
+ * Returns the number written; 0 once the icon is complete.
+ */
+uint32_t icon_decode(icon_decoder_t *dec, uint16_t *out, uint32_t max_pixels);
+
+#endif // ICON_H
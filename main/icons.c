@@ -0,0 +1,76 @@
+/*
+ * icons.c - Palette + run-length compressed icons
+ *
+ * GENERATED FILE - do not edit. Edit tools/icons.txt and regenerate with:
+ *   python3 tools/gen_icons.py tools/icons.txt main/icons.c
+ */
+
+#include "icon.h"
+
+// keyboard: 24x14, 3 colors, 91 bytes (672 as raw RGB565)
+static const uint16_t keyboard_palette[3] = {
+    0x0000, 0x0000, 0xFFFF,
+};
+
+static const uint8_t keyboard_data[91] = {
+    0x00, 0xF1, 0x51, 0x00, 0x01, 0xF2, 0x52, 0x11, 0x02, 0x21, 0x02, 0x21, 0x02, 0x21, 0x02, 0x21,
+    0x02, 0x31, 0x02, 0x11, 0x02, 0x21, 0x02, 0x21, 0x02, 0x21, 0x02, 0x21, 0x02, 0x31, 0x02, 0x11,
+    0xF2, 0x52, 0x11, 0x02, 0x41, 0x02, 0x21, 0x02, 0x21, 0x02, 0x21, 0x02, 0x11, 0x02, 0x11, 0x02,
+    0x41, 0x02, 0x21, 0x02, 0x21, 0x02, 0x21, 0x02, 0x11, 0x02, 0x11, 0xF2, 0x52, 0x11, 0xF2, 0x52,
+    0x11, 0x02, 0x11, 0x12, 0xB1, 0x12, 0x11, 0x02, 0x11, 0x02, 0x11, 0x12, 0xB1, 0x12, 0x11, 0x02,
+    0x11, 0xF2, 0x52, 0x11, 0xF2, 0x52, 0x01, 0x00, 0xF1, 0x51, 0x00,
+};
+
+const icon_t icon_keyboard = {
+    .width = 24,
+    .height = 14,
+    .palette = keyboard_palette,
+    .palette_size = 3,
+    .transparent = 0,
+    .data = keyboard_data,
+    .data_size = sizeof(keyboard_data),
+};
+
+// bt_on: 16x18, 3 colors, 63 bytes (576 as raw RGB565)
+static const uint16_t bt_on_palette[3] = {
+    0x0000, 0x041F, 0xFFFF,
+};
+
+static const uint8_t bt_on_data[63] = {
+    0x10, 0xB1, 0x20, 0xD1, 0x00, 0x61, 0x02, 0xE1, 0x12, 0xD1, 0x02, 0x01, 0x02, 0x91, 0x02, 0x11,
+    0x02, 0x11, 0x02, 0x91, 0x02, 0x01, 0x02, 0x21, 0x02, 0x91, 0x12, 0x11, 0x02, 0xB1, 0x22, 0xC1,
+    0x22, 0xB1, 0x12, 0x11, 0x02, 0x91, 0x02, 0x01, 0x02, 0x21, 0x02, 0x71, 0x02, 0x11, 0x02, 0x11,
+    0x02, 0xB1, 0x02, 0x01, 0x02, 0xC1, 0x12, 0xD1, 0x02, 0x71, 0x00, 0xD1, 0x20, 0xB1, 0x10,
+};
+
+const icon_t icon_bt_on = {
+    .width = 16,
+    .height = 18,
+    .palette = bt_on_palette,
+    .palette_size = 3,
+    .transparent = 0,
+    .data = bt_on_data,
+    .data_size = sizeof(bt_on_data),
+};
+
+// bt_off: 16x18, 3 colors, 63 bytes (576 as raw RGB565)
+static const uint16_t bt_off_palette[3] = {
+    0x0000, 0x4208, 0xA514,
+};
+
+static const uint8_t bt_off_data[63] = {
+    0x10, 0xB1, 0x20, 0xD1, 0x00, 0x61, 0x02, 0xE1, 0x12, 0xD1, 0x02, 0x01, 0x02, 0x91, 0x02, 0x11,
+    0x02, 0x11, 0x02, 0x91, 0x02, 0x01, 0x02, 0x21, 0x02, 0x91, 0x12, 0x11, 0x02, 0xB1, 0x22, 0xC1,
+    0x22, 0xB1, 0x12, 0x11, 0x02, 0x91, 0x02, 0x01, 0x02, 0x21, 0x02, 0x71, 0x02, 0x11, 0x02, 0x11,
+    0x02, 0xB1, 0x02, 0x01, 0x02, 0xC1, 0x12, 0xD1, 0x02, 0x71, 0x00, 0xD1, 0x20, 0xB1, 0x10,
+};
+
+const icon_t icon_bt_off = {
+    .width = 16,
+    .height = 18,
+    .palette = bt_off_palette,
+    .palette_size = 3,
+    .transparent = 0,
+    .data = bt_off_data,
+    .data_size = sizeof(bt_off_data),
+};
@@ -88,6 +88,9 @@
  * 1. FreeRTOS Tasks:
  *    - UI Task: Handles display rendering and touch input
  *    - BLE Task: Manages Bluetooth HID connection and sending
+ *    - Display init task: runs the ILI9341 reset/init sequence at boot while
+ *      NVS loading and BLE bring-up continue in app_main
+ *    - Log task: formats deferred (DLOGx) log records at low priority
  *    - Event handlers for system events
  * 
  * 2. Display Management:
@@ -110,6 +113,7 @@
  *    - NVS (Non-Volatile Storage) Flash API
  *    - Namespace: "macropad"
  *    - Keys: "macro0", "macro1", "macro2", "macro3"
+ *    - Writes are queued to a storage worker task so the UI never waits on flash
  * 
  * Operating Modes:
  * 
@@ -160,13 +164,38 @@
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "esp_system.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_console.h"
 #include "nvs_flash.h"
 #include "nvs.h"
+#include "esp_app_desc.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
+#include "driver/ledc.h"
+#ifdef CONFIG_PM_ENABLE
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#endif
 #include "version.h"
+#include "perf_stats.h"
+#include "touch_latency.h"
+#include "glyph_cache.h"
+#include "aa_font.h"
+#include "icon.h"
+#include "display_list.h"
+#include "touch_cal.h"
+#include "gesture.h"
+#include "touch_predict.h"
+#include "xpt2046.h"
+#include "power_stats.h"
+#include "cpu_load.h"
 
 // Logging tag
 static const char *TAG = "MACROPAD";
@@ -222,14 +251,19 @@ static const char *TAG = "MACROPAD";
 
 // ILI9341 Commands
 #define ILI9341_SWRESET     0x01
+#define ILI9341_SLPIN       0x10
 #define ILI9341_SLPOUT      0x11
+#define ILI9341_RDDPM       0x0A    // Read display power mode (1 parameter byte)
+#define ILI9341_NORON       0x13
 #define ILI9341_GAMMASET    0x26
 #define ILI9341_DISPOFF     0x28
 #define ILI9341_DISPON      0x29
 #define ILI9341_CASET       0x2A
 #define ILI9341_PASET       0x2B
 #define ILI9341_RAMWR       0x2C
+#define ILI9341_VSCRDEF     0x33
 #define ILI9341_MADCTL      0x36
+#define ILI9341_VSCRSADD    0x37
 #define ILI9341_PIXFMT      0x3A
 #define ILI9341_FRMCTR1     0xB1
 #define ILI9341_DFUNCTR     0xB6
@@ -239,6 +273,84 @@ static const char *TAG = "MACROPAD";
 #define ILI9341_VMCTR2      0xC7
 #define ILI9341_GMCTRP1     0xE0
 #define ILI9341_GMCTRN1     0xE1
+#define ILI9341_PWCTRA      0xCB
+#define ILI9341_PWCTRB      0xCF
+#define ILI9341_DTCTRA      0xE8
+#define ILI9341_DTCTRB      0xEA
+#define ILI9341_PWONSEQ     0xED
+#define ILI9341_PUMPCTR     0xF7
+#define ILI9341_GAMMA3EN    0xF2
+
+// Glyph cache (pre-rendered 5x7 font cells in DMA-capable RAM)
+#define GLYPH_CACHE_BUDGET  (16 * 1024)     // Pixel bytes: ~190 size-1 or ~48 size-2 cells
+
+// Anti-aliased text and icons are composed in a band buffer and sent in bursts
+#define PIXEL_BAND_PIXELS   2048            // 4 KB: 6 rows of a full-width line, 19 rows up to 107 px
+#define FILL_CHUNK_PIXELS   256             // Direct rectangle fills send 512-byte runs
+#define ICON_CHUNK_PIXELS   (PIXEL_BAND_PIXELS / 2)     // Icon ping-pong halves of the band
+#define TEXT_PADDING        4               // Minimum gap between a label and its button edge
+#define ICON_BENCH_RUNS     200             // Default iterations for the "icons" benchmark
+
+// Task stacks in bytes (the ESP-IDF stack depth unit). They are static, so the
+// total is fixed at link time; the "mem" console command prints each task's
+// high-water mark, which should stay above TASK_STACK_MARGIN.
+#define UI_TASK_STACK           4096
+#define TOUCH_TASK_STACK        4096
+#define STORAGE_TASK_STACK      4096    // NVS set_blob + commit; not cut without high-water data
+#define DLOG_TASK_STACK         3072    // snprintf + ESP_LOG of one record
+#define HID_TASK_STACK          3072    // Report conversion; the text buffer is static
+#define DISPLAY_INIT_STACK      4096    // One-shot boot job: on the heap so it is returned
+#define TASK_STACK_MARGIN       512
+#define TASK_RECORD_MAX         8
+
+// Core affinity (main/Kconfig.projbuild): the Bluetooth stack and HID transmit
+// on the radio core, touch, UI and rendering on the app core. Storage and
+// deferred logging are background work and may run on either.
+#ifdef CONFIG_KEYBOT_PIN_TASKS
+#define RADIO_CORE              CONFIG_KEYBOT_RADIO_CORE
+#define APP_CORE                (1 - CONFIG_KEYBOT_RADIO_CORE)
+#else
+#define RADIO_CORE              tskNO_AFFINITY
+#define APP_CORE                tskNO_AFFINITY
+#endif
+
+#if defined(CONFIG_KEYBOT_PIN_TASKS) && defined(CONFIG_BT_BLUEDROID_PINNED_TO_CORE) && \
+    CONFIG_BT_BLUEDROID_PINNED_TO_CORE != CONFIG_KEYBOT_RADIO_CORE
+#warning "KEYBOT_RADIO_CORE is not the Bluedroid core: HID reports will cross cores"
+#endif
+
+// Task priorities, by latency budget (see the Kconfig help for the first three)
+#define HID_TASK_PRIORITY       CONFIG_KEYBOT_HID_TASK_PRIORITY     // One report per BLE connection interval
+#define TOUCH_TASK_PRIORITY     CONFIG_KEYBOT_TOUCH_TASK_PRIORITY   // Touch-to-pixel
+#define UI_TASK_PRIORITY        CONFIG_KEYBOT_UI_TASK_PRIORITY      // Timeouts and storage results
+#define DISPLAY_INIT_PRIORITY   5       // Boot only
+#define STORAGE_TASK_PRIORITY   3       // Flash writes can wait behind any redraw
+#define DLOG_TASK_PRIORITY      1       // Log output only when nothing else runs
+#define CPU_LOAD_SAMPLE_MS      1000    // Default window of the "cpu" command
+
+// Full-screen redraws: display list rasterized into ping-pong DMA bands
+#define RENDER_BAND_ROWS    20      // 320 x 20 x 2 bytes = 12.5 KB per band, two bands
+
+// Macro preview: text pages side by side, scrolled by the panel's hardware scroll
+#define PREVIEW_VIEW_WIDTH  280     // Scrolling columns; the right 40 px hold the fixed buttons
+#define PREVIEW_CELL_W      12      // 5x7 font at size 2 plus spacing
+#define PREVIEW_CELL_H      16
+#define PREVIEW_COLS        22      // Characters per line
+#define PREVIEW_ROWS        14      // Lines per page (one page per view width)
+#define PREVIEW_MARGIN      8
+#define PREVIEW_SCROLL_STEP 8       // Pixels per scroll frame = columns written per frame
+#define PREVIEW_SCROLL_PAGE 140     // Pixels per arrow tap
+#define EDIT_LINE_CHARS     40      // Edit buffer tail shown on the keyboard screen (left of the title)
+
+// Init sequence table encoding (see lcd_run_init_sequence)
+#define LCD_INIT_DELAY      0x80    // Length byte flag: a delay byte (ms) follows the args
+#define LCD_INIT_LEN_MASK   0x1F    // Length byte: number of argument bytes
+#define LCD_INIT_END        0x00    // Command byte that terminates the table (NOP)
+#define LCD_INIT_QUEUE_SIZE 6       // In-flight transactions (device queue_size is 7)
+#define LCD_WRITE_CLOCK_HZ  (26 * 1000 * 1000)  // Panel writes
+#define LCD_READ_CLOCK_HZ   (4 * 1000 * 1000)   // Panel reads (serial read cycle is 150 ns min)
+#define LCD_DPM_SLEEP_OUT   0x10    // RDDPM bit: sleep out
+#define LCD_DPM_DISPLAY_ON  0x04    // RDDPM bit: display on
 
 // =============================================================================
 // APPLICATION CONFIGURATION
@@ -248,6 +360,29 @@ static const char *TAG = "MACROPAD";
 #define MAX_MACRO_LEN   512
 #define NVS_NAMESPACE   "macropad"
 
+// Boot trace configuration
+#define BOOT_TRACE_MAX_ENTRIES  32      // Stages + delays recorded during startup
+
+// Boot dependency bits (set once in boot_events, never cleared)
+#define BOOT_BIT_STORAGE    (1 << 0)    // Macros and calibration loaded from NVS
+#define BOOT_BIT_DISPLAY    (1 << 1)    // ILI9341 initialized and switched on
+#define BOOT_BIT_BLE        (1 << 2)    // Bluetooth stack started
+#define BOOT_BIT_UI         (1 << 3)    // First screen drawn, touch input may be handled
+
+// Startup display self-test
+#define SELFTEST_QUICK_HOLD_MS  250     // How long the one-frame quick check stays visible
+#define SELFTEST_FIRST_BOOT_CYCLES 1    // Full test cycles run unattended after a new flash
+
+// Storage worker configuration
+#define STORAGE_QUEUE_LEN       4       // Pending NVS write requests
+#define STORAGE_EVENT_QUEUE_LEN 8       // Completion events waiting for the UI
+#define HID_QUEUE_LEN           2       // Macros waiting to be typed
+
+// Deferred log configuration
+#define DLOG_RING_SIZE          64      // Records buffered for the drain task (power of two)
+#define DLOG_MAX_ARGS           4       // 32-bit arguments stored per record
+#define DLOG_LINE_LEN           160     // Formatted line buffer used by the drain task
+
 // Button layout configuration
 #define BUTTON_MARGIN   10
 
@@ -256,7 +391,33 @@ static const char *TAG = "MACROPAD";
 #define CONFIG_PRESS_MS         5000    // 5 seconds for config mode
 #define CALIBRATION_PRESS_MS    10000   // 10 seconds for calibration mode
 #define BT_CONFIG_PRESS_MS      20000   // 20 seconds for BT config (changed from 10s)
+#define DIAGNOSTICS_PRESS_MS    30000   // 30 seconds for the hidden diagnostics screen
 #define SELECTION_TIMEOUT_MS    5000    // 5 seconds timeout for macro selection
+#define SELECTION_FRAME         3       // Width of the white frame around the selected macro button
+
+// Touch calibration
+#define TOUCH_RAW_MAX           4095    // 12-bit XPT2046 readings
+#define TOUCH_PRESSURE_MIN      100     // Z1 below this is no touch
+#define TOUCH_BURST_SAMPLES     4       // Conversions per axis in each touch read (filtered)
+#define TOUCH_BENCH_RUNS        500     // Default iterations for the "touch" benchmark
+
+// Backlight PWM and idle power policy
+#define BACKLIGHT_LEDC_MODE     LEDC_LOW_SPEED_MODE
+#define BACKLIGHT_LEDC_TIMER    LEDC_TIMER_0
+#define BACKLIGHT_LEDC_CHANNEL  LEDC_CHANNEL_0
+#define BACKLIGHT_PWM_HZ        5000
+#define BACKLIGHT_FULL          255     // 8-bit duty
+#define BACKLIGHT_DIM           40
+#define BACKLIGHT_FADE_MS       400     // Fade to dim or off (waking is instant)
+#define IDLE_DIM_MS             30000   // No touch for 30 s: dim the backlight
+#define IDLE_SLEEP_MS           60000   // No touch for 60 s: backlight off, panel asleep
+#define PANEL_SLPOUT_MS         5       // ILI9341: wait after SLPOUT before the next command
+#define PANEL_SLEEP_MIN_MS      120     // ILI9341: SLPIN no sooner than this after SLPOUT
+
+// Automatic light sleep (CONFIG_PM_ENABLE with CONFIG_FREERTOS_USE_TICKLESS_IDLE)
+#define PM_MIN_FREQ_MHZ         80      // APB stays at 80 MHz so SPI and UART timings hold
+#define CALIBRATION_POINTS      5       // Targets touched (TOUCH_CAL_MIN_POINTS..TOUCH_CAL_MAX_POINTS)
+#define CALIBRATION_MAX_ERROR   8.0f    // Worst target miss (px) accepted from the fit
 
 // Keyboard configuration
 #define KEYBOARD_ROWS 3
@@ -266,6 +427,60 @@ static const char *TAG = "MACROPAD";
 #define KEY_MARGIN 2
 #define KEYBOARD_START_Y 80
 
+// =============================================================================
+// LOGGING
+// =============================================================================
+//
+// Two kinds of log calls are used in this file:
+//   ESP_LOGx          - immediate, formatted and written to the UART by the
+//                       calling task. Used for boot, errors and rare events.
+//   DLOGI / DLOGD     - deferred. The call site stores the format string
+//                       pointer and up to DLOG_MAX_ARGS 32-bit arguments in a
+//                       ring buffer; a low-priority task formats and prints
+//                       them later. Used on the touch/draw/keyboard hot paths.
+//
+// Each subsystem has a compile-time level. Deferred calls above that level
+// compile to nothing, so DEBUG-level lines cost zero unless enabled, e.g.
+// with idf_build_set_property(COMPILE_DEFINITIONS "LOG_LEVEL_TOUCH=4" APPEND).
+//
+// Deferred arguments are captured as uint32_t. Use %d/%u/%x/%c/%lu only and
+// log strings with ESP_LOGx; the dead printf() lets -Wformat check each call.
+
+#define KLOG_NONE       0
+#define KLOG_ERROR      1
+#define KLOG_WARN       2
+#define KLOG_INFO       3
+#define KLOG_DEBUG      4
+
+#ifndef LOG_LEVEL_TOUCH
+#define LOG_LEVEL_TOUCH     KLOG_INFO
+#endif
+#ifndef LOG_LEVEL_DISPLAY
+#define LOG_LEVEL_DISPLAY   KLOG_INFO
+#endif
+#ifndef LOG_LEVEL_UI
+#define LOG_LEVEL_UI        KLOG_INFO
+#endif
+
+#define DLOG(sub, level, fmt, ...) do {                                         \
+    if (0) printf(fmt, ##__VA_ARGS__);                                          \
+    if (LOG_LEVEL_##sub >= (level)) {                                           \
+        const uint32_t dlog_args_[DLOG_MAX_ARGS + 1] = {0, ##__VA_ARGS__};      \
+        dlog_write(#sub, fmt, &dlog_args_[1]);                                  \
+    }                                                                           \
+} while (0)
+
+#define DLOGI(sub, fmt, ...)    DLOG(sub, KLOG_INFO, fmt, ##__VA_ARGS__)
+#define DLOGD(sub, fmt, ...)    DLOG(sub, KLOG_DEBUG, fmt, ##__VA_ARGS__)
+
+// One deferred log record (format is not expanded until drained)
+typedef struct {
+    const char *fmt;                  // Format string literal (doubles as message id)
+    const char *subsystem;            // "TOUCH", "DISPLAY", "UI"
+    uint32_t timestamp_ms;            // esp_log_timestamp() at the call site
+    uint32_t args[DLOG_MAX_ARGS];
+} dlog_record_t;
+
 // =============================================================================
 // OPERATING MODES
 // =============================================================================
@@ -276,9 +491,13 @@ typedef enum {
     MODE_PLAYBACK,      // Main screen - playback mode
     MODE_CONFIG,        // Configuration mode - select macro to edit
     MODE_EDIT_KEYBOARD, // Editing mode - on-screen keyboard active
-    MODE_BT_CONFIG      // Bluetooth configuration mode
+    MODE_BT_CONFIG,     // Bluetooth configuration mode
+    MODE_DIAGNOSTICS,   // Hidden performance counter screen
+    MODE_PREVIEW        // Scrollable view of the whole edit buffer
 } app_mode_t;
 
+#define APP_MODE_COUNT  (MODE_PREVIEW + 1)
+
 // Keyboard page types
 typedef enum {
     KB_PAGE_ALPHA_LOWER,  // Lowercase letters
@@ -301,13 +520,118 @@ typedef struct {
 // CALIBRATION DATA STRUCTURE
 // =============================================================================
 
+// Stored as the "calibration" NVS blob
+typedef struct {
+    touch_cal_matrix_t matrix;  // Raw (x, y) -> screen (x, y), Q16
+    float rms_error;            // Fit residual over the touched targets (px)
+    float max_error;
+    uint8_t points;             // Targets used for the fit (0: converted from two-point data)
+    bool is_calibrated;         // True if calibration data is valid
+} calibration_data_t;
+
+// Blob layout of the original two-point calibration (per-axis ranges)
 typedef struct {
     uint16_t raw_x_min;    // Raw touch value at screen left edge
     uint16_t raw_x_max;    // Raw touch value at screen right edge
     uint16_t raw_y_min;    // Raw touch value at screen top edge
     uint16_t raw_y_max;    // Raw touch value at screen bottom edge
     bool is_calibrated;    // True if calibration data is valid
-} calibration_data_t;
+} calibration_v1_t;
+
+// =============================================================================
+// BOOT OPTIONS
+// =============================================================================
+
+// When the startup display self-test runs
+typedef enum {
+    SELFTEST_ALWAYS = 0,      // Full interactive test on every boot (runs until touched)
+    SELFTEST_FIRST_BOOT = 1,  // Full test once after a new firmware image, quick check otherwise
+    SELFTEST_NEVER = 2        // Skip the self-test entirely
+} selftest_mode_t;
+
+// Persisted boot options (NVS blob "boot_opts")
+typedef struct {
+    uint8_t selftest_mode;            // selftest_mode_t
+    uint8_t tested_fw_sha256[32];     // ELF SHA-256 of the image that last ran the full test
+} boot_options_t;
+
+// =============================================================================
+// STORAGE WORKER TYPES
+// =============================================================================
+
+// NVS write operations handled by the storage worker task
+typedef enum {
+    STORAGE_REQ_SAVE_MACRO,       // Write one macro string
+    STORAGE_REQ_SAVE_CALIBRATION, // Write the calibration blob
+    STORAGE_REQ_SAVE_BOOT_OPTIONS,// Write the boot options blob
+    STORAGE_REQ_ERASE_ALL         // Erase the whole namespace
+} storage_req_type_t;
+
+// Write request queued by the UI (copied, so the caller's buffers may change)
+typedef struct {
+    storage_req_type_t type;
+    uint32_t seq;                     // Submission order, echoed in the event
+    int index;                        // Macro index for STORAGE_REQ_SAVE_MACRO
+    char text[MAX_MACRO_LEN];         // Macro text for STORAGE_REQ_SAVE_MACRO
+    calibration_data_t calibration;   // Snapshot for STORAGE_REQ_SAVE_CALIBRATION
+    boot_options_t boot_options;      // Snapshot for STORAGE_REQ_SAVE_BOOT_OPTIONS
+} storage_request_t;
+
+// Completion event reported back to the UI task
+typedef struct {
+    storage_req_type_t type;
+    uint32_t seq;
+    int index;
+    esp_err_t err;
+} storage_event_t;
+
+// =============================================================================
+// BOOT TRACE TYPES
+// =============================================================================
+
+// One timed boot stage or fixed delay
+typedef struct {
+    const char *label;    // Static string, e.g. "init_nvs" or "display: SWRESET wait"
+    int64_t start_us;     // esp_timer_get_time() at stage start
+    int64_t end_us;       // esp_timer_get_time() at stage end (== start for marks)
+    bool is_delay;        // True for vTaskDelay() waits, false for work
+} boot_trace_entry_t;
+
+// =============================================================================
+// PERFORMANCE COUNTER TYPES
+// =============================================================================
+
+// Always-on hot-path counters. Updated without locks from whichever task does
+// the work, so an increment racing between the two cores can occasionally be
+// lost; that is acceptable for field statistics.
+typedef struct {
+    uint32_t spi_transactions;              // Display SPI transactions queued or polled
+    uint64_t spi_bytes;                     // Display SPI bytes (commands + data)
+    uint32_t touch_samples;                 // read_touch_coordinates() calls
+    uint32_t touch_rejected;                // Samples below the pressure threshold
+    uint32_t touch_conversions;             // XPT2046 conversions read by read_touch_coordinates()
+    perf_stat_t touch_read_us;              // One touch read (a single burst transfer)
+    uint32_t events_dispatched;             // Touch releases dispatched to a mode handler
+    uint32_t hid_reports;                   // HID keyboard reports handed to the transport (0 until one exists)
+    perf_stat_t nvs_commit_us;              // nvs_commit() duration (count = commits)
+    perf_stat_t render_us[APP_MODE_COUNT];  // Full screen draw time, by screen
+    perf_stat_t band_raster_us;             // CPU time rasterizing the bands of one screen
+    perf_stat_t band_flush_us;              // Wall time of the same flush (raster overlapped with SPI)
+    uint32_t screens_full;                  // Screen flushes that resent the whole panel
+    uint32_t screens_partial;               // Flushes limited to the damage against the last screen
+    uint32_t screens_unchanged;             // Flushes with nothing to send
+    uint64_t screen_pixels;                 // Pixels sent by screen flushes
+    uint32_t bus_locks;                     // Display bus acquisitions (outermost only)
+    uint32_t bus_contended;                 // Acquisitions that found another task on the bus
+    perf_stat_t bus_wait_us;                // Wait of the contended acquisitions
+} perf_counters_t;
+
+// Cycle-counter timestamp. The counters are per core, so a sample whose task
+// migrated to the other core before perf_timer_stop() is discarded.
+typedef struct {
+    uint32_t cycles;
+    int core;
+} perf_timer_t;
 
 // =============================================================================
 // GLOBAL STATE
@@ -340,9 +664,11 @@ typedef struct {
     
     // Calibration state
     calibration_data_t calibration;
-    int calibration_point;  // Current calibration point being collected (0-1)
-    uint16_t cal_raw_x[2];  // Raw X values for calibration points
-    uint16_t cal_raw_y[2];  // Raw Y values for calibration points
+    int calibration_point;  // Current calibration point being collected (0..CALIBRATION_POINTS-1)
+    touch_cal_point_t cal_points[CALIBRATION_POINTS];
+    
+    // Boot options
+    boot_options_t boot_options;
 } app_state_t;
 
 static app_state_t app_state = {
@@ -360,20 +686,194 @@ static app_state_t app_state = {
     .keyboard_page = KB_PAGE_ALPHA_LOWER,
     .edit_buffer_len = 0,
     .calibration = {
-        .raw_x_min = 0,
-        .raw_x_max = 4095,
-        .raw_y_min = 0,
-        .raw_y_max = 4095,
         .is_calibrated = false
     },
-    .calibration_point = 0
+    .calibration_point = 0,
+    .boot_options = {
+        .selftest_mode = SELFTEST_FIRST_BOOT
+    }
 };
 
 // SPI device handle for display
 static spi_device_handle_t display_spi;
 
-// SPI device handle for touch controller
+// Display bus arbiter. The ILI9341 keeps one address window, so a CASET/PASET/
+// RAMWR sequence and its pixel data (or a command and its arguments) must not
+// interleave with another task's. Every such sequence holds this mutex: it is
+// recursive so helpers can nest, and FreeRTOS priority inheritance lifts a
+// low-priority holder above anything that would preempt it while the touch
+// task waits.
+static SemaphoreHandle_t display_bus_mutex;
+static StaticSemaphore_t display_bus_mutex_buf;
+static int display_bus_depth = 0;              // Nesting of the holder's locks
+
+// SPI device handle for touch controller. The SPI master driver does not
+// support one device from two tasks at once, so every transfer holds
+// touch_bus_mutex; it is recursive so the "touch" benchmark can hold it for
+// its whole run and keep the touch task out meanwhile.
 static spi_device_handle_t touch_spi;
+static SemaphoreHandle_t touch_bus_mutex;
+static StaticSemaphore_t touch_bus_mutex_buf;
+
+// Storage worker queues (requests in, completion events out)
+static QueueHandle_t storage_request_queue;
+static QueueHandle_t storage_event_queue;
+static uint8_t storage_request_storage[STORAGE_QUEUE_LEN * sizeof(storage_request_t)];
+static uint8_t storage_event_storage[STORAGE_EVENT_QUEUE_LEN * sizeof(storage_event_t)];
+static StaticQueue_t storage_request_queue_buf;
+static StaticQueue_t storage_event_queue_buf;
+static uint32_t storage_next_seq = 0;
+// Held from taking a seq number until the request is in the FIFO, so the queue
+// order is the seq order with several submitting tasks (a mutex: the send may block)
+static SemaphoreHandle_t storage_submit_mutex;
+static StaticSemaphore_t storage_submit_mutex_buf;
+
+// Boot trace (written by whichever task runs a stage, hence the spinlock)
+static boot_trace_entry_t boot_trace[BOOT_TRACE_MAX_ENTRIES];
+static int boot_trace_count = 0;
+static portMUX_TYPE boot_trace_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Boot dependency tracking for the concurrent init jobs
+static EventGroupHandle_t boot_events;
+static StaticEventGroup_t boot_events_buf;
+
+// Long-lived tasks run on static stacks; task_records lists them for the "mem" report
+typedef struct {
+    const char *name;
+    TaskHandle_t handle;
+    uint32_t stack_bytes;
+    BaseType_t core;                    // Pinned core or tskNO_AFFINITY
+} task_record_t;
+
+static task_record_t task_records[TASK_RECORD_MAX];
+static int task_record_count = 0;
+static StackType_t ui_task_stack[UI_TASK_STACK];
+static StackType_t touch_task_stack[TOUCH_TASK_STACK];
+static StackType_t storage_task_stack[STORAGE_TASK_STACK];
+static StackType_t dlog_task_stack[DLOG_TASK_STACK];
+static StaticTask_t ui_task_tcb;
+static StaticTask_t touch_task_tcb;
+static StaticTask_t storage_task_tcb;
+static StaticTask_t dlog_task_tcb;
+static StackType_t hid_task_stack[HID_TASK_STACK];
+static StaticTask_t hid_task_tcb;
+
+// Macros queued for the HID transmit task (copied, so they may be edited while typing)
+static QueueHandle_t hid_queue;
+static StaticQueue_t hid_queue_buf;
+static uint8_t hid_queue_storage[HID_QUEUE_LEN * MAX_MACRO_LEN];
+
+// Hot-path performance counters (diagnostics screen and "perf" command)
+static perf_counters_t perf_counters;
+
+// Pre-rendered glyph cells; the mutex also keeps a cell alive while it is sent
+static glyph_cache_t glyph_cache;
+static SemaphoreHandle_t glyph_cache_mutex;
+static StaticSemaphore_t glyph_cache_mutex_buf;
+
+// Screen display lists. While the owner task composes a screen (screen_begin()
+// .. screen_end()) the drawing primitives append to screen_list instead of
+// sending pixels; screen_end() diffs it against screen_shown (the list of the
+// screen on the panel) and rasterizes only the damaged areas band by band into
+// render_bands, one band being filled while the other is on the wire. The two
+// lists then swap. Any pixel write outside a flush clears screen_shown_valid.
+static display_list_t screen_lists[2];
+static display_list_t *screen_list = &screen_lists[0];
+static display_list_t *screen_shown = &screen_lists[1];
+static bool screen_shown_valid = false;
+static bool screen_flushing = false;
+static bool main_screen_shown = false;         // screen_shown is the main screen (see set_macro_selection())
+static TaskHandle_t screen_list_owner = NULL;
+static int screen_list_depth = 0;
+static bool screen_list_recording = false;     // Cleared if the list overflows mid-screen
+static SemaphoreHandle_t screen_list_mutex;
+static StaticSemaphore_t screen_list_mutex_buf;
+DMA_ATTR static uint16_t render_bands[2][SCREEN_WIDTH * RENDER_BAND_ROWS];
+
+// Band buffer for anti-aliased text and icon decoding (shared by the touch task and ui_task)
+DMA_ATTR static uint16_t pixel_band[PIXEL_BAND_PIXELS];
+static SemaphoreHandle_t pixel_band_mutex;
+static StaticSemaphore_t pixel_band_mutex_buf;
+
+// Solid color run for direct (unrecorded) rectangle fills (recolored under the bus lock)
+DMA_ATTR static uint8_t fill_buffer[FILL_CHUNK_PIXELS * 2];
+
+// Raw -> screen touch mapping in use: the calibration matrix, or the full ADC
+// range while uncalibrated. Rebuilt by touch_map_update() when the calibration
+// changes, so mapping a sample never divides.
+static touch_cal_matrix_t touch_map;
+
+// Touch-to-pixel latency of the event being dispatched by the touch task.
+// Display transactions only count toward it while latency_armed is set and
+// they come from latency_owner (the touch task), so ui_task redraws are ignored.
+static latency_tracker_t touch_latency;
+static TaskHandle_t latency_owner = NULL;
+static volatile bool latency_armed = false;
+
+_Static_assert(APP_MODE_COUNT <= LATENCY_MAX_MODES,
+               "touch latency is tracked per app mode; raise LATENCY_MAX_MODES");
+
+// Display names indexed by app_mode_t
+static const char *const app_mode_names[APP_MODE_COUNT] = {
+    "selftest", "calibrate", "playback", "config", "keyboard", "bt_config", "diagnostics", "preview"
+};
+
+// Macro preview scroll position (touch task only)
+static struct {
+    uint32_t offset;            // Content x shown at the left edge of the view
+    uint32_t content_width;     // Whole pages of PREVIEW_VIEW_WIDTH
+    bool dragging;
+    int32_t drag_anchor;        // Content x under the finger while dragging
+    uint32_t drag_render_ms;    // Smoothed time from a drag sample to its scroll on the panel
+} preview;
+
+// Backlight and panel power (changed by the touch task only)
+typedef enum {
+    DISPLAY_ON,
+    DISPLAY_DIMMED,
+    DISPLAY_ASLEEP          // Backlight off, ILI9341 in sleep; GRAM keeps the frame
+} display_power_t;
+
+static display_power_t display_power = DISPLAY_ON;
+static uint32_t display_activity_ms = 0;        // Last touch (tick time)
+static uint32_t display_wake_ms = 0;            // Last SLPOUT
+static SemaphoreHandle_t touch_wake_sem;        // Given by the touch IRQ while waiting for a touch
+static StaticSemaphore_t touch_wake_sem_buf;
+
+// Power state residency (console "power" command)
+static power_residency_t power_residency;
+static portMUX_TYPE power_lock = portMUX_INITIALIZER_UNLOCKED;
+static const char *const power_state_names[POWER_STATE_COUNT] = { "active", "dimmed", "asleep", "hid" };
+
+// Typical supply current of the ESP32-32E board per power state (uA); replace
+// with readings from a USB power meter for a given unit and backlight
+static const uint32_t power_state_ua[POWER_STATE_COUNT] = {
+    [POWER_ACTIVE] = 115000,
+#ifdef CONFIG_PM_ENABLE
+    [POWER_DIMMED] = 60000,     // CPU light-sleeps between touches
+    [POWER_ASLEEP] = 3000,
+#else
+    [POWER_DIMMED] = 85000,
+    [POWER_ASLEEP] = 45000,     // Panel and backlight off, CPU idling at full clock
+#endif
+    [POWER_HID] = 130000,
+};
+
+#ifdef CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t touch_pm_lock;     // Full CPU clock, no light sleep, while a touch is handled
+#endif
+static TaskHandle_t ui_task_handle = NULL;
+
+// Finger track of the current press, for drawing drags ahead of the last sample (touch task only)
+static touch_predict_t touch_track;
+
+// Deferred log ring (any task writes, dlog_task drains)
+static dlog_record_t dlog_ring[DLOG_RING_SIZE];
+static uint32_t dlog_head = 0;        // Next slot to write
+static uint32_t dlog_tail = 0;        // Next slot to drain
+static uint32_t dlog_dropped = 0;     // Records lost because the ring was full
+static portMUX_TYPE dlog_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t dlog_task_handle = NULL;
 
 // =============================================================================
 // KEYBOARD LAYOUTS (Static data to avoid stack allocation)
@@ -407,6 +907,30 @@ static const char* kb_symbols[3][10] = {
 // FUNCTION DECLARATIONS
 // =============================================================================
 
+// Boot trace
+static int boot_trace_begin(const char *label);
+static void boot_trace_end(int entry);
+static void boot_trace_mark(const char *label);
+static void boot_delay_ms(uint32_t ms, const char *label);
+static void boot_trace_print_summary(void);
+
+// Deferred logging
+static void dlog_init(void);
+static void dlog_write(const char *subsystem, const char *fmt, const uint32_t *args);
+static void dlog_task(void *pvParameters);
+
+// Performance counters
+static void perf_timer_start(perf_timer_t *timer);
+static void perf_timer_stop(const perf_timer_t *timer, perf_stat_t *stat);
+static esp_err_t perf_nvs_commit(nvs_handle_t handle);
+static void perf_print_report(void);
+static uint32_t latency_now_us(void);
+static void latency_note_spi(void);
+static void latency_note_handler(void);
+
+// Console
+static void init_console(void);
+
 // System initialization
 static void init_nvs(void);
 static void init_gpio(void);
@@ -414,34 +938,95 @@ static void init_spi(void);
 
 // Storage functions
 static void load_macros(void);
-static void save_macro(int index, const char *text);
+static void set_default_macros(void);
+static esp_err_t save_macro(int index, const char *text);
 static void load_calibration(void);
-static void save_calibration(void);
+static esp_err_t save_calibration(const calibration_data_t *calibration);
+static esp_err_t erase_storage(void);
+static void load_boot_options(void);
+static esp_err_t save_boot_options(const boot_options_t *options);
+
+// Storage worker (deferred NVS writes)
+static void storage_worker_init(void);
+static void storage_worker_task(void *pvParameters);
+static bool storage_submit(storage_request_t *request);
+static bool storage_submit_macro(int index, const char *text);
+static bool storage_submit_calibration(void);
+static bool storage_submit_erase(void);
+static bool storage_submit_boot_options(void);
+static void storage_process_events(void);
 
 // Display functions (to be implemented in display.c)
 static void display_init(void);
+static void display_init_task(void *pvParameters);
+static void touch_init(void);
+static void layout_macro_buttons(uint16_t top, uint16_t bottom_row_y, uint16_t button_height);
 static void draw_main_screen(void);
+static void draw_main_quadrant(int index);
+static void set_macro_selection(int selected);
 static void draw_config_screen(void);
 static void draw_keyboard(void);
 static void draw_bt_config_screen(void);
 static void draw_calibration_screen(void);
+static void draw_diagnostics_screen(void);
+static void draw_bt_status_icon(uint16_t x, uint16_t y, uint16_t bg);
+static void draw_macro_button_icons(const button_t *button, bool bt_status);
+static void draw_preview_screen(void);
+static void preview_render_columns(uint32_t content_x, uint16_t width);
+static void preview_scroll_to(uint32_t target);
+static void preview_drag(const gesture_event_t *event);
+static void preview_drag_end(const gesture_event_t *event);
 
 // Display helper functions
+static void display_bus_lock(void);
+static void display_bus_unlock(void);
+static void display_spi_add(int clock_hz);
+static bool ili9341_read_status(uint8_t cmd, uint8_t *value);
 static void ili9341_fill_screen(uint16_t color);
 static void ili9341_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
 static void ili9341_set_addr_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+static void ili9341_set_scroll_area(uint16_t fixed_left, uint16_t scroll_width, uint16_t fixed_right);
+static void ili9341_set_scroll_start(uint16_t column);
+static void ili9341_reset_scroll(void);
 static void ili9341_draw_button(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color, const char* label);
 static void ili9341_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
 static void ili9341_draw_string(uint16_t x, uint16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size);
+static void ili9341_draw_text_aa(uint16_t x, uint16_t y, const char* text, int len, uint16_t color, uint16_t bg);
+static void ili9341_draw_icon(uint16_t x, uint16_t y, const icon_t *icon, uint16_t bg);
+
+// Display list (full-screen redraws)
+static void screen_begin(uint16_t clear_color);
+static void screen_end(void);
+static bool screen_capturing(size_t text_len);
+static void screen_flush(void);
+static void screen_send_rect(const dl_rect_t *rect, uint32_t *raster_cycles);
+static void screen_invalidate(void);
+static bool screen_begin_patch(const dl_rect_t *cut, int cut_count);
 
 // Display test functions
-static void run_display_test(void);
+static void run_display_test(int max_cycles);
+static bool run_display_quick_test(void);
+static void run_startup_selftest(void);
 static bool check_touch_pressed(void);
+static bool xpt2046_burst(const uint8_t *commands, int count, uint16_t *values);
+static void backlight_init(void);
+static void backlight_set(uint32_t duty, uint32_t fade_ms);
+static void display_power_idle(uint32_t now_ms);
+static void display_power_activity(uint32_t now_ms);
+static void display_sleep_until_touch(void);
+static bool touch_wait_irq(uint32_t timeout_ms);
+static uint32_t display_power_next_ms(uint32_t now_ms);
+static void power_init(void);
+static void power_enter(power_state_t state);
+static void power_leave_hid(void);
+static void power_hold_cpu(bool hold);
 static bool read_touch_coordinates(uint16_t *x, uint16_t *y);
 
 // Bluetooth functions (to be implemented in bluetooth.c)
 static void ble_init(void);
 static void ble_send_text(const char *text);
+static void hid_task(void *pvParameters);
+static void hid_type_text(const char *text);
 
 // Touch handling
 static void handle_touch_task(void *pvParameters);
@@ -452,11 +1037,19 @@ static void handle_config_touch(uint16_t x, uint16_t y);
 static void handle_keyboard_touch(uint16_t x, uint16_t y);
 static void handle_bt_config_touch(uint16_t x, uint16_t y);
 static void handle_calibration_touch(uint16_t raw_x, uint16_t raw_y);
-static uint16_t map_touch_x(uint16_t raw_x);
-static uint16_t map_touch_y(uint16_t raw_y);
+static void handle_diagnostics_touch(uint16_t x, uint16_t y);
+static void handle_preview_touch(uint16_t x, uint16_t y);
+static void dispatch_gesture(const gesture_event_t *event);
+static void dispatch_touch(uint16_t screen_x, uint16_t screen_y, uint32_t press_duration);
+static void cycle_keyboard_page(bool forward);
+static void map_touch(uint16_t raw_x, uint16_t raw_y, uint16_t *screen_x, uint16_t *screen_y);
+static void touch_map_update(void);
 
 // Main tasks
 static void ui_task(void *pvParameters);
+static TaskHandle_t task_create_static(TaskFunction_t fn, const char *name, StackType_t *stack,
+                                       uint32_t stack_bytes, UBaseType_t priority, StaticTask_t *tcb,
+                                       BaseType_t core);
 
 // =============================================================================
 // MAIN APPLICATION ENTRY POINT
@@ -464,42 +1057,417 @@ static void ui_task(void *pvParameters);
 
 void app_main(void)
 {
+    int stage;
+    
+    boot_trace_mark("app_main");
     ESP_LOGI(TAG, "ESP32 MacroPad Starting...");
     ESP_LOGI(TAG, "Firmware Version: %s", KEYBOT_VERSION);
     ESP_LOGI(TAG, "ESP-IDF Version: %s", esp_get_idf_version());
     
+    // Boot runs as concurrent jobs with explicit dependencies:
+    //   display job:  display_init()              -> BOOT_BIT_DISPLAY
+    //   app_main:     load_macros/calibration     -> BOOT_BIT_STORAGE
+    //                 ble_init()                  -> BOOT_BIT_BLE
+    //   ui_task:      waits STORAGE + DISPLAY, draws first screen -> BOOT_BIT_UI
+    //   touch_task:   waits UI
+    // The display job spends most of its time in fixed reset delays, so the
+    // NVS loads and BLE bring-up overlap with them.
+    dlog_init();
+    
+    boot_events = xEventGroupCreateStatic(&boot_events_buf);
+    
     // Initialize NVS for persistent storage
+    stage = boot_trace_begin("init_nvs");
     init_nvs();
+    boot_trace_end(stage);
     
     // Initialize GPIO
+    stage = boot_trace_begin("init_gpio");
     init_gpio();
+    boot_trace_end(stage);
     
     // Initialize SPI for display and touch
+    stage = boot_trace_begin("init_spi");
     init_spi();
+    boot_trace_end(stage);
+    
+    // Initialize display in its own task (overlaps with everything below)
+    xTaskCreatePinnedToCore(display_init_task, "display_init", DISPLAY_INIT_STACK, NULL, DISPLAY_INIT_PRIORITY,
+                            NULL, APP_CORE);
+    
+    // Initialize touch controller (separate SPI bus)
+    stage = boot_trace_begin("touch_init");
+    touch_init();
+    boot_trace_end(stage);
+    
+    // Automatic light sleep between touches (if enabled in sdkconfig)
+    stage = boot_trace_begin("power_init");
+    power_init();
+    boot_trace_end(stage);
     
     // Load saved macros from NVS
+    stage = boot_trace_begin("load_macros");
     load_macros();
+    boot_trace_end(stage);
     
     // Load calibration data from NVS
+    stage = boot_trace_begin("load_calibration");
     load_calibration();
+    touch_map_update();
+    boot_trace_end(stage);
     
-    // Initialize display
-    display_init();
+    // Load boot options (self-test policy) from NVS
+    stage = boot_trace_begin("load_boot_options");
+    load_boot_options();
+    boot_trace_end(stage);
+
+    // Start the storage worker (all NVS writes go through it from here on)
+    stage = boot_trace_begin("storage_worker_init");
+    storage_worker_init();
+    boot_trace_end(stage);
+    xEventGroupSetBits(boot_events, BOOT_BIT_STORAGE);
+    
+    // Create UI task (draws as soon as storage and display are ready)
+    ui_task_handle = task_create_static(ui_task, "ui_task", ui_task_stack, UI_TASK_STACK, UI_TASK_PRIORITY,
+                                        &ui_task_tcb, APP_CORE);
+    
+    // Create touch handling task
+    task_create_static(handle_touch_task, "touch_task", touch_task_stack, TOUCH_TASK_STACK, TOUCH_TASK_PRIORITY,
+                       &touch_task_tcb, APP_CORE);
     
     // Initialize Bluetooth HID
+    stage = boot_trace_begin("ble_init");
     ble_init();
+    boot_trace_end(stage);
+    xEventGroupSetBits(boot_events, BOOT_BIT_BLE);
     
-    // Create UI task
-    xTaskCreate(ui_task, "ui_task", 4096, NULL, 5, NULL);
-    
-    // Create touch handling task
-    xTaskCreate(handle_touch_task, "touch_task", 4096, NULL, 4, NULL);
+    // Start the serial console (boot trace and diagnostics commands)
+    stage = boot_trace_begin("init_console");
+    init_console();
+    boot_trace_end(stage);
     
+    boot_trace_mark("app_main done");
     ESP_LOGI(TAG, "Initialization complete!");
     
     // Main loop runs in FreeRTOS tasks, app_main can return
 }
 
+/**
+ * Start a long-lived task on a static stack, pinned to core (or tskNO_AFFINITY),
+ * and record it for the "mem" report (called from app_main only, so
+ * task_records needs no lock)
+ */
+static TaskHandle_t task_create_static(TaskFunction_t fn, const char *name, StackType_t *stack,
+                                       uint32_t stack_bytes, UBaseType_t priority, StaticTask_t *tcb,
+                                       BaseType_t core)
+{
+    TaskHandle_t handle = xTaskCreateStaticPinnedToCore(fn, name, stack_bytes, NULL, priority, stack, tcb, core);
+    
+    if (task_record_count < TASK_RECORD_MAX) {
+        task_records[task_record_count].name = name;
+        task_records[task_record_count].handle = handle;
+        task_records[task_record_count].stack_bytes = stack_bytes;
+        task_records[task_record_count].core = core;
+        task_record_count++;
+    }
+    return handle;
+}
+
+// =============================================================================
+// BOOT TRACE
+// =============================================================================
+//
+// Lightweight startup profiler. Each init stage and each fixed delay records
+// esp_timer_get_time() timestamps into a static table; a summary sorted by
+// duration is printed at the end of app_main and is available later through
+// the "boot" console command.
+
+/**
+ * Start timing a boot stage
+ * Returns the entry index to pass to boot_trace_end(), or -1 if the table is full
+ */
+static int boot_trace_begin(const char *label)
+{
+    int64_t now = esp_timer_get_time();
+    int entry = -1;
+    
+    portENTER_CRITICAL(&boot_trace_lock);
+    if (boot_trace_count < BOOT_TRACE_MAX_ENTRIES) {
+        entry = boot_trace_count++;
+        boot_trace[entry].label = label;
+        boot_trace[entry].start_us = now;
+        boot_trace[entry].end_us = now;
+        boot_trace[entry].is_delay = false;
+    }
+    portEXIT_CRITICAL(&boot_trace_lock);
+    
+    return entry;
+}
+
+/**
+ * Finish timing a boot stage started with boot_trace_begin()
+ */
+static void boot_trace_end(int entry)
+{
+    if (entry < 0 || entry >= BOOT_TRACE_MAX_ENTRIES) return;
+    boot_trace[entry].end_us = esp_timer_get_time();
+}
+
+/**
+ * Record a zero-length milestone (e.g. "init complete")
+ */
+static void boot_trace_mark(const char *label)
+{
+    boot_trace_begin(label);
+}
+
+/**
+ * vTaskDelay() wrapper that records the wait in the boot trace
+ */
+static void boot_delay_ms(uint32_t ms, const char *label)
+{
+    int entry = boot_trace_begin(label);
+    if (entry >= 0) {
+        boot_trace[entry].is_delay = true;
+    }
+    vTaskDelay(pdMS_TO_TICKS(ms));
+    boot_trace_end(entry);
+}
+
+/**
+ * Print the boot trace, longest stages first
+ */
+static void boot_trace_print_summary(void)
+{
+    int order[BOOT_TRACE_MAX_ENTRIES];
+    int count = boot_trace_count;
+    int64_t delay_us = 0;
+    
+    // Insertion sort by duration (descending) - the table is tiny
+    for (int i = 0; i < count; i++) {
+        int64_t duration = boot_trace[i].end_us - boot_trace[i].start_us;
+        int j = i;
+        while (j > 0) {
+            int prev = order[j - 1];
+            if (boot_trace[prev].end_us - boot_trace[prev].start_us >= duration) break;
+            order[j] = prev;
+            j--;
+        }
+        order[j] = i;
+    }
+    
+    ESP_LOGI(TAG, "========================================");
+    ESP_LOGI(TAG, "Boot trace (%d entries, sorted by duration)", count);
+    ESP_LOGI(TAG, "  %-28s %10s %10s", "stage", "start ms", "took ms");
+    for (int i = 0; i < count; i++) {
+        const boot_trace_entry_t *e = &boot_trace[order[i]];
+        int64_t duration = e->end_us - e->start_us;
+        ESP_LOGI(TAG, "  %-28s %10.1f %10.1f%s", e->label,
+                 e->start_us / 1000.0, duration / 1000.0, e->is_delay ? "  (delay)" : "");
+        if (e->is_delay) {
+            delay_us += duration;
+        }
+    }
+    
+    ESP_LOGI(TAG, "Fixed delays: %.1f ms", delay_us / 1000.0);
+    ESP_LOGI(TAG, "Time since boot: %.1f ms", esp_timer_get_time() / 1000.0);
+    ESP_LOGI(TAG, "========================================");
+}
+
+// =============================================================================
+// DEFERRED LOG
+// =============================================================================
+//
+// Hot-path logging without UART cost at the call site. dlog_write() copies a
+// fixed-size record into a ring under a spinlock and notifies dlog_task, which
+// runs at idle+1 priority and does the formatting and blocking UART output.
+// When the ring is full new records are dropped and counted; the count is
+// reported with the next line that gets through.
+
+/**
+ * Start the deferred log drain task
+ */
+static void dlog_init(void)
+{
+    dlog_task_handle = task_create_static(dlog_task, "dlog_task", dlog_task_stack, DLOG_TASK_STACK,
+                                          DLOG_TASK_PRIORITY, &dlog_task_tcb, tskNO_AFFINITY);
+}
+
+/**
+ * Queue one deferred log record (called through the DLOGx macros)
+ */
+static void dlog_write(const char *subsystem, const char *fmt, const uint32_t *args)
+{
+    uint32_t timestamp = esp_log_timestamp();
+    bool queued = false;
+    
+    portENTER_CRITICAL(&dlog_lock);
+    if (dlog_head - dlog_tail < DLOG_RING_SIZE) {
+        dlog_record_t *rec = &dlog_ring[dlog_head & (DLOG_RING_SIZE - 1)];
+        rec->fmt = fmt;
+        rec->subsystem = subsystem;
+        rec->timestamp_ms = timestamp;
+        memcpy(rec->args, args, sizeof(rec->args));
+        dlog_head++;
+        queued = true;
+    } else {
+        dlog_dropped++;
+    }
+    portEXIT_CRITICAL(&dlog_lock);
+    
+    if (queued && dlog_task_handle != NULL) {
+        xTaskNotifyGive(dlog_task_handle);
+    }
+}
+
+/**
+ * Drain task: format and print queued records
+ */
+static void dlog_task(void *pvParameters)
+{
+    static char line[DLOG_LINE_LEN];
+    dlog_record_t rec;
+    uint32_t dropped;
+    
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        
+        while (1) {
+            portENTER_CRITICAL(&dlog_lock);
+            if (dlog_tail == dlog_head) {
+                portEXIT_CRITICAL(&dlog_lock);
+                break;
+            }
+            rec = dlog_ring[dlog_tail & (DLOG_RING_SIZE - 1)];
+            dlog_tail++;
+            dropped = dlog_dropped;
+            dlog_dropped = 0;
+            portEXIT_CRITICAL(&dlog_lock);
+            
+            if (dropped > 0) {
+                ESP_LOGW(TAG, "Deferred log: %lu record(s) dropped", (unsigned long)dropped);
+            }
+            
+            snprintf(line, sizeof(line), rec.fmt,
+                     rec.args[0], rec.args[1], rec.args[2], rec.args[3]);
+            ESP_LOGI(TAG, "[%lu] %s: %s", (unsigned long)rec.timestamp_ms, rec.subsystem, line);
+        }
+    }
+}
+
+// =============================================================================
+// PERFORMANCE COUNTERS
+// =============================================================================
+//
+// Cheap always-on counters for field units. Durations are measured with the
+// CPU cycle counter (a register read) and stored in microseconds in
+// fixed-size perf_stat_t records (see perf_stats.h). Shown on the hidden
+// diagnostics screen (30 s press) and by the "perf" console command.
+
+/**
+ * Start a cycle-counter measurement
+ */
+static void perf_timer_start(perf_timer_t *timer)
+{
+    timer->core = xPortGetCoreID();
+    timer->cycles = esp_cpu_get_cycle_count();
+}
+
+/**
+ * Record the microseconds elapsed since perf_timer_start()
+ */
+static void perf_timer_stop(const perf_timer_t *timer, perf_stat_t *stat)
+{
+    uint32_t cycles = esp_cpu_get_cycle_count() - timer->cycles;
+    
+    if (xPortGetCoreID() != timer->core) {
+        return;  // Counters differ per core, the delta is meaningless
+    }
+    perf_stat_record(stat, cycles / esp_rom_get_cpu_ticks_per_us());
+}
+
+/**
+ * nvs_commit() with its duration recorded in perf_counters.nvs_commit_us
+ */
+static esp_err_t perf_nvs_commit(nvs_handle_t handle)
+{
+    perf_timer_t timer;
+    perf_timer_start(&timer);
+    esp_err_t err = nvs_commit(handle);
+    perf_timer_stop(&timer, &perf_counters.nvs_commit_us);
+    return err;
+}
+
+/**
+ * Print all counters (console "perf" command)
+ */
+static void perf_print_report(void)
+{
+    printf("Display SPI:  %lu transactions, %llu bytes\n",
+           (unsigned long)perf_counters.spi_transactions,
+           (unsigned long long)perf_counters.spi_bytes);
+    printf("Touch:        %lu samples, %lu rejected\n",
+           (unsigned long)perf_counters.touch_samples,
+           (unsigned long)perf_counters.touch_rejected);
+    printf("Events:       %lu dispatched\n", (unsigned long)perf_counters.events_dispatched);
+    printf("HID reports:  %lu\n", (unsigned long)perf_counters.hid_reports);
+    printf("Touch reads (%d conversions per HSPI burst):\n", 1 + 2 * TOUCH_BURST_SAMPLES);
+    perf_stat_print("touch_read", &perf_counters.touch_read_us);
+    uint32_t read_avg = perf_stat_avg(&perf_counters.touch_read_us);
+    printf("  %lu conversions total; %lu samples/s, %lu conversions/s while reading\n",
+           (unsigned long)perf_counters.touch_conversions,
+           (unsigned long)(read_avg ? 1000000 / read_avg : 0),
+           (unsigned long)(read_avg ? (1 + 2 * TOUCH_BURST_SAMPLES) * 1000000 / read_avg : 0));
+    printf("Glyph cache:  %lu hits, %lu misses, %lu evictions, %lu uncached, %lu cells / %lu bytes\n",
+           (unsigned long)glyph_cache.stats.hits, (unsigned long)glyph_cache.stats.misses,
+           (unsigned long)glyph_cache.stats.evictions, (unsigned long)glyph_cache.stats.uncached,
+           (unsigned long)glyph_cache.stats.entries, (unsigned long)glyph_cache.stats.bytes_used);
+    printf("NVS commits:\n");
+    perf_stat_print("nvs_commit", &perf_counters.nvs_commit_us);
+    printf("Screen flushes (band rasterization overlapped with SPI):\n");
+    perf_stat_print("raster", &perf_counters.band_raster_us);
+    perf_stat_print("flush", &perf_counters.band_flush_us);
+    printf("  %lu full, %lu partial, %lu unchanged, %llu pixels sent\n",
+           (unsigned long)perf_counters.screens_full, (unsigned long)perf_counters.screens_partial,
+           (unsigned long)perf_counters.screens_unchanged, (unsigned long long)perf_counters.screen_pixels);
+    printf("Display bus:  %lu locks, %lu contended (waited for another task)\n",
+           (unsigned long)perf_counters.bus_locks, (unsigned long)perf_counters.bus_contended);
+    perf_stat_print("bus_wait", &perf_counters.bus_wait_us);
+    printf("Render time by screen:\n");
+    for (int i = 0; i < APP_MODE_COUNT; i++) {
+        if (i == MODE_DISPLAY_TEST) continue;  // Test patterns are not a screen render
+        perf_stat_print(app_mode_names[i], &perf_counters.render_us[i]);
+    }
+}
+
+/**
+ * Microsecond timestamp for latency probes (esp_timer is consistent across cores)
+ */
+static uint32_t latency_now_us(void)
+{
+    return (uint32_t)esp_timer_get_time();
+}
+
+/**
+ * Latency probe: a display transaction is being sent
+ */
+static void latency_note_spi(void)
+{
+    if (latency_armed && xTaskGetCurrentTaskHandle() == latency_owner) {
+        latency_stamp(&touch_latency, LATENCY_FIRST_SPI, latency_now_us());
+    }
+}
+
+/**
+ * Latency probe: a touch handler has been entered
+ */
+static void latency_note_handler(void)
+{
+    if (latency_armed) {
+        latency_stamp(&touch_latency, LATENCY_HANDLER, latency_now_us());
+    }
+}
+
 // =============================================================================
 // INITIALIZATION FUNCTIONS
 // =============================================================================
@@ -529,18 +1497,8 @@ static void init_gpio(void)
 {
     ESP_LOGI(TAG, "Initializing GPIO...");
     
-    // Configure backlight pin
-    gpio_config_t io_conf = {
-        .pin_bit_mask = (1ULL << PIN_BACKLIGHT),
-        .mode = GPIO_MODE_OUTPUT,
-        .pull_up_en = GPIO_PULLUP_DISABLE,
-        .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type = GPIO_INTR_DISABLE
-    };
-    gpio_config(&io_conf);
-    
-    // Turn on backlight
-    gpio_set_level(PIN_BACKLIGHT, 1);
+    // Backlight on at full brightness, PWM-dimmable
+    backlight_init();
     
     ESP_LOGI(TAG, "GPIO initialized");
 }
@@ -604,10 +1562,7 @@ static void load_macros(void)
     
     if (err != ESP_OK) {
         ESP_LOGW(TAG, "NVS namespace not found, using defaults");
-        // Set default macro texts
-        for (int i = 0; i < NUM_MACROS; i++) {
-            snprintf(app_state.macros[i], MAX_MACRO_LEN, "Macro %d", i + 1);
-        }
+        set_default_macros();
         return;
     }
     
@@ -635,14 +1590,27 @@ static void load_macros(void)
     nvs_close(nvs_handle);
 }
 
+/**
+ * Reset all macros to their default texts (RAM only)
+ */
+static void set_default_macros(void)
+{
+    for (int i = 0; i < NUM_MACROS; i++) {
+        snprintf(app_state.macros[i], MAX_MACRO_LEN, "Macro %d", i + 1);
+    }
+}
+
 /**
  * Save a macro to NVS
+ * 
+ * Blocking write + commit. Only called from the storage worker task;
+ * the UI uses storage_submit_macro() instead.
  */
-static void save_macro(int index, const char *text)
+static esp_err_t save_macro(int index, const char *text)
 {
     if (index < 0 || index >= NUM_MACROS) {
         ESP_LOGE(TAG, "Invalid macro index: %d", index);
-        return;
+        return ESP_ERR_INVALID_ARG;
     }
     
     ESP_LOGI(TAG, "Saving macro %d to NVS...", index);
@@ -652,7 +1620,7 @@ static void save_macro(int index, const char *text)
     
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error opening NVS: %s", esp_err_to_name(err));
-        return;
+        return err;
     }
     
     char key[16];
@@ -663,18 +1631,16 @@ static void save_macro(int index, const char *text)
         ESP_LOGE(TAG, "Error saving macro: %s", esp_err_to_name(err));
     } else {
         // Commit changes
-        err = nvs_commit(nvs_handle);
+        err = perf_nvs_commit(nvs_handle);
         if (err != ESP_OK) {
             ESP_LOGE(TAG, "Error committing NVS: %s", esp_err_to_name(err));
         } else {
             ESP_LOGI(TAG, "Macro %d saved successfully", index);
-            // Update local copy
-            strncpy(app_state.macros[index], text, MAX_MACRO_LEN - 1);
-            app_state.macros[index][MAX_MACRO_LEN - 1] = '\0';
         }
     }
     
     nvs_close(nvs_handle);
+    return err;
 }
 
 /**
@@ -693,9 +1659,33 @@ static void load_calibration(void)
         return;
     }
     
-    // Try to load calibration data
-    size_t required_size = sizeof(calibration_data_t);
-    err = nvs_get_blob(nvs_handle, "calibration", &app_state.calibration, &required_size);
+    // Try to load calibration data (the blob size tells the two layouts apart)
+    size_t required_size = 0;
+    err = nvs_get_blob(nvs_handle, "calibration", NULL, &required_size);
+    
+    if (err == ESP_OK && required_size == sizeof(calibration_v1_t)) {
+        calibration_v1_t old;
+        err = nvs_get_blob(nvs_handle, "calibration", &old, &required_size);
+        if (err == ESP_OK) {
+            // Same mapping as the old per-axis code: raw_y across, raw_x down
+            touch_cal_from_ranges(&app_state.calibration.matrix,
+                                  old.raw_x_min, old.raw_x_max, SCREEN_WIDTH,
+                                  old.raw_y_min, old.raw_y_max, SCREEN_HEIGHT);
+            app_state.calibration.rms_error = 0;
+            app_state.calibration.max_error = 0;
+            app_state.calibration.points = 0;
+            app_state.calibration.is_calibrated = old.is_calibrated;
+            ESP_LOGI(TAG, "Converted two-point calibration X(%d-%d) Y(%d-%d); recalibrate for skew correction",
+                     old.raw_x_min, old.raw_x_max, old.raw_y_min, old.raw_y_max);
+        }
+    } else if (err == ESP_OK && required_size == sizeof(calibration_data_t)) {
+        err = nvs_get_blob(nvs_handle, "calibration", &app_state.calibration, &required_size);
+    } else if (err == ESP_OK) {
+        ESP_LOGW(TAG, "Calibration data has unknown size %u, ignoring it", (unsigned)required_size);
+        app_state.calibration.is_calibrated = false;
+        nvs_close(nvs_handle);
+        return;
+    }
     
     if (err == ESP_ERR_NVS_NOT_FOUND) {
         ESP_LOGW(TAG, "Calibration data not found");
@@ -703,10 +1693,10 @@ static void load_calibration(void)
     } else if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error reading calibration data: %s", esp_err_to_name(err));
         app_state.calibration.is_calibrated = false;
-    } else {
-        ESP_LOGI(TAG, "Calibration data loaded: X(%d-%d) Y(%d-%d)", 
-                 app_state.calibration.raw_x_min, app_state.calibration.raw_x_max,
-                 app_state.calibration.raw_y_min, app_state.calibration.raw_y_max);
+    } else if (app_state.calibration.points > 0) {
+        ESP_LOGI(TAG, "Calibration data loaded: %d points, error %.1f px rms / %.1f px max",
+                 app_state.calibration.points, app_state.calibration.rms_error,
+                 app_state.calibration.max_error);
     }
     
     nvs_close(nvs_handle);
@@ -714,8 +1704,11 @@ static void load_calibration(void)
 
 /**
  * Save calibration data to NVS
+ * 
+ * Blocking write + commit. Only called from the storage worker task;
+ * the UI uses storage_submit_calibration() instead.
  */
-static void save_calibration(void)
+static esp_err_t save_calibration(const calibration_data_t *calibration)
 {
     ESP_LOGI(TAG, "Saving calibration data to NVS...");
     
@@ -724,25 +1717,306 @@ static void save_calibration(void)
     
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error opening NVS: %s", esp_err_to_name(err));
-        return;
+        return err;
     }
     
-    err = nvs_set_blob(nvs_handle, "calibration", &app_state.calibration, sizeof(calibration_data_t));
+    err = nvs_set_blob(nvs_handle, "calibration", calibration, sizeof(calibration_data_t));
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error saving calibration: %s", esp_err_to_name(err));
     } else {
         // Commit changes
-        err = nvs_commit(nvs_handle);
+        err = perf_nvs_commit(nvs_handle);
         if (err != ESP_OK) {
             ESP_LOGE(TAG, "Error committing NVS: %s", esp_err_to_name(err));
         } else {
-            ESP_LOGI(TAG, "Calibration data saved successfully: X(%d-%d) Y(%d-%d)", 
-                     app_state.calibration.raw_x_min, app_state.calibration.raw_x_max,
-                     app_state.calibration.raw_y_min, app_state.calibration.raw_y_max);
+            ESP_LOGI(TAG, "Calibration data saved successfully (%d points)", calibration->points);
         }
     }
     
     nvs_close(nvs_handle);
+    return err;
+}
+
+/**
+ * Load boot options from NVS (keeps the defaults if none are stored)
+ */
+static void load_boot_options(void)
+{
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs_handle);
+    
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "NVS namespace not found, using default boot options");
+        return;
+    }
+    
+    boot_options_t options;
+    size_t required_size = sizeof(options);
+    err = nvs_get_blob(nvs_handle, "boot_opts", &options, &required_size);
+    
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGW(TAG, "Boot options not found, using defaults");
+    } else if (err != ESP_OK || required_size != sizeof(options) ||
+               options.selftest_mode > SELFTEST_NEVER) {
+        ESP_LOGE(TAG, "Invalid boot options in NVS (%s), using defaults", esp_err_to_name(err));
+    } else {
+        app_state.boot_options = options;
+        ESP_LOGI(TAG, "Boot options loaded: self-test mode %d", options.selftest_mode);
+    }
+    
+    nvs_close(nvs_handle);
+}
+
+/**
+ * Save boot options to NVS
+ * 
+ * Only called from the storage worker task; the UI uses storage_submit_boot_options().
+ */
+static esp_err_t save_boot_options(const boot_options_t *options)
+{
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
+    
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error opening NVS: %s", esp_err_to_name(err));
+        return err;
+    }
+    
+    err = nvs_set_blob(nvs_handle, "boot_opts", options, sizeof(boot_options_t));
+    if (err == ESP_OK) {
+        err = perf_nvs_commit(nvs_handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error saving boot options: %s", esp_err_to_name(err));
+    }
+    
+    nvs_close(nvs_handle);
+    return err;
+}
+
+/**
+ * Erase every key in the macropad NVS namespace
+ * 
+ * Only called from the storage worker task; the UI uses storage_submit_erase().
+ */
+static esp_err_t erase_storage(void)
+{
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open NVS for erasing: %s", esp_err_to_name(err));
+        return err;
+    }
+    
+    err = nvs_erase_all(nvs_handle);
+    if (err == ESP_OK) {
+        err = perf_nvs_commit(nvs_handle);
+    }
+    nvs_close(nvs_handle);
+    
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "NVS erased successfully");
+    } else {
+        ESP_LOGE(TAG, "Error erasing NVS: %s", esp_err_to_name(err));
+    }
+    return err;
+}
+
+// =============================================================================
+// STORAGE WORKER
+// =============================================================================
+//
+// nvs_commit() can stall for tens of milliseconds when a flash page has to be
+// erased, so the UI never writes NVS directly. Write requests are copied into
+// a FIFO queue and applied by a single worker task, which keeps them in
+// submission order (a save queued after CLEAR FLASH always lands after the
+// erase). The in-RAM copy in app_state is updated at submit time so screens
+// can be redrawn immediately; the worker reports each completion or failure
+// back to the UI through storage_event_queue.
+
+/**
+ * Create the storage queues and start the worker task
+ */
+static void storage_worker_init(void)
+{
+    storage_request_queue = xQueueCreateStatic(STORAGE_QUEUE_LEN, sizeof(storage_request_t),
+                                               storage_request_storage, &storage_request_queue_buf);
+    storage_submit_mutex = xSemaphoreCreateRecursiveMutexStatic(&storage_submit_mutex_buf);
+    storage_event_queue = xQueueCreateStatic(STORAGE_EVENT_QUEUE_LEN, sizeof(storage_event_t),
+                                             storage_event_storage, &storage_event_queue_buf);
+    
+    // Lower priority than the UI and touch tasks so flash writes never delay a redraw
+    task_create_static(storage_worker_task, "storage_task", storage_task_stack, STORAGE_TASK_STACK,
+                       STORAGE_TASK_PRIORITY, &storage_task_tcb, tskNO_AFFINITY);
+    ESP_LOGI(TAG, "Storage worker started");
+}
+
+/**
+ * Storage worker task - applies queued NVS writes in order
+ */
+static void storage_worker_task(void *pvParameters)
+{
+    // Static so the ~600 byte request does not live on the task stack
+    static storage_request_t request;
+    
+    while (1) {
+        if (xQueueReceive(storage_request_queue, &request, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        
+        storage_event_t event = {
+            .type = request.type,
+            .seq = request.seq,
+            .index = request.index,
+            .err = ESP_OK
+        };
+        
+        switch (request.type) {
+            case STORAGE_REQ_SAVE_MACRO:
+                event.err = save_macro(request.index, request.text);
+                break;
+            
+            case STORAGE_REQ_SAVE_CALIBRATION:
+                event.err = save_calibration(&request.calibration);
+                break;
+            
+            case STORAGE_REQ_SAVE_BOOT_OPTIONS:
+                event.err = save_boot_options(&request.boot_options);
+                break;
+            
+            case STORAGE_REQ_ERASE_ALL:
+                event.err = erase_storage();
+                break;
+        }
+        
+        if (xQueueSend(storage_event_queue, &event, 0) != pdTRUE) {
+            ESP_LOGW(TAG, "Storage event queue full, dropping event for request #%lu", event.seq);
+        }
+        if (ui_task_handle != NULL) {
+            xTaskNotifyGive(ui_task_handle);    // The UI task sleeps until it has work
+        }
+    }
+}
+
+/**
+ * Queue a request for the storage worker
+ * Blocks only if STORAGE_QUEUE_LEN writes are already pending.
+ */
+static bool storage_submit(storage_request_t *request)
+{
+    bool queued = true;
+    
+    xSemaphoreTakeRecursive(storage_submit_mutex, portMAX_DELAY);
+    request->seq = ++storage_next_seq;
+    if (xQueueSend(storage_request_queue, request, portMAX_DELAY) != pdTRUE) {
+        ESP_LOGE(TAG, "Failed to queue storage request #%lu", request->seq);
+        queued = false;
+    }
+    xSemaphoreGiveRecursive(storage_submit_mutex);
+    return queued;
+}
+
+/**
+ * Update a macro in RAM and queue it for writing to NVS
+ */
+static bool storage_submit_macro(int index, const char *text)
+{
+    if (index < 0 || index >= NUM_MACROS) {
+        ESP_LOGE(TAG, "Invalid macro index: %d", index);
+        return false;
+    }
+    
+    // Update local copy immediately so the next screen shows the new text
+    strncpy(app_state.macros[index], text, MAX_MACRO_LEN - 1);
+    app_state.macros[index][MAX_MACRO_LEN - 1] = '\0';
+    
+    // Static: the request is copied into the queue, and only the touch task submits
+    static storage_request_t request;
+    memset(&request, 0, sizeof(request));
+    request.type = STORAGE_REQ_SAVE_MACRO;
+    request.index = index;
+    strncpy(request.text, app_state.macros[index], MAX_MACRO_LEN - 1);
+    
+    return storage_submit(&request);
+}
+
+/**
+ * Queue the current calibration data for writing to NVS
+ */
+static bool storage_submit_calibration(void)
+{
+    static storage_request_t request;
+    memset(&request, 0, sizeof(request));
+    request.type = STORAGE_REQ_SAVE_CALIBRATION;
+    request.index = -1;
+    request.calibration = app_state.calibration;
+    
+    return storage_submit(&request);
+}
+
+/**
+ * Queue an erase of the whole NVS namespace
+ */
+static bool storage_submit_erase(void)
+{
+    static storage_request_t request;
+    memset(&request, 0, sizeof(request));
+    request.type = STORAGE_REQ_ERASE_ALL;
+    request.index = -1;
+    
+    return storage_submit(&request);
+}
+
+/**
+ * Queue the current boot options for writing to NVS
+ */
+static bool storage_submit_boot_options(void)
+{
+    // Called from both the UI task (self-test) and the console task: the static
+    // request is only touched with the (recursive) submit mutex held
+    static storage_request_t request;
+    
+    xSemaphoreTakeRecursive(storage_submit_mutex, portMAX_DELAY);
+    memset(&request, 0, sizeof(request));
+    request.type = STORAGE_REQ_SAVE_BOOT_OPTIONS;
+    request.index = -1;
+    request.boot_options = app_state.boot_options;
+    bool queued = storage_submit(&request);
+    xSemaphoreGiveRecursive(storage_submit_mutex);
+    return queued;
+}
+
+/**
+ * Drain completion events from the storage worker (called from the UI task)
+ * 
+ * Successful writes are only logged. Failures are logged and, if the user is
+ * still on the config screen, shown in its title bar.
+ */
+static void storage_process_events(void)
+{
+    storage_event_t event;
+    
+    while (xQueueReceive(storage_event_queue, &event, 0) == pdTRUE) {
+        if (event.err == ESP_OK) {
+            ESP_LOGI(TAG, "Storage request #%lu complete (type %d, index %d)",
+                     event.seq, event.type, event.index);
+            continue;
+        }
+        
+        ESP_LOGE(TAG, "Storage request #%lu failed (type %d, index %d): %s",
+                 event.seq, event.type, event.index, esp_err_to_name(event.err));
+        
+        if (app_state.mode == MODE_CONFIG) {
+            char msg[32];
+            if (event.type == STORAGE_REQ_SAVE_MACRO) {
+                snprintf(msg, sizeof(msg), "Save M%d failed!", event.index + 1);
+            } else {
+                snprintf(msg, sizeof(msg), "Storage error!");
+            }
+            ili9341_fill_rect(0, 0, SCREEN_WIDTH, 30, COLOR_RED);
+            ili9341_draw_string(5, 10, msg, COLOR_WHITE, COLOR_RED, 1);
+        }
+    }
 }
 
 // =============================================================================
@@ -864,8 +2138,11 @@ static void ili9341_send_cmd(uint8_t cmd)
     t.length = 8;
     t.tx_buffer = &cmd;
     t.user = (void*)0; // D/C needs to be 0 for command
+    latency_note_spi();
     ret = spi_device_polling_transmit(display_spi, &t);
     ESP_ERROR_CHECK(ret);
+    perf_counters.spi_transactions++;
+    perf_counters.spi_bytes += 1;
 }
 
 /**
@@ -881,8 +2158,45 @@ static void ili9341_send_data(const uint8_t *data, int len)
     t.length = len * 8;
     t.tx_buffer = data;
     t.user = (void*)1; // D/C needs to be 1 for data
+    latency_note_spi();
     ret = spi_device_polling_transmit(display_spi, &t);
     ESP_ERROR_CHECK(ret);
+    perf_counters.spi_transactions++;
+    perf_counters.spi_bytes += len;
+}
+
+/**
+ * Take the display bus for one command or address window sequence
+ *
+ * Nests within a task. Before display_init() creates the mutex only the
+ * display init job draws, so there is nothing to arbitrate.
+ */
+static void display_bus_lock(void)
+{
+    if (display_bus_mutex == NULL) {
+        return;
+    }
+    // A nested take never fails here, so only other tasks count as contention
+    if (xSemaphoreTakeRecursive(display_bus_mutex, 0) != pdTRUE) {
+        int64_t start = esp_timer_get_time();
+        perf_counters.bus_contended++;
+        xSemaphoreTakeRecursive(display_bus_mutex, portMAX_DELAY);
+        perf_stat_record(&perf_counters.bus_wait_us, (uint32_t)(esp_timer_get_time() - start));
+    }
+    if (display_bus_depth++ == 0) {
+        perf_counters.bus_locks++;
+    }
+}
+
+/**
+ * Release one display_bus_lock()
+ */
+static void display_bus_unlock(void)
+{
+    if (display_bus_mutex != NULL) {
+        display_bus_depth--;
+        xSemaphoreGiveRecursive(display_bus_mutex);
+    }
 }
 
 /**
@@ -894,6 +2208,190 @@ static void ili9341_spi_pre_transfer_callback(spi_transaction_t *t)
     gpio_set_level(PIN_TFT_DC, dc);
 }
 
+/**
+ * Add the panel to the display bus as display_spi at clock_hz
+ */
+static void display_spi_add(int clock_hz)
+{
+    spi_device_interface_config_t devcfg = {
+        .clock_speed_hz = clock_hz,
+        .mode = 0,                            // SPI mode 0
+        .spics_io_num = PIN_TFT_CS,           // CS pin
+        .queue_size = 7,                      // Queue 7 transactions at a time
+        .pre_cb = ili9341_spi_pre_transfer_callback,  // Callback to handle D/C line
+    };
+    ESP_ERROR_CHECK(spi_bus_add_device(DISPLAY_SPI_HOST, &devcfg, &display_spi));
+}
+
+/**
+ * Read one parameter byte of a panel status command (e.g. ILI9341_RDDPM)
+ *
+ * The panel only reads reliably at a few MHz, so display_spi is re-added at
+ * LCD_READ_CLOCK_HZ for the read and back at LCD_WRITE_CLOCK_HZ afterwards.
+ * CS stays low between the command and the parameter byte. Nothing may be
+ * queued on display_spi when this is called.
+ *
+ * @return false if a transaction failed (value is then meaningless)
+ */
+static bool ili9341_read_status(uint8_t cmd, uint8_t *value)
+{
+    spi_transaction_t t_cmd;
+    spi_transaction_t t_read;
+    memset(&t_cmd, 0, sizeof(t_cmd));
+    memset(&t_read, 0, sizeof(t_read));
+    t_cmd.flags = SPI_TRANS_CS_KEEP_ACTIVE;
+    t_cmd.length = 8;
+    t_cmd.tx_buffer = &cmd;
+    t_cmd.user = (void*)0; // D/C needs to be 0 for command
+    t_read.flags = SPI_TRANS_USE_RXDATA;
+    t_read.length = 8;
+    t_read.rxlength = 8;
+    t_read.user = (void*)1;
+    
+    display_bus_lock();
+    ESP_ERROR_CHECK(spi_bus_remove_device(display_spi));
+    display_spi_add(LCD_READ_CLOCK_HZ);
+    
+    bool ok = false;
+    if (spi_device_acquire_bus(display_spi, portMAX_DELAY) == ESP_OK) {
+        ok = spi_device_polling_transmit(display_spi, &t_cmd) == ESP_OK &&
+             spi_device_polling_transmit(display_spi, &t_read) == ESP_OK;
+        spi_device_release_bus(display_spi);
+    }
+    
+    ESP_ERROR_CHECK(spi_bus_remove_device(display_spi));
+    display_spi_add(LCD_WRITE_CLOCK_HZ);
+    display_bus_unlock();
+    
+    *value = t_read.rx_data[0];
+    return ok;
+}
+
+// =============================================================================
+// PANEL INIT SEQUENCES
+// =============================================================================
+//
+// Init sequences are compact byte tables interpreted by lcd_run_init_sequence():
+//
+//     cmd, len [| LCD_INIT_DELAY], arg0 .. arg(len-1), [delay_ms]
+//
+// terminated by LCD_INIT_END. Any panel with a command/parameter SPI protocol
+// (ILI9341 variants, ST7789, ...) can share the same interpreter with its own
+// table. Tables live in DRAM so the SPI DMA can read the arguments in place.
+
+// ILI9341 on the QD-TFT2803 (reference: https://www.lcdwiki.com/2.8inch_ESP32-32E_Display)
+DRAM_ATTR static const uint8_t ili9341_init_sequence[] = {
+    ILI9341_SWRESET,  0 | LCD_INIT_DELAY, 150,
+    ILI9341_SLPOUT,   0 | LCD_INIT_DELAY, 150,
+    ILI9341_PWCTRA,   5, 0x39, 0x2C, 0x00, 0x34, 0x02,   // Power control A
+    ILI9341_PWCTRB,   3, 0x00, 0xC1, 0x30,               // Power control B
+    ILI9341_DTCTRA,   3, 0x85, 0x00, 0x78,               // Driver timing control A
+    ILI9341_DTCTRB,   2, 0x00, 0x00,                     // Driver timing control B
+    ILI9341_PWONSEQ,  4, 0x64, 0x03, 0x12, 0x81,         // Power on sequence control
+    ILI9341_PUMPCTR,  1, 0x20,                           // Pump ratio control
+    ILI9341_PWCTR1,   1, 0x23,                           // Power control 1
+    ILI9341_PWCTR2,   1, 0x10,                           // Power control 2
+    ILI9341_VMCTR1,   2, 0x3E, 0x28,                     // VCOM control 1
+    ILI9341_VMCTR2,   1, 0x86,                           // VCOM control 2
+    ILI9341_MADCTL,   1, 0x28,                           // Landscape, rotated 90 degrees clockwise
+    ILI9341_PIXFMT,   1, 0x55,                           // 16 bits/pixel (RGB565)
+    ILI9341_FRMCTR1,  2, 0x00, 0x18,                     // Frame rate control
+    ILI9341_DFUNCTR,  3, 0x08, 0x82, 0x27,               // Display function control
+    ILI9341_GAMMA3EN, 1, 0x00,                           // 3-gamma function disable
+    ILI9341_GAMMASET, 1, 0x01,                           // Gamma curve 1
+    ILI9341_GMCTRP1, 15, 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
+                         0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,
+    ILI9341_GMCTRN1, 15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
+                         0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,
+    ILI9341_DISPON,   0 | LCD_INIT_DELAY, 100,
+    LCD_INIT_END
+};
+
+/**
+ * Boot trace label for a delay after a standard MIPI DCS command
+ */
+static const char *lcd_delay_label(uint8_t cmd)
+{
+    switch (cmd) {
+        case ILI9341_SWRESET: return "display: SWRESET wait";
+        case ILI9341_SLPOUT:  return "display: SLPOUT wait";
+        case ILI9341_DISPON:  return "display: DISPON wait";
+        default:              return "display: init delay";
+    }
+}
+
+/**
+ * Execute a panel init sequence table
+ * 
+ * Command and argument transactions are queued back to back (up to
+ * LCD_INIT_QUEUE_SIZE in flight); the queue is only drained before a delay
+ * entry and at the end. Delays go through boot_delay_ms() so they show up in
+ * the boot trace.
+ */
+static void lcd_run_init_sequence(spi_device_handle_t dev, const uint8_t *seq, const char *name)
+{
+    static spi_transaction_t trans[LCD_INIT_QUEUE_SIZE];
+    int in_flight = 0;
+    int next = 0;
+    int commands = 0;
+    spi_transaction_t *done;
+    
+    int stage = boot_trace_begin("display: init sequence");
+    
+    while (*seq != LCD_INIT_END) {
+        uint8_t cmd = *seq++;
+        uint8_t flags = *seq++;
+        uint8_t len = flags & LCD_INIT_LEN_MASK;
+        
+        // Queue the command byte and, if present, its arguments
+        for (int phase = 0; phase < (len ? 2 : 1); phase++) {
+            if (in_flight == LCD_INIT_QUEUE_SIZE) {
+                ESP_ERROR_CHECK(spi_device_get_trans_result(dev, &done, portMAX_DELAY));
+                in_flight--;
+            }
+            
+            spi_transaction_t *t = &trans[next];
+            next = (next + 1) % LCD_INIT_QUEUE_SIZE;
+            memset(t, 0, sizeof(*t));
+            if (phase == 0) {
+                t->length = 8;
+                t->flags = SPI_TRANS_USE_TXDATA;
+                t->tx_data[0] = cmd;
+                t->user = (void*)0;   // D/C low: command
+            } else {
+                t->length = len * 8;
+                t->tx_buffer = seq;   // Arguments are sent straight from the table
+                t->user = (void*)1;   // D/C high: data
+            }
+            ESP_ERROR_CHECK(spi_device_queue_trans(dev, t, portMAX_DELAY));
+            in_flight++;
+            perf_counters.spi_transactions++;
+            perf_counters.spi_bytes += t->length / 8;
+        }
+        seq += len;
+        commands++;
+        
+        if (flags & LCD_INIT_DELAY) {
+            uint8_t delay_ms = *seq++;
+            
+            // The command must be on the wire before its wait starts
+            while (in_flight > 0) {
+                ESP_ERROR_CHECK(spi_device_get_trans_result(dev, &done, portMAX_DELAY));
+                in_flight--;
+            }
+            boot_delay_ms(delay_ms, lcd_delay_label(cmd));
+        }
+    }
+    
+    while (in_flight > 0) {
+        ESP_ERROR_CHECK(spi_device_get_trans_result(dev, &done, portMAX_DELAY));
+        in_flight--;
+    }
+    
+    boot_trace_end(stage);
+    ESP_LOGI(TAG, "Display: %s init sequence sent (%d commands)", name, commands);
+}
+
 /**
  * Reset the ILI9341 display
  */
@@ -904,13 +2402,13 @@ static void ili9341_reset(void)
     // Check if reset pin is configured (not -1)
     if (PIN_TFT_RST >= 0) {
         gpio_set_level(PIN_TFT_RST, 0);
-        vTaskDelay(pdMS_TO_TICKS(100));
+        boot_delay_ms(100, "display: RST low");
         gpio_set_level(PIN_TFT_RST, 1);
-        vTaskDelay(pdMS_TO_TICKS(100));
+        boot_delay_ms(100, "display: RST recovery");
         ESP_LOGI(TAG, "Display: Hardware reset complete");
     } else {
         ESP_LOGI(TAG, "Display: Skipping hardware reset (RST pin shared with ESP32 EN)");
-        vTaskDelay(pdMS_TO_TICKS(100));
+        boot_delay_ms(100, "display: reset settle");
     }
 }
 
@@ -951,171 +2449,64 @@ static void display_init(void)
     
     // Add SPI device for display
     ESP_LOGI(TAG, "Display: Adding SPI device...");
-    spi_device_interface_config_t devcfg = {
-        .clock_speed_hz = 26 * 1000 * 1000,  // 26 MHz
-        .mode = 0,                            // SPI mode 0
-        .spics_io_num = PIN_TFT_CS,           // CS pin
-        .queue_size = 7,                      // Queue 7 transactions at a time
-        .pre_cb = ili9341_spi_pre_transfer_callback,  // Callback to handle D/C line
-    };
-    esp_err_t ret = spi_bus_add_device(DISPLAY_SPI_HOST, &devcfg, &display_spi);
-    ESP_ERROR_CHECK(ret);
-    ESP_LOGI(TAG, "Display: SPI device added (CS: GPIO%d, Clock: 26MHz)", PIN_TFT_CS);
+    display_spi_add(LCD_WRITE_CLOCK_HZ);
+    ESP_LOGI(TAG, "Display: SPI device added (CS: GPIO%d, Clock: %dMHz)",
+             PIN_TFT_CS, LCD_WRITE_CLOCK_HZ / 1000000);
     
     // Hardware reset
     ili9341_reset();
     
-    // Software reset
-    ESP_LOGI(TAG, "Display: Sending software reset command (0x01)...");
-    ili9341_send_cmd(ILI9341_SWRESET);
-    vTaskDelay(pdMS_TO_TICKS(150));
-    ESP_LOGI(TAG, "Display: Software reset complete");
-    
-    // Sleep out
-    ESP_LOGI(TAG, "Display: Waking display from sleep (0x11)...");
-    ili9341_send_cmd(ILI9341_SLPOUT);
-    vTaskDelay(pdMS_TO_TICKS(150));
-    ESP_LOGI(TAG, "Display: Sleep mode exited");
-    
-    // Power control A
-    ESP_LOGI(TAG, "Display: Configuring power control...");
-    ili9341_send_cmd(0xCB);
-    uint8_t power_a[] = {0x39, 0x2C, 0x00, 0x34, 0x02};
-    ili9341_send_data(power_a, 5);
-    
-    // Power control B
-    ili9341_send_cmd(0xCF);
-    uint8_t power_b[] = {0x00, 0xC1, 0x30};
-    ili9341_send_data(power_b, 3);
-    
-    // Driver timing control A
-    ili9341_send_cmd(0xE8);
-    uint8_t timing_a[] = {0x85, 0x00, 0x78};
-    ili9341_send_data(timing_a, 3);
-    
-    // Driver timing control B
-    ili9341_send_cmd(0xEA);
-    uint8_t timing_b[] = {0x00, 0x00};
-    ili9341_send_data(timing_b, 2);
-    
-    // Power on sequence control
-    ili9341_send_cmd(0xED);
-    uint8_t power_seq[] = {0x64, 0x03, 0x12, 0x81};
-    ili9341_send_data(power_seq, 4);
-    
-    // Pump ratio control
-    ili9341_send_cmd(0xF7);
-    uint8_t pump[] = {0x20};
-    ili9341_send_data(pump, 1);
-    ESP_LOGI(TAG, "Display: Power control configured");
-    
-    // Power control 1
-    ESP_LOGI(TAG, "Display: Setting power levels...");
-    ili9341_send_cmd(ILI9341_PWCTR1);
-    uint8_t pwr1[] = {0x23};
-    ili9341_send_data(pwr1, 1);
-    
-    // Power control 2
-    ili9341_send_cmd(ILI9341_PWCTR2);
-    uint8_t pwr2[] = {0x10};
-    ili9341_send_data(pwr2, 1);
-    
-    // VCOM control 1
-    ili9341_send_cmd(ILI9341_VMCTR1);
-    uint8_t vcom1[] = {0x3e, 0x28};
-    ili9341_send_data(vcom1, 2);
-    
-    // VCOM control 2
-    ili9341_send_cmd(ILI9341_VMCTR2);
-    uint8_t vcom2[] = {0x86};
-    ili9341_send_data(vcom2, 1);
-    ESP_LOGI(TAG, "Display: Power levels set");
-    
-    // Memory access control (rotation/orientation)
-    ESP_LOGI(TAG, "Display: Setting orientation (landscape, 90 degrees clockwise)...");
-    ili9341_send_cmd(ILI9341_MADCTL);
-    uint8_t madctl[] = {0x28}; // Landscape mode, rotated 90 degrees clockwise
-    ili9341_send_data(madctl, 1);
-    ESP_LOGI(TAG, "Display: Orientation set to landscape mode (90 degrees clockwise)");
-    
-    // Pixel format
-    ESP_LOGI(TAG, "Display: Setting pixel format (RGB565)...");
-    ili9341_send_cmd(ILI9341_PIXFMT);
-    uint8_t pixfmt[] = {0x55}; // 16 bits/pixel
-    ili9341_send_data(pixfmt, 1);
-    ESP_LOGI(TAG, "Display: Pixel format set to RGB565 (16-bit color)");
-    
-    // Frame rate control
-    ESP_LOGI(TAG, "Display: Configuring frame rate...");
-    ili9341_send_cmd(ILI9341_FRMCTR1);
-    uint8_t frmctr[] = {0x00, 0x18};
-    ili9341_send_data(frmctr, 2);
-    
-    // Display function control
-    ili9341_send_cmd(ILI9341_DFUNCTR);
-    uint8_t dfunctr[] = {0x08, 0x82, 0x27};
-    ili9341_send_data(dfunctr, 3);
-    ESP_LOGI(TAG, "Display: Frame rate configured");
-    
-    // Gamma function disable
-    ESP_LOGI(TAG, "Display: Configuring gamma correction...");
-    ili9341_send_cmd(0xF2);
-    uint8_t gamma_dis[] = {0x00};
-    ili9341_send_data(gamma_dis, 1);
-    
-    // Gamma curve selected
-    ili9341_send_cmd(ILI9341_GAMMASET);
-    uint8_t gamma_curve[] = {0x01};
-    ili9341_send_data(gamma_curve, 1);
-    
-    // Positive gamma correction
-    ili9341_send_cmd(ILI9341_GMCTRP1);
-    uint8_t gmctrp1[] = {0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
-                         0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00};
-    ili9341_send_data(gmctrp1, 15);
-    
-    // Negative gamma correction
-    ili9341_send_cmd(ILI9341_GMCTRN1);
-    uint8_t gmctrn1[] = {0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
-                         0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F};
-    ili9341_send_data(gmctrn1, 15);
-    ESP_LOGI(TAG, "Display: Gamma correction configured");
-    
-    // Clear display to black
-    ESP_LOGI(TAG, "Display: Clearing screen to black...");
-    
-    // Set column address (0 to 319)
-    ili9341_send_cmd(ILI9341_CASET);
-    uint8_t caset[] = {0x00, 0x00, 0x01, 0x3F};
-    ili9341_send_data(caset, 4);
-    
-    // Set page address (0 to 239)
-    ili9341_send_cmd(ILI9341_PASET);
-    uint8_t paset[] = {0x00, 0x00, 0x00, 0xEF};
-    ili9341_send_data(paset, 4);
-    
-    // Write to RAM
-    ili9341_send_cmd(ILI9341_RAMWR);
-    
-    // Send black pixels (simplified - just first few to show it's working)
-    uint8_t black_pixel[] = {0x00, 0x00}; // Black in RGB565
-    for (int i = 0; i < 100; i++) {
-        ili9341_send_data(black_pixel, 2);
-    }
-    ESP_LOGI(TAG, "Display: Screen cleared");
+    // Register init sequence: power, gamma, orientation, pixel format, display on
+    lcd_run_init_sequence(display_spi, ili9341_init_sequence, "ILI9341");
     
-    // Display on
-    ESP_LOGI(TAG, "Display: Turning on display (0x29)...");
-    ili9341_send_cmd(ILI9341_DISPON);
-    vTaskDelay(pdMS_TO_TICKS(100));
-    ESP_LOGI(TAG, "Display: Display is now ON");
+    // Glyph cells are rendered on first use; this only sets up the bookkeeping
+    glyph_cache_init(&glyph_cache, font5x7, GLYPH_CACHE_BUDGET);
+    glyph_cache_mutex = xSemaphoreCreateMutexStatic(&glyph_cache_mutex_buf);
+    pixel_band_mutex = xSemaphoreCreateMutexStatic(&pixel_band_mutex_buf);
+    dl_init(&screen_lists[0], SCREEN_WIDTH, SCREEN_HEIGHT, font5x7, &font_sans15);
+    dl_init(&screen_lists[1], SCREEN_WIDTH, SCREEN_HEIGHT, font5x7, &font_sans15);
+    screen_list_mutex = xSemaphoreCreateMutexStatic(&screen_list_mutex_buf);
+    display_bus_mutex = xSemaphoreCreateRecursiveMutexStatic(&display_bus_mutex_buf);
     
     ESP_LOGI(TAG, "Display: ILI9341 initialization complete!");
     ESP_LOGI(TAG, "Display: Resolution: %dx%d pixels", SCREEN_WIDTH, SCREEN_HEIGHT);
     ESP_LOGI(TAG, "Display: Color depth: 16-bit (RGB565)");
     ESP_LOGI(TAG, "Display: Orientation: Landscape");
+}
+
+/**
+ * Boot job: run display_init() and publish BOOT_BIT_DISPLAY
+ */
+static void display_init_task(void *pvParameters)
+{
+    int stage = boot_trace_begin("display_init");
+    display_init();
+    boot_trace_end(stage);
+    
+    xEventGroupSetBits(boot_events, BOOT_BIT_DISPLAY);
+    vTaskDelete(NULL);
+}
+
+/**
+ * Touch IRQ (PENIRQ low) while the touch task waits for a touch
+ */
+static void IRAM_ATTR touch_irq_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
     
-    // Initialize touch controller
+    gpio_intr_disable(PIN_TOUCH_IRQ);       // Level-triggered: once per wait
+    xSemaphoreGiveFromISR(touch_wake_sem, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * Initialize the XPT2046 touch controller
+ * 
+ * Touch has its own HSPI bus, so this does not depend on display_init()
+ * and runs while the display task is still waiting out its reset delays.
+ */
+static void touch_init(void)
+{
     ESP_LOGI(TAG, "Touch: Initializing XPT2046 touch controller...");
     ESP_LOGI(TAG, "Touch: Using separate HSPI bus (MOSI:%d, MISO:%d, SCLK:%d)", 
              PIN_TOUCH_MOSI, PIN_TOUCH_MISO, PIN_TOUCH_SCLK);
@@ -1127,7 +2518,8 @@ static void display_init(void)
         .queue_size = 1,
         .flags = SPI_DEVICE_NO_DUMMY,
     };
-    ret = spi_bus_add_device(TOUCH_SPI_HOST, &touch_cfg, &touch_spi);
+    touch_bus_mutex = xSemaphoreCreateRecursiveMutexStatic(&touch_bus_mutex_buf);
+    esp_err_t ret = spi_bus_add_device(TOUCH_SPI_HOST, &touch_cfg, &touch_spi);
     ESP_ERROR_CHECK(ret);
     ESP_LOGI(TAG, "Touch: XPT2046 initialized (CS: GPIO%d, IRQ: GPIO%d, Clock: 2MHz)", 
              PIN_TOUCH_CS, PIN_TOUCH_IRQ);
@@ -1138,10 +2530,17 @@ static void display_init(void)
         .mode = GPIO_MODE_INPUT,
         .pull_up_en = GPIO_PULLUP_ENABLE,  // XPT2046 IRQ is active low
         .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type = GPIO_INTR_DISABLE  // Not using interrupts yet, just polling
+        .intr_type = GPIO_INTR_LOW_LEVEL    // Wakes the touch task (and the display)
     };
     gpio_config(&touch_irq_conf);
-    ESP_LOGI(TAG, "Touch: IRQ pin configured for polling");
+    
+    // Touches are polled while a finger is down; the interrupt is only
+    // enabled while the touch task waits for one (SPI reads toggle PENIRQ)
+    touch_wake_sem = xSemaphoreCreateBinaryStatic(&touch_wake_sem_buf);
+    ESP_ERROR_CHECK(gpio_install_isr_service(0));
+    gpio_intr_disable(PIN_TOUCH_IRQ);
+    ESP_ERROR_CHECK(gpio_isr_handler_add(PIN_TOUCH_IRQ, touch_irq_isr, NULL));
+    ESP_LOGI(TAG, "Touch: IRQ pin configured to wake the touch task");
 }
 
 /**
@@ -1149,6 +2548,8 @@ static void display_init(void)
  */
 static void ili9341_set_addr_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
+    screen_invalidate();    // Pixels are about to change outside the display list
+    
     // Column address set
     ili9341_send_cmd(ILI9341_CASET);
     uint8_t caset[] = {
@@ -1178,10 +2579,16 @@ static void ili9341_set_addr_window(uint16_t x0, uint16_t y0, uint16_t x1, uint1
  */
 static void ili9341_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
 {
+    if (screen_capturing(0)) {
+        dl_fill(screen_list, x, y, w, h, color);
+        return;
+    }
+    
     if (x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT) return;
     if (x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
     if (y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
     
+    display_bus_lock();
     ili9341_set_addr_window(x, y, x + w - 1, y + h - 1);
     
     // Prepare color bytes (RGB565 is big-endian)
@@ -1191,20 +2598,21 @@ static void ili9341_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, ui
     // Send color data for each pixel
     // For efficiency, we'll send in chunks
     uint32_t total_pixels = (uint32_t)w * h;
-    uint8_t buffer[512]; // Send 256 pixels at a time
     
-    // Fill buffer with color pattern
-    for (int i = 0; i < 512; i += 2) {
-        buffer[i] = color_high;
-        buffer[i + 1] = color_low;
+    // Static run (DMA-capable, off the caller's stack); the bus lock keeps
+    // another task from recoloring it mid-fill
+    for (int i = 0; i < FILL_CHUNK_PIXELS * 2; i += 2) {
+        fill_buffer[i] = color_high;
+        fill_buffer[i + 1] = color_low;
     }
     
     // Send data in chunks
     while (total_pixels > 0) {
-        uint32_t chunk_size = (total_pixels > 256) ? 256 : total_pixels;
-        ili9341_send_data(buffer, chunk_size * 2);
+        uint32_t chunk_size = (total_pixels > FILL_CHUNK_PIXELS) ? FILL_CHUNK_PIXELS : total_pixels;
+        ili9341_send_data(fill_buffer, chunk_size * 2);
         total_pixels -= chunk_size;
     }
+    display_bus_unlock();
 }
 
 /**
@@ -1216,18 +2624,90 @@ static void ili9341_fill_screen(uint16_t color)
 }
 
 /**
- * Draw a single character at position (x, y)
- * c: character to draw
- * color: foreground color (RGB565)
- * bg: background color (RGB565)
- * size: scaling factor (1 = 5x7 pixels, 2 = 10x14 pixels, etc.)
+ * Define the hardware scroll area
+ *
+ * The ILI9341 "vertical" scroll runs along the panel's 320-line axis, which is
+ * horizontal in this landscape orientation (MADCTL MV). The three widths are
+ * landscape columns from left to right and must add up to SCREEN_WIDTH.
  */
-static void ili9341_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg, uint8_t size)
+static void ili9341_set_scroll_area(uint16_t fixed_left, uint16_t scroll_width, uint16_t fixed_right)
 {
-    if (c < 32 || c > 126) {
-        c = ' '; // Replace unsupported characters with space
-    }
-    
+    uint8_t args[] = {
+        (uint8_t)(fixed_left >> 8), (uint8_t)(fixed_left & 0xFF),
+        (uint8_t)(scroll_width >> 8), (uint8_t)(scroll_width & 0xFF),
+        (uint8_t)(fixed_right >> 8), (uint8_t)(fixed_right & 0xFF)
+    };
+    display_bus_lock();
+    ili9341_send_cmd(ILI9341_VSCRDEF);
+    ili9341_send_data(args, sizeof(args));
+    display_bus_unlock();
+}
+
+/**
+ * Set the frame memory column shown at the left edge of the scroll area
+ */
+static void ili9341_set_scroll_start(uint16_t column)
+{
+    screen_invalidate();    // The panel no longer shows frame memory as the list drew it
+    
+    uint8_t args[] = { (uint8_t)(column >> 8), (uint8_t)(column & 0xFF) };
+    display_bus_lock();
+    ili9341_send_cmd(ILI9341_VSCRSADD);
+    ili9341_send_data(args, sizeof(args));
+    display_bus_unlock();
+}
+
+/**
+ * Leave scroll mode: frame memory is shown unshifted again
+ */
+static void ili9341_reset_scroll(void)
+{
+    display_bus_lock();
+    ili9341_set_scroll_area(0, SCREEN_WIDTH, 0);
+    ili9341_set_scroll_start(0);
+    ili9341_send_cmd(ILI9341_NORON);
+    display_bus_unlock();
+}
+
+/**
+ * Draw a single character at position (x, y)
+ * c: character to draw
+ * color: foreground color (RGB565)
+ * bg: background color (RGB565)
+ * size: scaling factor (1 = 5x7 pixels, 2 = 10x14 pixels, etc.)
+ */
+static void ili9341_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg, uint8_t size)
+{
+    if (c < 32 || c > 126) {
+        c = ' '; // Replace unsupported characters with space
+    }
+    
+    if (screen_capturing(1)) {
+        char str[2] = { c, '\0' };
+        dl_text(screen_list, x, y, str, color, bg, size);
+        return;
+    }
+    
+    // Opaque text that fits on screen is sent from the glyph cache as one
+    // address window plus one data burst. Transparent text (bg == color) and
+    // clipped characters use the per-pixel path below.
+    uint16_t cell_w = GLYPH_CELL_WIDTH(size);
+    uint16_t cell_h = GLYPH_CELL_HEIGHT(size);
+    if (bg != color && glyph_cache_mutex != NULL &&
+        x + cell_w <= SCREEN_WIDTH && y + cell_h <= SCREEN_HEIGHT) {
+        xSemaphoreTake(glyph_cache_mutex, portMAX_DELAY);
+        const uint16_t *cell = glyph_cache_get(&glyph_cache, c, color, bg, size);
+        if (cell != NULL) {
+            display_bus_lock();
+            ili9341_set_addr_window(x, y, x + cell_w - 1, y + cell_h - 1);
+            ili9341_send_data((const uint8_t *)cell, cell_w * cell_h * 2);
+            display_bus_unlock();
+            xSemaphoreGive(glyph_cache_mutex);
+            return;
+        }
+        xSemaphoreGive(glyph_cache_mutex);
+    }
+    
     // Get character from font table (offset by 32 for space)
     const uint8_t* glyph = font5x7[c - 32];
     
@@ -1274,6 +2754,11 @@ static void ili9341_draw_string(uint16_t x, uint16_t y, const char* str, uint16_
 {
     if (!str) return;
     
+    if (screen_capturing(strlen(str))) {
+        dl_text(screen_list, x, y, str, color, bg, size);
+        return;
+    }
+    
     uint16_t cursor_x = x;
     uint16_t cursor_y = y;
     
@@ -1305,6 +2790,120 @@ static void ili9341_draw_string(uint16_t x, uint16_t y, const char* str, uint16_
     }
 }
 
+/**
+ * Draw the first len characters of text in the anti-aliased proportional font
+ * x, y: top-left of the text line (the box is text width x font line height)
+ * color: foreground color (RGB565)
+ * bg: background color (RGB565), blended with the glyph edges
+ */
+static void ili9341_draw_text_aa(uint16_t x, uint16_t y, const char* text, int len, uint16_t color, uint16_t bg)
+{
+    const aa_font_t *font = &font_sans15;
+    
+    if (!text || len <= 0 || x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT) return;
+    
+    if (screen_capturing(len)) {
+        dl_text_aa(screen_list, x, y, text, len, color);
+        return;
+    }
+    
+    // Measure the box from the advance table only
+    uint32_t width = aa_font_text_width_n(font, text, len);
+    if (x + width > SCREEN_WIDTH) width = SCREEN_WIDTH - x;
+    uint16_t height = font->line_height;
+    if (y + height > SCREEN_HEIGHT) height = SCREEN_HEIGHT - y;
+    if (width == 0) return;
+    
+    if (pixel_band_mutex == NULL) {
+        return;     // Display not initialized
+    }
+    
+    // Compose as many whole rows as fit in the band, then send them as one burst
+    uint16_t bg_be = (uint16_t)((bg << 8) | (bg >> 8));
+    uint16_t band_rows = PIXEL_BAND_PIXELS / width;
+    
+    xSemaphoreTake(pixel_band_mutex, portMAX_DELAY);
+    for (uint16_t row = 0; row < height; row += band_rows) {
+        uint16_t rows = (height - row < band_rows) ? height - row : band_rows;
+        uint32_t pixels = width * rows;
+        
+        for (uint32_t i = 0; i < pixels; i++) {
+            pixel_band[i] = bg_be;
+        }
+        aa_font_draw(font, text, len, color, pixel_band, width, rows, row, 0, 0);
+        
+        display_bus_lock();
+        ili9341_set_addr_window(x, y + row, x + width - 1, y + row + rows - 1);
+        ili9341_send_data((const uint8_t *)pixel_band, pixels * 2);
+        display_bus_unlock();
+    }
+    xSemaphoreGive(pixel_band_mutex);
+}
+
+/**
+ * Draw a compressed icon at (x, y); transparent pixels take the bg color
+ *
+ * The icon is decoded in chunks into the two halves of the pixel band: while
+ * one half is on the wire (queued DMA transaction) the next one is decoded.
+ * Icons must fit on screen (no clipping).
+ */
+static void ili9341_draw_icon(uint16_t x, uint16_t y, const icon_t *icon, uint16_t bg)
+{
+    static spi_transaction_t trans[2];
+    spi_transaction_t *done;
+    icon_decoder_t dec;
+    int in_flight = 0;
+    int next = 0;
+    
+    if (!icon || x + icon->width > SCREEN_WIDTH || y + icon->height > SCREEN_HEIGHT) return;
+    if (pixel_band_mutex == NULL) return;     // Display not initialized
+    
+    if (screen_capturing(0)) {
+        dl_icon(screen_list, x, y, icon, bg);
+        return;
+    }
+    
+    icon_decode_begin(&dec, icon, bg);
+    
+    xSemaphoreTake(pixel_band_mutex, portMAX_DELAY);
+    display_bus_lock();
+    ili9341_set_addr_window(x, y, x + icon->width - 1, y + icon->height - 1);
+    
+    for (;;) {
+        uint16_t *chunk = pixel_band + next * ICON_CHUNK_PIXELS;
+        
+        // Transactions complete in order: with both halves queued, the oldest is this one
+        if (in_flight == 2) {
+            ESP_ERROR_CHECK(spi_device_get_trans_result(display_spi, &done, portMAX_DELAY));
+            in_flight--;
+        }
+        
+        uint32_t pixels = icon_decode(&dec, chunk, ICON_CHUNK_PIXELS);
+        if (pixels == 0) {
+            break;
+        }
+        
+        spi_transaction_t *t = &trans[next];
+        memset(t, 0, sizeof(*t));
+        t->length = pixels * 16;
+        t->tx_buffer = chunk;
+        t->user = (void*)1;     // D/C high: data
+        latency_note_spi();
+        ESP_ERROR_CHECK(spi_device_queue_trans(display_spi, t, portMAX_DELAY));
+        in_flight++;
+        perf_counters.spi_transactions++;
+        perf_counters.spi_bytes += pixels * 2;
+        next ^= 1;
+    }
+    
+    while (in_flight > 0) {
+        ESP_ERROR_CHECK(spi_device_get_trans_result(display_spi, &done, portMAX_DELAY));
+        in_flight--;
+    }
+    display_bus_unlock();
+    xSemaphoreGive(pixel_band_mutex);
+}
+
 /**
  * Draw a simple button with a label
  */
@@ -1315,14 +2914,16 @@ static void ili9341_draw_button(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
     
     // Draw label text if provided
     if (label && label[0] != '\0') {
-        // Calculate text position (centered)
-        // Font is 5 pixels wide per character + 1 pixel spacing = 6 pixels per char
-        uint16_t text_width = strlen(label) * 6;
-        uint16_t text_height = 7; // Font height
+        // Calculate text position (centered) from the font's advance table;
+        // labels wider than the button are cut at the last whole character
+        uint16_t max_width = (w > 2 * TEXT_PADDING) ? w - 2 * TEXT_PADDING : w;
+        uint16_t text_width;
+        int text_len = aa_font_fit_chars(&font_sans15, label, max_width, &text_width);
+        uint16_t text_height = font_sans15.line_height;
         
         // Center text in button
-        uint16_t text_x = x + (w > text_width ? (w - text_width) / 2 : 2);
-        uint16_t text_y = y + (h > text_height ? (h - text_height) / 2 : 2);
+        uint16_t text_x = x + (w > text_width ? (w - text_width) / 2 : 0);
+        uint16_t text_y = y + (h > text_height ? (h - text_height) / 2 : 0);
         
         // Choose text color based on button color brightness
         // Simple heuristic: if button is dark, use white text; if bright, use black text
@@ -1332,7 +2933,224 @@ static void ili9341_draw_button(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
         }
         
         // Draw text
-        ili9341_draw_string(text_x, text_y, label, text_color, color, 1);
+        ili9341_draw_text_aa(text_x, text_y, label, text_len, text_color, color);
+    }
+}
+
+// =============================================================================
+// DISPLAY LIST (FULL-SCREEN REDRAWS)
+// =============================================================================
+//
+// Screen draw functions wrap their drawing in screen_begin() / screen_end().
+// In between, the ili9341_* primitives called from that task are recorded in
+// screen_list; screen_end() then sends the screen as bands (320 x 20 for a full
+// screen). Band N+1 is rasterized while band N is transferred by DMA, so a
+// redraw costs about max(rasterize, transfer) instead of their sum and the many
+// small per-primitive transactions become a few large ones.
+//
+// The list of the screen on the panel is kept. Screens are drawn from scratch
+// every time, but only the rectangles dl_diff() reports as different are sent:
+// selecting a macro repaints the two buttons that changed, an unchanged redraw
+// sends nothing. Anything drawn outside the list (preview scrolling, test
+// patterns, banners) goes through ili9341_set_addr_window(), which makes the
+// next screen a full one.
+
+/**
+ * Start recording a full-screen redraw; pixels nothing covers get clear_color
+ * Nested calls from the same task join the outer screen.
+ */
+static void screen_begin(uint16_t clear_color)
+{
+    if (screen_list_mutex == NULL) {
+        ili9341_fill_screen(clear_color);   // Display list not set up: draw immediately
+        return;
+    }
+    if (screen_list_owner == xTaskGetCurrentTaskHandle()) {
+        screen_list_depth++;
+        return;
+    }
+    
+    xSemaphoreTake(screen_list_mutex, portMAX_DELAY);
+    dl_clear(screen_list, clear_color);
+    screen_list_owner = xTaskGetCurrentTaskHandle();
+    screen_list_depth = 1;
+    screen_list_recording = true;
+    main_screen_shown = false;      // draw_main_screen() sets it again
+}
+
+/**
+ * Start recording a change to the screen on the panel
+ *
+ * The new screen is the shown one without the items inside the cut
+ * rectangles, plus whatever is drawn before screen_end(), so only the cut
+ * areas are rasterized and sent. Returns false (nothing started, the caller
+ * draws the whole screen) if the panel content is not known.
+ */
+static bool screen_begin_patch(const dl_rect_t *cut, int cut_count)
+{
+    if (screen_list_mutex == NULL || screen_list_owner == xTaskGetCurrentTaskHandle()) {
+        return false;
+    }
+    
+    xSemaphoreTake(screen_list_mutex, portMAX_DELAY);
+    if (!screen_shown_valid) {
+        xSemaphoreGive(screen_list_mutex);
+        return false;
+    }
+    dl_copy_except(screen_list, screen_shown, cut, cut_count);
+    screen_list_owner = xTaskGetCurrentTaskHandle();
+    screen_list_depth = 1;
+    screen_list_recording = true;
+    return true;
+}
+
+/**
+ * Finish the outermost screen_begin(): send the recorded screen
+ */
+static void screen_end(void)
+{
+    if (screen_list_mutex == NULL || screen_list_owner != xTaskGetCurrentTaskHandle()) {
+        return;
+    }
+    if (--screen_list_depth > 0) {
+        return;
+    }
+    
+    if (screen_list_recording) {
+        screen_list_recording = false;
+        screen_flush();
+    }
+    screen_list_owner = NULL;
+    xSemaphoreGive(screen_list_mutex);
+}
+
+/**
+ * Whether the calling task is recording a screen and the next primitive
+ * (with text_len bytes of text) should be appended to screen_list
+ *
+ * If the list is full, what was recorded so far is sent and the rest of the
+ * screen is drawn immediately, which keeps the painter's order.
+ */
+static bool screen_capturing(size_t text_len)
+{
+    if (!screen_list_recording || screen_list_owner != xTaskGetCurrentTaskHandle()) {
+        return false;
+    }
+    if (!dl_has_room(screen_list, text_len)) {
+        DLOGI(DISPLAY, "Display list full (%d items), drawing the rest directly", screen_list->count);
+        screen_list_recording = false;
+        screen_flush();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Send the damage between the panel and screen_list, then make it the shown screen
+ */
+static void screen_flush(void)
+{
+    dl_rect_t damage[DL_MAX_DAMAGE];
+    int count = 1;
+    uint32_t raster_cycles = 0;
+    perf_timer_t flush_timer;
+    int core = xPortGetCoreID();
+    
+    if (screen_shown_valid) {
+        count = dl_diff(screen_shown, screen_list, damage, DL_MAX_DAMAGE);
+    } else {
+        damage[0] = (dl_rect_t){ 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+    }
+    
+    if (count == 0) {
+        perf_counters.screens_unchanged++;
+    } else if (count == 1 && damage[0].w == SCREEN_WIDTH && damage[0].h == SCREEN_HEIGHT) {
+        perf_counters.screens_full++;
+    } else {
+        perf_counters.screens_partial++;
+    }
+    
+    perf_timer_start(&flush_timer);
+    screen_shown_valid = true;      // Cleared again if another task draws meanwhile
+    screen_flushing = true;
+    for (int i = 0; i < count; i++) {
+        DLOGD(DISPLAY, "Damage %ux%u at (%u,%u)", damage[i].w, damage[i].h, damage[i].x, damage[i].y);
+        screen_send_rect(&damage[i], &raster_cycles);
+        perf_counters.screen_pixels += (uint32_t)damage[i].w * damage[i].h;
+    }
+    screen_flushing = false;
+    
+    if (count > 0) {
+        perf_timer_stop(&flush_timer, &perf_counters.band_flush_us);
+        if (xPortGetCoreID() == core) {
+            perf_stat_record(&perf_counters.band_raster_us, raster_cycles / esp_rom_get_cpu_ticks_per_us());
+        }
+    }
+    
+    // The panel now shows screen_list; the old list is recycled for the next screen
+    display_list_t *shown = screen_list;
+    screen_list = screen_shown;
+    screen_shown = shown;
+    dl_clear(screen_list, shown->clear_color);
+}
+
+/**
+ * Rasterize one rectangle of screen_list in bands and send it, overlapping the two
+ */
+static void screen_send_rect(const dl_rect_t *rect, uint32_t *raster_cycles)
+{
+    static spi_transaction_t trans[2];
+    spi_transaction_t *done;
+    int in_flight = 0;
+    uint16_t band_rows = (SCREEN_WIDTH * RENDER_BAND_ROWS) / rect->w;   // Narrow areas get taller bands
+    
+    display_bus_lock();
+    ili9341_set_addr_window(rect->x, rect->y, rect->x + rect->w - 1, rect->y + rect->h - 1);
+    
+    for (uint16_t y = 0, band = 0; y < rect->h; y += band_rows, band ^= 1) {
+        uint16_t rows = (rect->h - y < band_rows) ? rect->h - y : band_rows;
+        dl_rect_t area = { rect->x, rect->y + y, rect->w, rows };
+        uint32_t bytes = (uint32_t)rect->w * rows * 2;
+        
+        // With both bands queued, the oldest transfer is the one using this buffer
+        if (in_flight == 2) {
+            ESP_ERROR_CHECK(spi_device_get_trans_result(display_spi, &done, portMAX_DELAY));
+            in_flight--;
+        }
+        
+        uint32_t start = esp_cpu_get_cycle_count();
+        dl_render_rect(screen_list, &area, render_bands[band]);
+        *raster_cycles += esp_cpu_get_cycle_count() - start;
+        
+        spi_transaction_t *t = &trans[band];
+        memset(t, 0, sizeof(*t));
+        t->length = bytes * 8;
+        t->tx_buffer = render_bands[band];
+        t->user = (void*)1;     // D/C high: data
+        latency_note_spi();
+        ESP_ERROR_CHECK(spi_device_queue_trans(display_spi, t, portMAX_DELAY));
+        in_flight++;
+        perf_counters.spi_transactions++;
+        perf_counters.spi_bytes += bytes;
+    }
+    
+    // The next rectangle's address window is sent with polling transactions
+    while (in_flight > 0) {
+        ESP_ERROR_CHECK(spi_device_get_trans_result(display_spi, &done, portMAX_DELAY));
+        in_flight--;
+    }
+    display_bus_unlock();
+}
+
+/**
+ * Forget what the panel shows: the next screen is sent in full
+ *
+ * Called for every pixel write that bypasses the display list.
+ */
+static void screen_invalidate(void)
+{
+    if (!screen_flushing || screen_list_owner != xTaskGetCurrentTaskHandle()) {
+        screen_shown_valid = false;
     }
 }
 
@@ -1341,60 +3159,78 @@ static void ili9341_draw_button(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
 // =============================================================================
 
 /**
- * Read raw value from XPT2046 touch controller
+ * Run count chained XPT2046 conversions in one overlapped transfer
+ * 
+ * 1 + 2 * count bytes instead of 3 per conversion; see xpt2046.h.
  */
-static uint16_t xpt2046_read(uint8_t command)
+static bool xpt2046_burst(const uint8_t *commands, int count, uint16_t *values)
 {
-    uint8_t tx_data[3] = {command, 0x00, 0x00};
-    uint8_t rx_data[3] = {0};
+    uint8_t tx_data[XPT2046_BURST_BYTES(XPT2046_BURST_MAX)];
+    uint8_t rx_data[XPT2046_BURST_BYTES(XPT2046_BURST_MAX)];
+    
+    if (count < 1 || count > XPT2046_BURST_MAX) {
+        return false;
+    }
     
     spi_transaction_t t;
     memset(&t, 0, sizeof(t));
-    t.length = 24;  // 3 bytes = 24 bits
+    t.length = xpt2046_burst_frame(commands, count, tx_data) * 8;
     t.tx_buffer = tx_data;
     t.rx_buffer = rx_data;
     
+    xSemaphoreTakeRecursive(touch_bus_mutex, portMAX_DELAY);
     esp_err_t ret = spi_device_polling_transmit(touch_spi, &t);
+    xSemaphoreGiveRecursive(touch_bus_mutex);
     if (ret != ESP_OK) {
-        return 0;
+        return false;
     }
     
-    // XPT2046 returns 12-bit value in bits [14:3] of the response
-    uint16_t value = ((uint16_t)rx_data[1] << 8) | rx_data[2];
-    value = (value >> 3) & 0xFFF;
-    
-    return value;
+    xpt2046_burst_decode(rx_data, count, values);
+    return true;
+}
+
+/**
+ * Read raw value from XPT2046 touch controller
+ */
+static uint16_t xpt2046_read(uint8_t command)
+{
+    uint16_t value;
+    return xpt2046_burst(&command, 1, &value) ? value : 0;
 }
 
+_Static_assert(1 + 2 * TOUCH_BURST_SAMPLES <= XPT2046_BURST_MAX,
+               "TOUCH_BURST_SAMPLES does not fit one XPT2046 burst");
+
 /**
  * Read touch coordinates from XPT2046
  * Returns true if touch is detected and coordinates are valid
+ * 
+ * Pressure and TOUCH_BURST_SAMPLES conversions of each axis come back from a
+ * single transfer; the samples of each axis are filtered together.
  */
 static bool read_touch_coordinates(uint16_t *x, uint16_t *y)
 {
-    // XPT2046 commands:
-    // 0xD0 = Read X position (12-bit, differential mode, power down between conversions)
-    // 0x90 = Read Y position (12-bit, differential mode, power down between conversions)
-    // 0xB0 = Read Z1 position (pressure indicator)
-    
-    // First check if screen is being touched by reading pressure
-    uint16_t z1 = xpt2046_read(0xB1);
+    uint8_t commands[1 + 2 * TOUCH_BURST_SAMPLES];
+    uint16_t values[1 + 2 * TOUCH_BURST_SAMPLES];
+    int count = xpt2046_touch_commands(TOUCH_BURST_SAMPLES, commands);
+    
+    perf_timer_t timer;
+    perf_timer_start(&timer);
+    bool ok = xpt2046_burst(commands, count, values);
+    perf_timer_stop(&timer, &perf_counters.touch_read_us);
+    perf_counters.touch_samples++;
+    if (ok) {
+        perf_counters.touch_conversions += count;
+    }
     
     // If pressure is too low, no valid touch
-    if (z1 < 100) {
+    if (!ok || values[0] < TOUCH_PRESSURE_MIN) {
+        perf_counters.touch_rejected++;
         return false;
     }
     
-    // Read X and Y coordinates
-    // We read twice and average to reduce noise
-    uint16_t x1 = xpt2046_read(0xD0);
-    uint16_t x2 = xpt2046_read(0xD0);
-    uint16_t y1 = xpt2046_read(0x90);
-    uint16_t y2 = xpt2046_read(0x90);
-    
-    // Average the readings
-    *x = (x1 + x2) / 2;
-    *y = (y1 + y2) / 2;
+    *x = xpt2046_filter(&values[1], TOUCH_BURST_SAMPLES);
+    *y = xpt2046_filter(&values[1 + TOUCH_BURST_SAMPLES], TOUCH_BURST_SAMPLES);
     
     return true;
 }
@@ -1406,11 +3242,253 @@ static bool read_touch_coordinates(uint16_t *x, uint16_t *y)
 static bool check_touch_pressed(void)
 {
     // Read Z1 position (pressure indicator)
-    uint16_t z1 = xpt2046_read(0xB1);
+    uint16_t z1 = xpt2046_read(XPT2046_CMD_Z1);
     
     // If Z1 is above a threshold, touch is detected
     // Typical threshold is around 100-200 for touch detection
-    return (z1 > 100);
+    return (z1 > TOUCH_PRESSURE_MIN);
+}
+
+// =============================================================================
+// BACKLIGHT AND DISPLAY SLEEP
+// =============================================================================
+//
+// The backlight is the largest consumer on a battery. After IDLE_DIM_MS
+// without a touch the backlight fades to BACKLIGHT_DIM; after IDLE_SLEEP_MS
+// it fades out and the panel goes to sleep (DISPOFF, SLPIN). The ILI9341
+// keeps its frame memory in sleep, so a touch wakes it (SLPOUT, DISPON) with
+// the same picture and no redraw. The waking touch is not passed on to the UI.
+
+/**
+ * Drive the backlight from LEDC PWM at full brightness
+ */
+static void backlight_init(void)
+{
+    ledc_timer_config_t timer_cfg = {
+        .speed_mode = BACKLIGHT_LEDC_MODE,
+        .duty_resolution = LEDC_TIMER_8_BIT,
+        .timer_num = BACKLIGHT_LEDC_TIMER,
+        .freq_hz = BACKLIGHT_PWM_HZ,
+        .clk_cfg = LEDC_AUTO_CLK,
+    };
+    ESP_ERROR_CHECK(ledc_timer_config(&timer_cfg));
+    
+    ledc_channel_config_t channel_cfg = {
+        .gpio_num = PIN_BACKLIGHT,
+        .speed_mode = BACKLIGHT_LEDC_MODE,
+        .channel = BACKLIGHT_LEDC_CHANNEL,
+        .intr_type = LEDC_INTR_DISABLE,
+        .timer_sel = BACKLIGHT_LEDC_TIMER,
+        .duty = BACKLIGHT_FULL,
+        .hpoint = 0,
+    };
+    ESP_ERROR_CHECK(ledc_channel_config(&channel_cfg));
+    ESP_ERROR_CHECK(ledc_fade_func_install(0));
+}
+
+/**
+ * Set the backlight duty (0..BACKLIGHT_FULL), immediately or as a fade
+ */
+static void backlight_set(uint32_t duty, uint32_t fade_ms)
+{
+    if (fade_ms > 0) {
+        ledc_set_fade_time_and_start(BACKLIGHT_LEDC_MODE, BACKLIGHT_LEDC_CHANNEL, duty, fade_ms, LEDC_FADE_NO_WAIT);
+    } else {
+        ledc_set_duty_and_update(BACKLIGHT_LEDC_MODE, BACKLIGHT_LEDC_CHANNEL, duty, 0);
+    }
+}
+
+/**
+ * Send one panel power command between other tasks' screen flushes
+ */
+static void display_power_cmd(uint8_t cmd)
+{
+    if (screen_list_mutex != NULL) {
+        xSemaphoreTake(screen_list_mutex, portMAX_DELAY);
+    }
+    display_bus_lock();
+    ili9341_send_cmd(cmd);
+    display_bus_unlock();
+    if (screen_list_mutex != NULL) {
+        xSemaphoreGive(screen_list_mutex);
+    }
+}
+
+/**
+ * Apply the idle policy (touch task, every poll without a touch)
+ */
+static void display_power_idle(uint32_t now_ms)
+{
+    uint32_t idle = now_ms - display_activity_ms;
+    
+    if (display_power == DISPLAY_ON && idle >= IDLE_DIM_MS) {
+        DLOGI(TOUCH, "Idle %lu ms - dimming backlight", idle);
+        backlight_set(BACKLIGHT_DIM, BACKLIGHT_FADE_MS);
+        display_power = DISPLAY_DIMMED;
+        power_enter(POWER_DIMMED);
+    } else if (display_power == DISPLAY_DIMMED && idle >= IDLE_SLEEP_MS &&
+               now_ms - display_wake_ms >= PANEL_SLEEP_MIN_MS) {
+        DLOGI(TOUCH, "Idle %lu ms - display sleep", idle);
+        backlight_set(0, BACKLIGHT_FADE_MS);
+        vTaskDelay(pdMS_TO_TICKS(BACKLIGHT_FADE_MS));
+        display_power_cmd(ILI9341_DISPOFF);
+        display_power_cmd(ILI9341_SLPIN);
+        display_power = DISPLAY_ASLEEP;
+        power_enter(POWER_ASLEEP);
+    }
+}
+
+/**
+ * A touch: restore full brightness if the backlight was dimmed
+ */
+static void display_power_activity(uint32_t now_ms)
+{
+    display_activity_ms = now_ms;
+    if (display_power == DISPLAY_DIMMED) {
+        backlight_set(BACKLIGHT_FULL, 0);
+        display_power = DISPLAY_ON;
+        power_enter(POWER_ACTIVE);
+    }
+}
+
+/**
+ * Block until the touch IRQ fires, then wake the panel with its last frame
+ *
+ * Returns once the waking finger has lifted, so it does not press anything.
+ */
+static void display_sleep_until_touch(void)
+{
+    uint16_t x, y;
+    
+    touch_wait_irq(UINT32_MAX);
+    
+    int64_t start_us = esp_timer_get_time();
+    display_power_cmd(ILI9341_SLPOUT);
+    vTaskDelay(pdMS_TO_TICKS(PANEL_SLPOUT_MS));
+    display_power_cmd(ILI9341_DISPON);
+    backlight_set(BACKLIGHT_FULL, 0);
+    display_power = DISPLAY_ON;
+    power_enter(POWER_ACTIVE);
+    display_wake_ms = display_activity_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    DLOGI(TOUCH, "Display woken by touch in %lu us", (uint32_t)(esp_timer_get_time() - start_us));
+    
+    while (read_touch_coordinates(&x, &y)) {
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+}
+
+/**
+ * Milliseconds until the idle policy has something to do (UINT32_MAX: nothing)
+ */
+static uint32_t display_power_next_ms(uint32_t now_ms)
+{
+    uint32_t idle = now_ms - display_activity_ms;
+    uint32_t deadline;
+    
+    switch (display_power) {
+        case DISPLAY_ON:     deadline = IDLE_DIM_MS; break;
+        case DISPLAY_DIMMED: deadline = IDLE_SLEEP_MS; break;
+        default:             return UINT32_MAX;
+    }
+    return (idle < deadline) ? deadline - idle : 0;
+}
+
+/**
+ * Block until the panel is touched (PENIRQ low) or timeout_ms passes
+ * (UINT32_MAX: no timeout). Returns true on a touch.
+ *
+ * Level-triggered, so a finger already down when this is called counts.
+ */
+static bool touch_wait_irq(uint32_t timeout_ms)
+{
+    xSemaphoreTake(touch_wake_sem, 0);      // Drop a stale wake
+    gpio_intr_enable(PIN_TOUCH_IRQ);
+    bool touched = xSemaphoreTake(touch_wake_sem,
+                                  timeout_ms == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+    gpio_intr_disable(PIN_TOUCH_IRQ);       // The ISR disables it too; this covers the timeout
+    return touched;
+}
+
+// =============================================================================
+// POWER MANAGEMENT
+// =============================================================================
+//
+// With CONFIG_PM_ENABLE and tickless idle, the CPU enters light sleep
+// whenever every task is blocked. No task wakes periodically: the touch task
+// waits on the touch IRQ (or the next backlight step) unless a finger is
+// down, and the UI task waits on a notification or the selection timeout.
+// The touch IRQ pin is a light-sleep wake source. While a touch is being
+// handled, touch_pm_lock keeps the CPU at full clock so redraws are not
+// slowed down. BLE wakes the CPU through the controller's own sleep clock;
+// on ESP32 that needs the external 32 kHz crystal
+// (CONFIG_BTDM_CTRL_LPCLK_SEL_EXT_32K_XTAL), otherwise the controller keeps
+// the CPU awake while a connection is up.
+
+/**
+ * Configure automatic light sleep and start the residency counter
+ */
+static void power_init(void)
+{
+    power_residency_reset(&power_residency, POWER_ACTIVE, esp_timer_get_time());
+    
+#ifdef CONFIG_PM_ENABLE
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = PM_MIN_FREQ_MHZ,
+        .light_sleep_enable = true,
+    };
+    esp_err_t ret = esp_pm_configure(&pm_config);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Power: light sleep not available (%s)", esp_err_to_name(ret));
+    }
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "touch", &touch_pm_lock));
+    
+    // Touch IRQ is active low; it wakes the CPU from light sleep
+    ESP_ERROR_CHECK(gpio_wakeup_enable(PIN_TOUCH_IRQ, GPIO_INTR_LOW_LEVEL));
+    ESP_ERROR_CHECK(esp_sleep_enable_gpio_wakeup());
+    ESP_LOGI(TAG, "Power: automatic light sleep enabled (%d-%d MHz, wake on touch IRQ GPIO%d)",
+             PM_MIN_FREQ_MHZ, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, PIN_TOUCH_IRQ);
+#else
+    ESP_LOGI(TAG, "Power: CONFIG_PM_ENABLE not set, CPU stays awake between touches");
+#endif
+}
+
+/**
+ * Record a power state change for the residency counter
+ */
+static void power_enter(power_state_t state)
+{
+    uint64_t now = esp_timer_get_time();
+    
+    portENTER_CRITICAL(&power_lock);
+    power_residency_enter(&power_residency, state, now);
+    portEXIT_CRITICAL(&power_lock);
+}
+
+/**
+ * End a power_enter(POWER_HID): back to the display state the counter kept
+ */
+static void power_leave_hid(void)
+{
+    uint64_t now = esp_timer_get_time();
+    
+    portENTER_CRITICAL(&power_lock);
+    power_residency_leave_hid(&power_residency, now);
+    portEXIT_CRITICAL(&power_lock);
+}
+
+/**
+ * Keep the CPU at full clock and out of light sleep while a touch is handled
+ */
+static void power_hold_cpu(bool hold)
+{
+#ifdef CONFIG_PM_ENABLE
+    if (hold) {
+        esp_pm_lock_acquire(touch_pm_lock);
+    } else {
+        esp_pm_lock_release(touch_pm_lock);
+    }
+#endif
 }
 
 // =============================================================================
@@ -1429,9 +3507,10 @@ static bool check_touch_pressed(void)
  * - Checkerboard pattern
  * - Gradient patterns
  * 
- * The test runs continuously until the touchscreen is pressed.
+ * The test runs until the touchscreen is pressed, or until max_cycles full
+ * cycles have completed (max_cycles = 0 means run until touched).
  */
-static void run_display_test(void)
+static void run_display_test(int max_cycles)
 {
     ESP_LOGI(TAG, "========================================");
     ESP_LOGI(TAG, "Starting Display Test Sequence");
@@ -1573,33 +3652,144 @@ static void run_display_test(void)
         if (check_touch_pressed()) {
             test_running = false;
             break;
-        }
+        }
+        
+        // Test 8: Center cross pattern
+        ESP_LOGI(TAG, "Test 8: Center cross pattern");
+        ili9341_fill_screen(COLOR_BLACK);
+        ili9341_fill_rect(SCREEN_WIDTH / 2 - 5, 0, 10, SCREEN_HEIGHT, COLOR_WHITE); // Vertical
+        ili9341_fill_rect(0, SCREEN_HEIGHT / 2 - 5, SCREEN_WIDTH, 10, COLOR_WHITE); // Horizontal
+        vTaskDelay(pdMS_TO_TICKS(2000));
+        if (check_touch_pressed()) {
+            test_running = false;
+            break;
+        }
+        
+        // Unattended runs stop after a fixed number of cycles
+        if (max_cycles > 0 && test_cycle >= max_cycles) {
+            ESP_LOGI(TAG, "Completed %d test cycle(s) without touch", test_cycle);
+            break;
+        }
+    }
+    
+    ESP_LOGI(TAG, "========================================");
+    ESP_LOGI(TAG, "Display Test Complete");
+    ESP_LOGI(TAG, "Starting normal operation...");
+    ESP_LOGI(TAG, "========================================");
+    
+    // Wait for touch release
+    while (check_touch_pressed()) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    vTaskDelay(pdMS_TO_TICKS(200)); // Debounce delay
+    
+    // Clear screen before transitioning to normal mode
+    ili9341_fill_screen(COLOR_BLACK);
+}
+
+/**
+ * Quick non-interactive display check
+ * 
+ * Draws a single frame of colour bars (every primary/secondary channel plus
+ * white and black) and reads back the panel power mode (RDDPM): the panel
+ * must answer and report sleep out + display on. The bars stay visible for
+ * SELFTEST_QUICK_HOLD_MS so a dead colour channel, which the readback cannot
+ * see, is still obvious at a glance.
+ *
+ * @return false (and logs the failure) if the panel did not pass
+ */
+static bool run_display_quick_test(void)
+{
+    static const uint16_t bar_colors[] = {COLOR_RED, COLOR_GREEN, COLOR_BLUE,
+                                          COLOR_YELLOW, COLOR_CYAN, COLOR_MAGENTA,
+                                          COLOR_WHITE, COLOR_BLACK};
+    const int bar_width = SCREEN_WIDTH / 8;
+    
+    ESP_LOGI(TAG, "Running quick display check (one frame)");
+    for (int i = 0; i < 8; i++) {
+        ili9341_fill_rect(i * bar_width, 0, bar_width, SCREEN_HEIGHT, bar_colors[i]);
+    }
+    
+    uint8_t power_mode = 0;
+    bool read_ok = ili9341_read_status(ILI9341_RDDPM, &power_mode);
+    vTaskDelay(pdMS_TO_TICKS(SELFTEST_QUICK_HOLD_MS));
+    
+    const uint8_t expected = LCD_DPM_SLEEP_OUT | LCD_DPM_DISPLAY_ON;
+    if (!read_ok) {
+        ESP_LOGE(TAG, "Self-test FAILED: display status read did not complete");
+        return false;
+    }
+    if ((power_mode & expected) != expected) {
+        // 0x00/0xFF is what a floating or unconnected MISO line reads as
+        ESP_LOGE(TAG, "Self-test FAILED: display power mode 0x%02X, expected sleep out + display on%s",
+                 power_mode, (power_mode == 0x00 || power_mode == 0xFF) ? " (no reply on MISO?)" : "");
+        return false;
+    }
+    ESP_LOGI(TAG, "Quick display check passed (power mode 0x%02X)", power_mode);
+    return true;
+}
+
+/**
+ * Run the startup self-test according to the persisted boot option
+ * 
+ * - SELFTEST_ALWAYS:     full interactive test, runs until touched
+ * - SELFTEST_FIRST_BOOT: full test (bounded to SELFTEST_FIRST_BOOT_CYCLES) the
+ *                        first time a new firmware image boots, quick check after
+ * - SELFTEST_NEVER:      nothing
+ */
+static void run_startup_selftest(void)
+{
+    const esp_app_desc_t *app_desc = esp_app_get_description();
+    bool new_firmware = memcmp(app_state.boot_options.tested_fw_sha256, app_desc->app_elf_sha256,
+                               sizeof(app_state.boot_options.tested_fw_sha256)) != 0;
+    
+    switch (app_state.boot_options.selftest_mode) {
+        case SELFTEST_ALWAYS:
+            ESP_LOGI(TAG, "Self-test mode: always - running display test sequence...");
+            run_display_test(0);
+            break;
         
-        // Test 8: Center cross pattern
-        ESP_LOGI(TAG, "Test 8: Center cross pattern");
-        ili9341_fill_screen(COLOR_BLACK);
-        ili9341_fill_rect(SCREEN_WIDTH / 2 - 5, 0, 10, SCREEN_HEIGHT, COLOR_WHITE); // Vertical
-        ili9341_fill_rect(0, SCREEN_HEIGHT / 2 - 5, SCREEN_WIDTH, 10, COLOR_WHITE); // Horizontal
-        vTaskDelay(pdMS_TO_TICKS(2000));
-        if (check_touch_pressed()) {
-            test_running = false;
+        case SELFTEST_FIRST_BOOT:
+            if (new_firmware) {
+                ESP_LOGI(TAG, "Self-test mode: first boot - new firmware, running display test sequence...");
+                run_display_test(SELFTEST_FIRST_BOOT_CYCLES);
+                
+                // Remember this image so later boots only run the quick check
+                memcpy(app_state.boot_options.tested_fw_sha256, app_desc->app_elf_sha256,
+                       sizeof(app_state.boot_options.tested_fw_sha256));
+                storage_submit_boot_options();
+            } else if (!run_display_quick_test()) {
+                ESP_LOGW(TAG, "Continuing boot with a display that failed the quick check");
+            }
+            break;
+        
+        case SELFTEST_NEVER:
+        default:
+            ESP_LOGI(TAG, "Self-test mode: never - skipping display test");
             break;
-        }
     }
+}
+
+/**
+ * Place the four macro buttons in their quadrants (M1 red top-left, M2 green
+ * top-right, M3 blue bottom-left, M4 yellow bottom-right)
+ *
+ * Touch detection reads these positions, so each screen lays the grid out
+ * before recording any drawing. Labels are left to the screen.
+ */
+static void layout_macro_buttons(uint16_t top, uint16_t bottom_row_y, uint16_t button_height)
+{
+    static const uint16_t colors[NUM_MACROS] = { COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_YELLOW };
+    const uint16_t button_width = (SCREEN_WIDTH - 3 * BUTTON_MARGIN) / 2;
     
-    ESP_LOGI(TAG, "========================================");
-    ESP_LOGI(TAG, "Display Test Complete - Touch detected!");
-    ESP_LOGI(TAG, "Starting normal operation...");
-    ESP_LOGI(TAG, "========================================");
-    
-    // Wait for touch release
-    while (check_touch_pressed()) {
-        vTaskDelay(pdMS_TO_TICKS(10));
+    for (int i = 0; i < NUM_MACROS; i++) {
+        button_t *button = &app_state.macro_buttons[i];
+        button->x = (i % 2 == 0) ? BUTTON_MARGIN : SCREEN_WIDTH / 2 + BUTTON_MARGIN / 2;
+        button->y = (i < 2) ? top : bottom_row_y;
+        button->width = button_width;
+        button->height = button_height;
+        button->color = colors[i];
     }
-    vTaskDelay(pdMS_TO_TICKS(200)); // Debounce delay
-    
-    // Clear screen before transitioning to normal mode
-    ili9341_fill_screen(COLOR_BLACK);
 }
 
 /**
@@ -1607,113 +3797,160 @@ static void run_display_test(void)
  */
 static void draw_main_screen(void)
 {
-    ESP_LOGI(TAG, "Display: Drawing main screen...");
-    ESP_LOGI(TAG, "Display: Main screen layout - 4 macro buttons + settings button");
-    ESP_LOGI(TAG, "Display: Version: %s", KEYBOT_VERSION);
+    perf_timer_t render_timer;
+    perf_timer_start(&render_timer);
     
-    // Clear screen to black background
-    ili9341_fill_screen(COLOR_BLACK);
+    DLOGI(DISPLAY, "Drawing main screen");
     
-    // Define button layout (2x2 grid of macro buttons)
-    // Screen is 320x240 in landscape mode
-    // Leave some margin around buttons
-    const uint16_t margin = BUTTON_MARGIN;
-    const uint16_t button_width = (SCREEN_WIDTH - 3 * margin) / 2;  // Two buttons horizontally
-    const uint16_t button_height = (SCREEN_HEIGHT - 3 * margin) / 2; // Two buttons vertically
-    
-    // Button positions (quadrant layout as described in requirements)
-    // Store positions in app_state for touch detection
-    
-    // Top-left: Red (M1) - macro 0
-    app_state.macro_buttons[0].x = margin;
-    app_state.macro_buttons[0].y = margin;
-    app_state.macro_buttons[0].width = button_width;
-    app_state.macro_buttons[0].height = button_height;
-    app_state.macro_buttons[0].color = COLOR_RED;
-    app_state.macro_buttons[0].label = "M1";
+    // Record the screen on a black background; screen_end() sends it in bands
+    screen_begin(COLOR_BLACK);
     
-    // Top-right: Green (M2) - macro 1
-    app_state.macro_buttons[1].x = SCREEN_WIDTH / 2 + margin / 2;
-    app_state.macro_buttons[1].y = margin;
-    app_state.macro_buttons[1].width = button_width;
-    app_state.macro_buttons[1].height = button_height;
-    app_state.macro_buttons[1].color = COLOR_GREEN;
+    // 2x2 grid of macro buttons filling the 320x240 landscape screen
+    const uint16_t button_height = (SCREEN_HEIGHT - 3 * BUTTON_MARGIN) / 2;
+    layout_macro_buttons(BUTTON_MARGIN, SCREEN_HEIGHT / 2 + BUTTON_MARGIN / 2, button_height);
+    app_state.macro_buttons[0].label = "M1";
     app_state.macro_buttons[1].label = "M2";
-    
-    // Bottom-left: Blue (M3) - macro 2
-    app_state.macro_buttons[2].x = margin;
-    app_state.macro_buttons[2].y = SCREEN_HEIGHT / 2 + margin / 2;
-    app_state.macro_buttons[2].width = button_width;
-    app_state.macro_buttons[2].height = button_height;
-    app_state.macro_buttons[2].color = COLOR_BLUE;
     app_state.macro_buttons[2].label = "M3";
-    
-    // Bottom-right: Yellow (M4) - macro 3
-    app_state.macro_buttons[3].x = SCREEN_WIDTH / 2 + margin / 2;
-    app_state.macro_buttons[3].y = SCREEN_HEIGHT / 2 + margin / 2;
-    app_state.macro_buttons[3].width = button_width;
-    app_state.macro_buttons[3].height = button_height;
-    app_state.macro_buttons[3].color = COLOR_YELLOW;
     app_state.macro_buttons[3].label = "M4";
     
-    // Draw the 4 macro buttons in their respective colors
     for (int i = 0; i < NUM_MACROS; i++) {
-        // Skip drawing if this button will be replaced by confirm button
-        if (app_state.selected_macro >= 0 && app_state.send_button_visible) {
-            // Determine which button is replaced by confirm
-            int replaced_idx = -1;
-            switch (app_state.selected_macro) {
-                case 0: replaced_idx = 3; break; // Top-left selected, bottom-right replaced
-                case 1: replaced_idx = 2; break; // Top-right selected, bottom-left replaced
-                case 2: replaced_idx = 1; break; // Bottom-left selected, top-right replaced
-                case 3: replaced_idx = 0; break; // Bottom-right selected, top-left replaced
-            }
-            
-            if (i == replaced_idx) {
-                continue; // Skip this button, will be drawn as confirm
-            }
-            
-            if (i == app_state.selected_macro) {
-                // Dim the selected button slightly by drawing a semi-transparent overlay effect
-                // For now, just draw it normally
-                ESP_LOGI(TAG, "Drawing button %d (selected) at (%d, %d)", i, 
-                        app_state.macro_buttons[i].x, app_state.macro_buttons[i].y);
-            }
-        }
-        
-        ESP_LOGI(TAG, "Drawing button %d (%s) at (%d, %d)", i, 
-                app_state.macro_buttons[i].label,
-                app_state.macro_buttons[i].x, app_state.macro_buttons[i].y);
-        ili9341_draw_button(app_state.macro_buttons[i].x, app_state.macro_buttons[i].y,
-                           app_state.macro_buttons[i].width, app_state.macro_buttons[i].height,
-                           app_state.macro_buttons[i].color, app_state.macro_buttons[i].label);
+        draw_main_quadrant(i);
     }
+    main_screen_shown = true;
     
-    // If a macro is selected, show confirm button in opposite quadrant
-    if (app_state.selected_macro >= 0 && app_state.send_button_visible) {
-        ESP_LOGI(TAG, "Drawing confirm button for selected macro %d", app_state.selected_macro);
-        
-        // Determine opposite quadrant for confirm button
-        int opposite_idx = -1;
-        switch (app_state.selected_macro) {
-            case 0: opposite_idx = 3; break; // Top-left selected, confirm in bottom-right
-            case 1: opposite_idx = 2; break; // Top-right selected, confirm in bottom-left
-            case 2: opposite_idx = 1; break; // Bottom-left selected, confirm in top-right
-            case 3: opposite_idx = 0; break; // Bottom-right selected, confirm in top-left
-        }
-        
-        // Use the opposite button's position for confirm button
-        app_state.confirm_button = app_state.macro_buttons[opposite_idx];
+    DLOGD(DISPLAY, "Main screen drawn");
+    
+    screen_end();
+    
+    perf_timer_stop(&render_timer, &perf_counters.render_us[MODE_PLAYBACK]);
+}
+
+/**
+ * Quadrant showing CONFIRM while macro selected is pending (-1 if none)
+ */
+static int confirm_quadrant(int selected)
+{
+    return (selected >= 0) ? NUM_MACROS - 1 - selected : -1;   // Diagonally opposite
+}
+
+/**
+ * Draw one quadrant of the main screen: its macro button, or CONFIRM while the
+ * diagonally opposite macro is selected. The selected button gets a white frame.
+ */
+static void draw_main_quadrant(int index)
+{
+    const button_t *button = &app_state.macro_buttons[index];
+    int selected = app_state.send_button_visible ? app_state.selected_macro : -1;
+    
+    if (index == confirm_quadrant(selected)) {
+        DLOGD(DISPLAY, "Drawing confirm button for selected macro %d", selected);
+        app_state.confirm_button = *button;
         app_state.confirm_button.color = COLOR_WHITE;
         app_state.confirm_button.label = "CONFIRM";
-        
-        // Draw confirm button
-        ili9341_draw_button(app_state.confirm_button.x, app_state.confirm_button.y,
-                           app_state.confirm_button.width, app_state.confirm_button.height,
-                           app_state.confirm_button.color, app_state.confirm_button.label);
+        ili9341_draw_button(button->x, button->y, button->width, button->height,
+                            COLOR_WHITE, "CONFIRM");
+        if (index == 1) {
+            draw_bt_status_icon(button->x + button->width - 22, button->y + 6, COLOR_WHITE);
+        }
+        return;
+    }
+    
+    DLOGD(DISPLAY, "Drawing button %d at (%d, %d)", index, button->x, button->y);
+    ili9341_draw_button(button->x, button->y, button->width, button->height,
+                        button->color, button->label);
+    draw_macro_button_icons(button, index == 1);
+    
+    if (index == selected) {
+        const uint16_t t = SELECTION_FRAME;
+        ili9341_fill_rect(button->x, button->y, button->width, t, COLOR_WHITE);
+        ili9341_fill_rect(button->x, button->y + button->height - t, button->width, t, COLOR_WHITE);
+        ili9341_fill_rect(button->x, button->y + t, t, button->height - 2 * t, COLOR_WHITE);
+        ili9341_fill_rect(button->x + button->width - t, button->y + t, t, button->height - 2 * t, COLOR_WHITE);
+    }
+}
+
+/**
+ * Select a macro (CONFIRM appears opposite it) or clear the selection (-1)
+ *
+ * Only the quadrants that change are repainted: the previously and newly
+ * selected buttons and the quadrants their CONFIRM buttons use, so a
+ * selection or cancel sends two quadrants. Falls back to a full redraw if
+ * the panel does not show the main screen; outside playback mode only the
+ * state changes.
+ */
+static void set_macro_selection(int selected)
+{
+    int previous = app_state.send_button_visible ? app_state.selected_macro : -1;
+    int changed[] = { previous, confirm_quadrant(previous), selected, confirm_quadrant(selected) };
+    bool repaint[NUM_MACROS] = { false };
+    dl_rect_t cut[NUM_MACROS];
+    int cut_count = 0;
+    perf_timer_t render_timer;
+    
+    app_state.selected_macro = selected;
+    app_state.send_button_visible = (selected >= 0);
+    if (selected >= 0) {
+        app_state.selection_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        if (ui_task_handle != NULL) {
+            xTaskNotifyGive(ui_task_handle);    // Arm the selection timeout
+        }
+    }
+    
+    for (size_t i = 0; i < sizeof(changed) / sizeof(changed[0]); i++) {
+        if (changed[i] >= 0) {
+            repaint[changed[i]] = true;
+        }
+    }
+    for (int i = 0; i < NUM_MACROS; i++) {
+        if (repaint[i]) {
+            const button_t *button = &app_state.macro_buttons[i];
+            cut[cut_count++] = (dl_rect_t){ button->x, button->y, button->width, button->height };
+        }
+    }
+    
+    if (app_state.mode != MODE_PLAYBACK) {
+        return;     // Timed out while another screen is up: nothing to repaint
+    }
+    
+    perf_timer_start(&render_timer);
+    if (!main_screen_shown || !screen_begin_patch(cut, cut_count)) {
+        draw_main_screen();
+        return;
+    }
+    DLOGI(DISPLAY, "Selection %d -> %d: repainting %d quadrants", previous, selected, cut_count);
+    for (int i = 0; i < NUM_MACROS; i++) {
+        if (repaint[i]) {
+            draw_main_quadrant(i);
+        }
     }
+    main_screen_shown = true;
+    screen_end();
+    perf_timer_stop(&render_timer, &perf_counters.render_us[MODE_PLAYBACK]);
+}
+
+/**
+ * Draw the Bluetooth connection icon (16x18) with its corners in bg
+ */
+static void draw_bt_status_icon(uint16_t x, uint16_t y, uint16_t bg)
+{
+    ili9341_draw_icon(x, y, app_state.ble_connected ? &icon_bt_on : &icon_bt_off, bg);
+}
+
+/**
+ * Decorate a drawn macro button: keyboard icon above the label and, on the
+ * top-right button, the Bluetooth status in its corner
+ */
+static void draw_macro_button_icons(const button_t *button, bool bt_status)
+{
+    uint16_t label_top = button->y + (button->height - font_sans15.line_height) / 2;
     
-    ESP_LOGI(TAG, "Display: Main screen drawn successfully");
+    if (label_top >= button->y + icon_keyboard.height + 8) {
+        ili9341_draw_icon(button->x + (button->width - icon_keyboard.width) / 2,
+                          label_top - icon_keyboard.height - 6, &icon_keyboard, button->color);
+    }
+    if (bt_status) {
+        draw_bt_status_icon(button->x + button->width - 22, button->y + 6, button->color);
+    }
 }
 
 /**
@@ -1721,11 +3958,13 @@ static void draw_main_screen(void)
  */
 static void draw_config_screen(void)
 {
-    ESP_LOGI(TAG, "Display: Drawing config screen...");
-    ESP_LOGI(TAG, "Display: Config layout - 4 editable macro buttons + back button");
+    perf_timer_t render_timer;
+    perf_timer_start(&render_timer);
     
-    // Clear screen to black
-    ili9341_fill_screen(COLOR_BLACK);
+    DLOGI(DISPLAY, "Drawing config screen");
+    
+    // Record the screen on a black background; screen_end() sends it in bands
+    screen_begin(COLOR_BLACK);
     
     // Draw title area at top
     ili9341_fill_rect(0, 0, SCREEN_WIDTH, 30, COLOR_DARKBLUE);
@@ -1733,45 +3972,15 @@ static void draw_config_screen(void)
     // Draw title text
     ili9341_draw_string(5, 10, "Configure Macros", COLOR_WHITE, COLOR_DARKBLUE, 1);
     
-    // Define button layout - same as main screen but with different behavior
-    const uint16_t margin = BUTTON_MARGIN;
+    // Same grid as the main screen, below the title
     const uint16_t top_margin = 35; // Leave space for title
-    const uint16_t button_width = (SCREEN_WIDTH - 3 * margin) / 2;
-    const uint16_t button_height = ((SCREEN_HEIGHT - top_margin - 3 * margin) / 2) - 10;
-    
-    // Store button positions
-    // Top-left: Red (M1) - macro 0
-    app_state.macro_buttons[0].x = margin;
-    app_state.macro_buttons[0].y = top_margin;
-    app_state.macro_buttons[0].width = button_width;
-    app_state.macro_buttons[0].height = button_height;
-    app_state.macro_buttons[0].color = COLOR_RED;
-    
-    // Top-right: Green (M2) - macro 1
-    app_state.macro_buttons[1].x = SCREEN_WIDTH / 2 + margin / 2;
-    app_state.macro_buttons[1].y = top_margin;
-    app_state.macro_buttons[1].width = button_width;
-    app_state.macro_buttons[1].height = button_height;
-    app_state.macro_buttons[1].color = COLOR_GREEN;
-    
-    // Bottom-left: Blue (M3) - macro 2
-    app_state.macro_buttons[2].x = margin;
-    app_state.macro_buttons[2].y = top_margin + button_height + margin;
-    app_state.macro_buttons[2].width = button_width;
-    app_state.macro_buttons[2].height = button_height;
-    app_state.macro_buttons[2].color = COLOR_BLUE;
-    
-    // Bottom-right: Yellow (M4) - macro 3
-    app_state.macro_buttons[3].x = SCREEN_WIDTH / 2 + margin / 2;
-    app_state.macro_buttons[3].y = top_margin + button_height + margin;
-    app_state.macro_buttons[3].width = button_width;
-    app_state.macro_buttons[3].height = button_height;
-    app_state.macro_buttons[3].color = COLOR_YELLOW;
+    const uint16_t button_height = ((SCREEN_HEIGHT - top_margin - 3 * BUTTON_MARGIN) / 2) - 10;
+    layout_macro_buttons(top_margin, top_margin + button_height + BUTTON_MARGIN, button_height);
     
     // Draw the 4 macro buttons
     for (int i = 0; i < NUM_MACROS; i++) {
-        ESP_LOGI(TAG, "Drawing config button %d at (%d, %d)", i, 
-                app_state.macro_buttons[i].x, app_state.macro_buttons[i].y);
+        DLOGD(DISPLAY, "Drawing config button %d at (%d, %d)", i, 
+              app_state.macro_buttons[i].x, app_state.macro_buttons[i].y);
         ili9341_draw_button(app_state.macro_buttons[i].x, app_state.macro_buttons[i].y,
                            app_state.macro_buttons[i].width, app_state.macro_buttons[i].height,
                            app_state.macro_buttons[i].color, app_state.macros[i]);
@@ -1784,7 +3993,11 @@ static void draw_config_screen(void)
     uint16_t back_btn_y = SCREEN_HEIGHT - back_btn_height - 5;
     ili9341_draw_button(back_btn_x, back_btn_y, back_btn_width, back_btn_height, COLOR_GRAY, "BACK");
     
-    ESP_LOGI(TAG, "Display: Config screen drawn successfully");
+    DLOGD(DISPLAY, "Config screen drawn");
+    
+    screen_end();
+    
+    perf_timer_stop(&render_timer, &perf_counters.render_us[MODE_CONFIG]);
 }
 
 /**
@@ -1792,24 +4005,27 @@ static void draw_config_screen(void)
  */
 static void draw_keyboard(void)
 {
-    ESP_LOGI(TAG, "Display: Drawing keyboard...");
-    ESP_LOGI(TAG, "Display: Keyboard layout - QWERTY + special chars + controls");
+    perf_timer_t render_timer;
+    perf_timer_start(&render_timer);
     
-    // Clear screen to black
-    ili9341_fill_screen(COLOR_BLACK);
+    DLOGD(DISPLAY, "Drawing keyboard (page %d)", app_state.keyboard_page);
+    
+    // Record the screen on a black background; screen_end() sends it in bands
+    screen_begin(COLOR_BLACK);
     
     // Draw title/text input area at top (showing what's been typed)
     ili9341_fill_rect(0, 0, SCREEN_WIDTH, 50, COLOR_DARKBLUE);
     
-    // Display the edit buffer text (with scrolling if needed)
-    // Show up to 50 characters (approx 50*6 = 300 pixels at size 1)
+    // Display the end of the edit buffer on one line so the cursor stays visible;
+    // tapping the text area opens the scrollable preview of the whole text
     if (strlen(app_state.edit_buffer) > 0) {
-        // Draw text starting from position 5, 5
-        ili9341_draw_string(5, 5, app_state.edit_buffer, COLOR_WHITE, COLOR_DARKBLUE, 1);
+        int first = (app_state.edit_buffer_len > EDIT_LINE_CHARS) ?
+                    app_state.edit_buffer_len - EDIT_LINE_CHARS : 0;
+        ili9341_draw_string(5, 5, app_state.edit_buffer + first, COLOR_WHITE, COLOR_DARKBLUE, 1);
         
         // Draw cursor (blinking effect simulation - just show as underscore at end)
         if (app_state.edit_buffer_len < MAX_MACRO_LEN - 1) {
-            uint16_t cursor_x = 5 + app_state.edit_buffer_len * 6;
+            uint16_t cursor_x = 5 + (app_state.edit_buffer_len - first) * 6;
             if (cursor_x < SCREEN_WIDTH - 6) {
                 ili9341_draw_char(cursor_x, 5, '_', COLOR_YELLOW, COLOR_DARKBLUE, 1);
             }
@@ -1823,6 +4039,9 @@ static void draw_keyboard(void)
     char count_str[20];
     snprintf(count_str, sizeof(count_str), "%d/%d", app_state.edit_buffer_len, MAX_MACRO_LEN - 1);
     ili9341_draw_string(5, 20, count_str, COLOR_GRAY, COLOR_DARKBLUE, 1);
+    if (app_state.edit_buffer_len > EDIT_LINE_CHARS) {
+        ili9341_draw_string(5 + 9 * 6, 20, "(tap to view all)", COLOR_GRAY, COLOR_DARKBLUE, 1);
+    }
     
     // Draw macro name at top (which macro is being edited)
     char title_str[30];
@@ -1830,8 +4049,8 @@ static void draw_keyboard(void)
     uint16_t title_x = SCREEN_WIDTH - strlen(title_str) * 6 - 5;
     ili9341_draw_string(title_x, 5, title_str, COLOR_YELLOW, COLOR_DARKBLUE, 1);
     
-    ESP_LOGI(TAG, "Current text: %.40s%s", app_state.edit_buffer, 
-             strlen(app_state.edit_buffer) > 40 ? "..." : "");
+    // Only the length is logged: the buffer changes before the line is drained
+    DLOGD(UI, "Edit buffer: %d chars", app_state.edit_buffer_len);
     
     // Select current keyboard layout (using static arrays defined at file scope)
     const char* (*current_layout)[10] = NULL;
@@ -1894,7 +4113,11 @@ static void draw_keyboard(void)
     // Save button (green button)
     ili9341_draw_button(260, ctrl_y, 50, KEY_HEIGHT, COLOR_GREEN, "SAVE");
     
-    ESP_LOGI(TAG, "Display: Keyboard drawn successfully (page: %d)", app_state.keyboard_page);
+    DLOGD(DISPLAY, "Keyboard drawn");
+    
+    screen_end();
+    
+    perf_timer_stop(&render_timer, &perf_counters.render_us[MODE_EDIT_KEYBOARD]);
 }
 
 /**
@@ -1902,10 +4125,13 @@ static void draw_keyboard(void)
  */
 static void draw_bt_config_screen(void)
 {
+    perf_timer_t render_timer;
+    perf_timer_start(&render_timer);
+    
     ESP_LOGI(TAG, "Display: Drawing Bluetooth config screen...");
     
-    // Clear screen to black
-    ili9341_fill_screen(COLOR_BLACK);
+    // Record the screen on a black background; screen_end() sends it in bands
+    screen_begin(COLOR_BLACK);
     
     // Draw title area
     ili9341_fill_rect(0, 0, SCREEN_WIDTH, 40, COLOR_DARKBLUE);
@@ -1919,6 +4145,7 @@ static void draw_bt_config_screen(void)
     ili9341_fill_rect(10, 100, SCREEN_WIDTH - 20, 40, COLOR_DARKGRAY);
     const char* status_text = app_state.ble_connected ? "Status: Connected" : "Status: Disconnected";
     ili9341_draw_string(15, 115, status_text, COLOR_WHITE, COLOR_DARKGRAY, 1);
+    draw_bt_status_icon(SCREEN_WIDTH - 38, 111, COLOR_DARKGRAY);
     
     // Draw pair button (blue, centered at top)
     uint16_t pair_btn_width = 120;
@@ -1945,17 +4172,35 @@ static void draw_bt_config_screen(void)
                        COLOR_GRAY, "BACK");
     
     ESP_LOGI(TAG, "Display: Bluetooth config screen drawn");
+    
+    screen_end();
+    
+    perf_timer_stop(&render_timer, &perf_counters.render_us[MODE_BT_CONFIG]);
 }
 
+// Calibration targets on a 3x3 grid below the title. The first three span a
+// triangle (enough for an exact fit), the rest add corners, center and edges.
+static const uint16_t calibration_targets[TOUCH_CAL_MAX_POINTS][2] = {
+    { 30, 70 }, { SCREEN_WIDTH - 30, 70 }, { 30, SCREEN_HEIGHT - 30 },
+    { SCREEN_WIDTH - 30, SCREEN_HEIGHT - 30 }, { SCREEN_WIDTH / 2, 140 },
+    { SCREEN_WIDTH / 2, 70 }, { SCREEN_WIDTH / 2, SCREEN_HEIGHT - 30 },
+    { 30, 140 }, { SCREEN_WIDTH - 30, 140 }
+};
+_Static_assert(CALIBRATION_POINTS >= TOUCH_CAL_MIN_POINTS && CALIBRATION_POINTS <= TOUCH_CAL_MAX_POINTS,
+               "CALIBRATION_POINTS out of range");
+
 /**
  * Draw the calibration screen
  */
 static void draw_calibration_screen(void)
 {
+    perf_timer_t render_timer;
+    perf_timer_start(&render_timer);
+    
     ESP_LOGI(TAG, "Display: Drawing calibration screen (point %d)...", app_state.calibration_point);
     
-    // Clear screen to black
-    ili9341_fill_screen(COLOR_BLACK);
+    // Record the screen on a black background; screen_end() sends it in bands
+    screen_begin(COLOR_BLACK);
     
     // Draw title area
     ili9341_fill_rect(0, 0, SCREEN_WIDTH, 40, COLOR_DARKBLUE);
@@ -1966,19 +4211,8 @@ static void draw_calibration_screen(void)
     uint16_t inst_x = (SCREEN_WIDTH - strlen(instruction) * 6) / 2;
     ili9341_draw_string(inst_x, 50, instruction, COLOR_WHITE, COLOR_BLACK, 1);
     
-    // Define calibration points (2-point calibration: top-left and bottom-right)
-    uint16_t target_x, target_y;
-    const uint16_t margin = 30;
-    
-    if (app_state.calibration_point == 0) {
-        // First point: top-left corner
-        target_x = margin;
-        target_y = 70;
-    } else {
-        // Second point: bottom-right corner
-        target_x = SCREEN_WIDTH - margin;
-        target_y = SCREEN_HEIGHT - margin;
-    }
+    uint16_t target_x = calibration_targets[app_state.calibration_point][0];
+    uint16_t target_y = calibration_targets[app_state.calibration_point][1];
     
     // Draw crosshair target
     const uint16_t cross_size = 20;
@@ -1992,11 +4226,282 @@ static void draw_calibration_screen(void)
     
     // Draw progress indicator
     char progress[32];
-    snprintf(progress, sizeof(progress), "Point %d of 2", app_state.calibration_point + 1);
+    snprintf(progress, sizeof(progress), "Point %d of %d", app_state.calibration_point + 1, CALIBRATION_POINTS);
     uint16_t prog_x = (SCREEN_WIDTH - strlen(progress) * 6) / 2;
     ili9341_draw_string(prog_x, SCREEN_HEIGHT - 30, progress, COLOR_GRAY, COLOR_BLACK, 1);
     
     ESP_LOGI(TAG, "Display: Calibration screen drawn (target at %d, %d)", target_x, target_y);
+    
+    screen_end();
+    
+    perf_timer_stop(&render_timer, &perf_counters.render_us[MODE_CALIBRATION]);
+}
+
+/**
+ * Draw the hidden diagnostics screen (performance counters)
+ */
+static void draw_diagnostics_screen(void)
+{
+    perf_timer_t render_timer;
+    perf_timer_start(&render_timer);
+    
+    static const app_mode_t render_modes[] = {
+        MODE_PLAYBACK, MODE_CONFIG, MODE_EDIT_KEYBOARD, MODE_BT_CONFIG,
+        MODE_CALIBRATION, MODE_DIAGNOSTICS
+    };
+    char line[54];  // 320 px / 6 px per character
+    uint16_t y = 45;
+    
+    DLOGI(DISPLAY, "Drawing diagnostics screen");
+    
+    // Record the screen on a black background; screen_end() sends it in bands
+    screen_begin(COLOR_BLACK);
+    
+    // Draw title area
+    ili9341_fill_rect(0, 0, SCREEN_WIDTH, 40, COLOR_DARKBLUE);
+    ili9341_draw_string(5, 15, "Diagnostics", COLOR_WHITE, COLOR_DARKBLUE, 1);
+    ili9341_draw_string(SCREEN_WIDTH - 16 * 6 - 5, 15, "Touch to refresh", COLOR_GRAY, COLOR_DARKBLUE, 1);
+    
+    snprintf(line, sizeof(line), "SPI:    %lu xfers, %lu KB",
+             (unsigned long)perf_counters.spi_transactions,
+             (unsigned long)(perf_counters.spi_bytes / 1024));
+    ili9341_draw_string(10, y, line, COLOR_WHITE, COLOR_BLACK, 1);
+    y += 12;
+    
+    snprintf(line, sizeof(line), "Touch:  %lu samples, %lu rejected",
+             (unsigned long)perf_counters.touch_samples,
+             (unsigned long)perf_counters.touch_rejected);
+    ili9341_draw_string(10, y, line, COLOR_WHITE, COLOR_BLACK, 1);
+    y += 12;
+    
+    snprintf(line, sizeof(line), "Events: %lu   HID reports: %lu",
+             (unsigned long)perf_counters.events_dispatched,
+             (unsigned long)perf_counters.hid_reports);
+    ili9341_draw_string(10, y, line, COLOR_WHITE, COLOR_BLACK, 1);
+    y += 12;
+    
+    uint32_t lookups = glyph_cache.stats.hits + glyph_cache.stats.misses;
+    snprintf(line, sizeof(line), "Glyphs: %lu%% hit, %lu evicted, %lu cells",
+             (unsigned long)(lookups ? (uint64_t)glyph_cache.stats.hits * 100 / lookups : 0),
+             (unsigned long)glyph_cache.stats.evictions,
+             (unsigned long)glyph_cache.stats.entries);
+    ili9341_draw_string(10, y, line, COLOR_WHITE, COLOR_BLACK, 1);
+    y += 12;
+    
+    snprintf(line, sizeof(line), "NVS:    %lu commits, avg %lu us, max %lu us",
+             (unsigned long)perf_counters.nvs_commit_us.count,
+             (unsigned long)perf_stat_avg(&perf_counters.nvs_commit_us),
+             (unsigned long)perf_counters.nvs_commit_us.max);
+    ili9341_draw_string(10, y, line, COLOR_WHITE, COLOR_BLACK, 1);
+    y += 14;
+    
+    ili9341_draw_string(10, y, "Render       count  avg us  max us", COLOR_YELLOW, COLOR_BLACK, 1);
+    y += 12;
+    for (size_t i = 0; i < sizeof(render_modes) / sizeof(render_modes[0]); i++) {
+        const perf_stat_t *stat = &perf_counters.render_us[render_modes[i]];
+        snprintf(line, sizeof(line), "%-12s %5lu %7lu %7lu", app_mode_names[render_modes[i]],
+                 (unsigned long)stat->count, (unsigned long)perf_stat_avg(stat),
+                 (unsigned long)stat->max);
+        ili9341_draw_string(10, y, line, COLOR_WHITE, COLOR_BLACK, 1);
+        y += 12;
+    }
+    
+    // Draw back button (same place as on the BT config screen)
+    uint16_t back_btn_width = 100;
+    uint16_t back_btn_height = 30;
+    uint16_t back_btn_x = (SCREEN_WIDTH - back_btn_width) / 2;
+    uint16_t back_btn_y = SCREEN_HEIGHT - back_btn_height - 10;
+    ili9341_draw_button(back_btn_x, back_btn_y, back_btn_width, back_btn_height, 
+                       COLOR_GRAY, "BACK");
+    
+    screen_end();
+    
+    perf_timer_stop(&render_timer, &perf_counters.render_us[MODE_DIAGNOSTICS]);
+}
+
+// =============================================================================
+// MACRO PREVIEW (HARDWARE SCROLL)
+// =============================================================================
+//
+// The edit buffer is laid out in pages of PREVIEW_COLS x PREVIEW_ROWS
+// characters, placed side by side on a content strip one view width per page.
+// Content column x always lives in frame memory column x % PREVIEW_VIEW_WIDTH,
+// so scrolling only moves the panel's scroll start and writes the columns
+// that come into view (PREVIEW_SCROLL_STEP x 240 pixels per frame instead of
+// repainting the 280 x 240 view).
+
+/**
+ * Whether content pixel (x, y) is set by a character of the edit buffer
+ */
+static bool preview_pixel_on(uint32_t x, uint16_t y)
+{
+    uint32_t page = x / PREVIEW_VIEW_WIDTH;
+    uint32_t px = x % PREVIEW_VIEW_WIDTH;
+    
+    if (px < PREVIEW_MARGIN || y < PREVIEW_MARGIN) return false;
+    px -= PREVIEW_MARGIN;
+    uint16_t py = y - PREVIEW_MARGIN;
+    
+    uint32_t col = px / PREVIEW_CELL_W;
+    uint32_t row = py / PREVIEW_CELL_H;
+    if (col >= PREVIEW_COLS || row >= PREVIEW_ROWS) return false;
+    
+    uint32_t index = (page * PREVIEW_ROWS + row) * PREVIEW_COLS + col;
+    if (index >= (uint32_t)app_state.edit_buffer_len) return false;
+    
+    char c = app_state.edit_buffer[index];
+    if (c < 32 || c > 126) c = ' ';
+    
+    // Size 2: each font dot is 2x2 pixels; dot column 5 and row 7 are spacing
+    uint32_t dot_x = (px % PREVIEW_CELL_W) / 2;
+    uint32_t dot_y = (py % PREVIEW_CELL_H) / 2;
+    return dot_x < 5 && dot_y < 7 && (font5x7[c - 32][dot_x] & (1 << dot_y));
+}
+
+/**
+ * Render content columns [content_x, content_x + width) into their frame memory columns
+ */
+static void preview_render_columns(uint32_t content_x, uint16_t width)
+{
+    uint16_t fg_be = (uint16_t)((COLOR_WHITE << 8) | (COLOR_WHITE >> 8));
+    uint16_t bg_be = (uint16_t)((COLOR_DARKBLUE << 8) | (COLOR_DARKBLUE >> 8));
+    
+    if (pixel_band_mutex == NULL) return;
+    
+    xSemaphoreTake(pixel_band_mutex, portMAX_DELAY);
+    while (width > 0) {
+        // Split where the content wraps around the frame memory
+        uint16_t column = content_x % PREVIEW_VIEW_WIDTH;
+        uint16_t span = (width < PREVIEW_VIEW_WIDTH - column) ? width : PREVIEW_VIEW_WIDTH - column;
+        uint16_t band_rows = PIXEL_BAND_PIXELS / span;
+        
+        for (uint16_t row = 0; row < SCREEN_HEIGHT; row += band_rows) {
+            uint16_t rows = (SCREEN_HEIGHT - row < band_rows) ? SCREEN_HEIGHT - row : band_rows;
+            uint16_t *p = pixel_band;
+            
+            for (uint16_t y = row; y < row + rows; y++) {
+                for (uint16_t x = 0; x < span; x++) {
+                    *p++ = preview_pixel_on(content_x + x, y) ? fg_be : bg_be;
+                }
+            }
+            
+            display_bus_lock();
+            ili9341_set_addr_window(column, row, column + span - 1, row + rows - 1);
+            ili9341_send_data((const uint8_t *)pixel_band, span * rows * 2);
+            display_bus_unlock();
+        }
+        
+        content_x += span;
+        width -= span;
+    }
+    xSemaphoreGive(pixel_band_mutex);
+}
+
+/**
+ * Scroll the preview to a content offset, one PREVIEW_SCROLL_STEP frame at a time
+ */
+static void preview_scroll_to(uint32_t target)
+{
+    uint32_t max_offset = preview.content_width - PREVIEW_VIEW_WIDTH;
+    uint64_t spi_bytes = perf_counters.spi_bytes;
+    
+    if (target > max_offset) target = max_offset;
+    
+    while (preview.offset != target) {
+        if (target > preview.offset) {
+            uint32_t step = target - preview.offset;
+            if (step > PREVIEW_SCROLL_STEP) step = PREVIEW_SCROLL_STEP;
+            
+            // Columns entering on the right take the memory of those leaving on the left
+            preview_render_columns(preview.offset + PREVIEW_VIEW_WIDTH, step);
+            preview.offset += step;
+        } else {
+            uint32_t step = preview.offset - target;
+            if (step > PREVIEW_SCROLL_STEP) step = PREVIEW_SCROLL_STEP;
+            
+            preview.offset -= step;
+            preview_render_columns(preview.offset, step);
+        }
+        ili9341_set_scroll_start(preview.offset % PREVIEW_VIEW_WIDTH);
+    }
+    
+    DLOGD(DISPLAY, "Preview at %d (%d SPI bytes)", preview.offset,
+          (uint32_t)(perf_counters.spi_bytes - spi_bytes));
+}
+
+/**
+ * Scroll the preview with a dragging finger
+ *
+ * Scrolling takes a while on the SPI bus, so the content would trail the
+ * finger by that long. Instead of the latest sample, the view is scrolled to
+ * where the finger is predicted to be once the scroll is on the panel, using
+ * the measured duration of previous drag scrolls.
+ */
+static void preview_drag(const gesture_event_t *event)
+{
+    int64_t start_us = esp_timer_get_time();
+    
+    if (!preview.dragging) {
+        // Pin the content under the press position to the finger
+        preview.dragging = true;
+        preview.drag_anchor = (int32_t)preview.offset + (event->x - event->dx);
+    }
+    
+    int16_t x, y;
+    touch_predict_at(&touch_track, preview.drag_render_ms, &x, &y);
+    int32_t target = preview.drag_anchor - x;
+    preview_scroll_to(target < 0 ? 0 : (uint32_t)target);
+    
+    // Smoothed 3:1 so one slow frame does not throw the prediction far ahead
+    uint32_t render_ms = (uint32_t)((esp_timer_get_time() - start_us + 500) / 1000);
+    preview.drag_render_ms = (preview.drag_render_ms * 3 + render_ms + 2) / 4;
+    DLOGD(TOUCH, "Preview drag: finger %d, predicted %d, horizon %lu ms", event->x, x, preview.drag_render_ms);
+}
+
+/**
+ * Finish a drag where the finger actually lifted
+ */
+static void preview_drag_end(const gesture_event_t *event)
+{
+    if (preview.dragging) {
+        preview.dragging = false;
+        int32_t target = preview.drag_anchor - event->x;
+        preview_scroll_to(target < 0 ? 0 : (uint32_t)target);
+    }
+}
+
+/**
+ * Draw the macro preview: scrolling text view plus the fixed button strip
+ */
+static void draw_preview_screen(void)
+{
+    perf_timer_t render_timer;
+    perf_timer_start(&render_timer);
+    
+    const uint32_t page_chars = PREVIEW_COLS * PREVIEW_ROWS;
+    uint32_t pages = (app_state.edit_buffer_len + page_chars - 1) / page_chars;
+    if (pages == 0) pages = 1;
+    
+    DLOGI(DISPLAY, "Drawing preview (%d chars, %d pages)", app_state.edit_buffer_len, pages);
+    
+    preview.content_width = pages * PREVIEW_VIEW_WIDTH;
+    if (preview.offset > preview.content_width - PREVIEW_VIEW_WIDTH) {
+        preview.offset = 0;
+    }
+    
+    ili9341_set_scroll_area(0, PREVIEW_VIEW_WIDTH, SCREEN_WIDTH - PREVIEW_VIEW_WIDTH);
+    ili9341_set_scroll_start(preview.offset % PREVIEW_VIEW_WIDTH);
+    preview_render_columns(preview.offset, PREVIEW_VIEW_WIDTH);
+    
+    // Fixed strip (outside the scroll area): previous, next, OK
+    uint16_t strip_x = PREVIEW_VIEW_WIDTH;
+    uint16_t strip_w = SCREEN_WIDTH - PREVIEW_VIEW_WIDTH;
+    ili9341_fill_rect(strip_x, 0, strip_w, SCREEN_HEIGHT, COLOR_BLACK);
+    ili9341_draw_button(strip_x + 2, 2, strip_w - 4, 76, COLOR_DARKGRAY, "<");
+    ili9341_draw_button(strip_x + 2, 82, strip_w - 4, 76, COLOR_DARKGRAY, ">");
+    ili9341_draw_button(strip_x + 2, 162, strip_w - 4, 76, COLOR_GREEN, "OK");
+    
+    perf_timer_stop(&render_timer, &perf_counters.render_us[MODE_PREVIEW]);
 }
 
 // =============================================================================
@@ -2022,12 +4527,20 @@ static void ble_init(void)
     // TODO: Set device name "keybot" (as per requirements)
     // TODO: Start advertising
     
+    // Reports are built and sent on the radio core, next to Bluedroid
+    hid_queue = xQueueCreateStatic(HID_QUEUE_LEN, MAX_MACRO_LEN, hid_queue_storage, &hid_queue_buf);
+    task_create_static(hid_task, "hid_task", hid_task_stack, HID_TASK_STACK, HID_TASK_PRIORITY,
+                       &hid_task_tcb, RADIO_CORE);
+    
     ESP_LOGI(TAG, "Bluetooth HID initialized (stub)");
     ESP_LOGI(TAG, "Device name will be: keybot");
 }
 
 /**
  * Send text via Bluetooth HID
+ *
+ * Queues a copy for the HID transmit task and returns at once, so the touch
+ * task can redraw while the macro is typed.
  */
 static void ble_send_text(const char *text)
 {
@@ -2036,12 +4549,48 @@ static void ble_send_text(const char *text)
         return;
     }
     
+    // Static: copied into the queue, and only the touch task sends
+    static char request[MAX_MACRO_LEN];
+    strncpy(request, text, MAX_MACRO_LEN - 1);
+    request[MAX_MACRO_LEN - 1] = '\0';
+    if (xQueueSend(hid_queue, request, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "HID queue full, macro not sent");
+    }
+}
+
+/**
+ * HID transmit task - types queued macros (runs on the radio core)
+ */
+static void hid_task(void *pvParameters)
+{
+    static char text[MAX_MACRO_LEN];
+    
+    while (1) {
+        if (xQueueReceive(hid_queue, text, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        hid_type_text(text);
+    }
+}
+
+/**
+ * Convert text to HID keyboard reports and send them
+ */
+static void hid_type_text(const char *text)
+{
     ESP_LOGI(TAG, "Sending text via BLE: %.40s%s", text,
              strlen(text) > 40 ? "..." : "");
     
-    // TODO: Convert text to HID keyboard reports
-    // TODO: Send each character with proper key codes
     // TODO: Handle special characters and modifiers
+    
+    // HID residency covers the transmission. A display state entered meanwhile
+    // (dimming) is kept by the residency counter and applied when it ends.
+    power_enter(POWER_HID);
+    for (const char *c = text; *c != '\0'; c++) {
+        // TODO: Send the key-down and key-up reports for *c and wait for each to go out,
+        // counting perf_counters.hid_reports only for reports the transport accepted
+    }
+    power_leave_hid();
 }
 
 // =============================================================================
@@ -2075,10 +4624,18 @@ static int get_touched_macro_button(uint16_t x, uint16_t y)
  */
 static void handle_playback_touch(uint16_t x, uint16_t y, uint32_t press_duration)
 {
-    ESP_LOGI(TAG, "Playback touch at (%d, %d), duration: %lu ms", x, y, press_duration);
+    latency_note_handler();
     
-    // Check for long press (5s for config, 10s for calibration, 20s for BT config)
-    if (press_duration >= BT_CONFIG_PRESS_MS) {
+    DLOGI(UI, "Playback touch at (%d, %d), duration: %lu ms", x, y, press_duration);
+    
+    // Check for long press (5s for config, 10s for calibration, 20s for BT config,
+    // 30s for the hidden diagnostics screen)
+    if (press_duration >= DIAGNOSTICS_PRESS_MS) {
+        ESP_LOGI(TAG, "Long press detected (>30s) - opening diagnostics");
+        app_state.mode = MODE_DIAGNOSTICS;
+        draw_diagnostics_screen();
+        return;
+    } else if (press_duration >= BT_CONFIG_PRESS_MS) {
         ESP_LOGI(TAG, "Long press detected (>20s) - opening BT config");
         app_state.mode = MODE_BT_CONFIG;
         draw_bt_config_screen();
@@ -2108,9 +4665,7 @@ static void handle_playback_touch(uint16_t x, uint16_t y, uint32_t press_duratio
         ble_send_text(app_state.macros[app_state.selected_macro]);
         
         // Reset selection
-        app_state.selected_macro = -1;
-        app_state.send_button_visible = false;
-        draw_main_screen();
+        set_macro_selection(-1);
         return;
     }
     
@@ -2123,24 +4678,17 @@ static void handle_playback_touch(uint16_t x, uint16_t y, uint32_t press_duratio
         if (app_state.selected_macro == touched_button) {
             // Same button pressed again, cancel selection
             ESP_LOGI(TAG, "Same button pressed, canceling selection");
-            app_state.selected_macro = -1;
-            app_state.send_button_visible = false;
+            set_macro_selection(-1);
         } else {
             // New button selected, show confirm button
             ESP_LOGI(TAG, "New button selected: %d", touched_button);
-            app_state.selected_macro = touched_button;
-            app_state.send_button_visible = true;
-            app_state.selection_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
+            set_macro_selection(touched_button);
         }
-        
-        draw_main_screen();
     } else {
         // Touch outside buttons, cancel selection
         if (app_state.selected_macro >= 0) {
             ESP_LOGI(TAG, "Touch outside buttons, canceling selection");
-            app_state.selected_macro = -1;
-            app_state.send_button_visible = false;
-            draw_main_screen();
+            set_macro_selection(-1);
         }
     }
 }
@@ -2150,7 +4698,9 @@ static void handle_playback_touch(uint16_t x, uint16_t y, uint32_t press_duratio
  */
 static void handle_config_touch(uint16_t x, uint16_t y)
 {
-    ESP_LOGI(TAG, "Config touch at (%d, %d)", x, y);
+    latency_note_handler();
+    
+    DLOGI(UI, "Config touch at (%d, %d)", x, y);
     
     // Check if back button was pressed (bottom center)
     uint16_t back_btn_width = 100;
@@ -2184,12 +4734,43 @@ static void handle_config_touch(uint16_t x, uint16_t y)
     }
 }
 
+/**
+ * Step the keyboard to the next page (ABC -> 123 -> SYM) or back
+ */
+static void cycle_keyboard_page(bool forward)
+{
+    switch (app_state.keyboard_page) {
+        case KB_PAGE_ALPHA_LOWER:
+        case KB_PAGE_ALPHA_UPPER:
+            app_state.keyboard_page = forward ? KB_PAGE_NUMBERS : KB_PAGE_SYMBOLS;
+            break;
+        case KB_PAGE_NUMBERS:
+            app_state.keyboard_page = forward ? KB_PAGE_SYMBOLS : KB_PAGE_ALPHA_LOWER;
+            break;
+        case KB_PAGE_SYMBOLS:
+            app_state.keyboard_page = forward ? KB_PAGE_ALPHA_LOWER : KB_PAGE_NUMBERS;
+            break;
+    }
+}
+
 /**
  * Handle touch in keyboard mode
  */
 static void handle_keyboard_touch(uint16_t x, uint16_t y)
 {
-    ESP_LOGI(TAG, "Keyboard touch at (%d, %d)", x, y);
+    latency_note_handler();
+    
+    DLOGD(UI, "Keyboard touch at (%d, %d)", x, y);
+    
+    // Text area opens the preview of the whole buffer
+    if (y < 50 && app_state.edit_buffer_len > 0) {
+        ESP_LOGI(TAG, "Opening macro preview (%d chars)", app_state.edit_buffer_len);
+        app_state.mode = MODE_PREVIEW;
+        preview.offset = 0;
+        preview.dragging = false;
+        draw_preview_screen();
+        return;
+    }
     
     // Control buttons Y position
     uint16_t ctrl_y = KEYBOARD_START_Y + (KEY_HEIGHT + KEY_MARGIN) * KEYBOARD_ROWS + 5;
@@ -2198,19 +4779,7 @@ static void handle_keyboard_touch(uint16_t x, uint16_t y)
     // Page switch button (ABC/123/SYM)
     if (x >= 10 && x < 60 && y >= ctrl_y && y < (ctrl_y + KEY_HEIGHT)) {
         ESP_LOGI(TAG, "Page switch button pressed");
-        // Cycle through pages
-        switch (app_state.keyboard_page) {
-            case KB_PAGE_ALPHA_LOWER:
-            case KB_PAGE_ALPHA_UPPER:
-                app_state.keyboard_page = KB_PAGE_NUMBERS;
-                break;
-            case KB_PAGE_NUMBERS:
-                app_state.keyboard_page = KB_PAGE_SYMBOLS;
-                break;
-            case KB_PAGE_SYMBOLS:
-                app_state.keyboard_page = KB_PAGE_ALPHA_LOWER;
-                break;
-        }
+        cycle_keyboard_page(true);
         draw_keyboard();
         return;
     }
@@ -2251,8 +4820,8 @@ static void handle_keyboard_touch(uint16_t x, uint16_t y)
     // Save button
     if (x >= 260 && x < 310 && y >= ctrl_y && y < (ctrl_y + KEY_HEIGHT)) {
         ESP_LOGI(TAG, "Save button pressed");
-        // Save the macro
-        save_macro(app_state.editing_macro, app_state.edit_buffer);
+        // Queue the macro for the storage worker; the flash write happens in the background
+        storage_submit_macro(app_state.editing_macro, app_state.edit_buffer);
         
         // Return to config screen
         app_state.mode = MODE_CONFIG;
@@ -2290,7 +4859,7 @@ static void handle_keyboard_touch(uint16_t x, uint16_t y)
             }
             
             if (ch && strlen(ch) > 0 && app_state.edit_buffer_len < MAX_MACRO_LEN - 1) {
-                ESP_LOGI(TAG, "Key pressed: '%s'", ch);
+                DLOGD(UI, "Key pressed: '%c'", ch[0]);
                 app_state.edit_buffer[app_state.edit_buffer_len++] = ch[0];
                 app_state.edit_buffer[app_state.edit_buffer_len] = '\0';
                 draw_keyboard();
@@ -2304,7 +4873,9 @@ static void handle_keyboard_touch(uint16_t x, uint16_t y)
  */
 static void handle_bt_config_touch(uint16_t x, uint16_t y)
 {
-    ESP_LOGI(TAG, "BT config touch at (%d, %d)", x, y);
+    latency_note_handler();
+    
+    DLOGI(UI, "BT config touch at (%d, %d)", x, y);
     
     // Check if back button was pressed
     uint16_t back_btn_width = 100;
@@ -2352,23 +4923,20 @@ static void handle_bt_config_touch(uint16_t x, uint16_t y)
         y >= clear_btn_y && y < (clear_btn_y + clear_btn_height)) {
         ESP_LOGI(TAG, "Clear flash button pressed - erasing NVS");
         
-        // Erase NVS namespace
-        nvs_handle_t nvs_handle;
-        esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
-        if (err == ESP_OK) {
-            nvs_erase_all(nvs_handle);
-            nvs_commit(nvs_handle);
-            nvs_close(nvs_handle);
-            ESP_LOGI(TAG, "NVS erased successfully");
-        } else {
-            ESP_LOGE(TAG, "Failed to open NVS for erasing: %s", esp_err_to_name(err));
-        }
+        // Queue the NVS erase (ordered after any pending saves)
+        storage_submit_erase();
+        
+        // Reset macros to defaults in RAM (what load_macros() would read after the erase)
+        set_default_macros();
         
-        // Reload macros (will get defaults)
-        load_macros();
+        // The erase also drops "boot_opts": CLEAR FLASH is a full reset, so the
+        // self-test mode goes back to its default and the next boot runs the
+        // full test again (tested_fw_sha256 cleared), as after a first flash
+        app_state.boot_options = (boot_options_t){ .selftest_mode = SELFTEST_FIRST_BOOT };
         
         // Reset calibration data
         app_state.calibration.is_calibrated = false;
+        touch_map_update();
         
         // Visual feedback - flash screen or show message
         ili9341_fill_screen(COLOR_RED);
@@ -2386,73 +4954,65 @@ static void handle_bt_config_touch(uint16_t x, uint16_t y)
  */
 static void handle_calibration_touch(uint16_t raw_x, uint16_t raw_y)
 {
+    latency_note_handler();
+    
     ESP_LOGI(TAG, "Calibration touch - raw: (%d, %d), point: %d", raw_x, raw_y, app_state.calibration_point);
     
     // Store the raw coordinates for this calibration point
-    app_state.cal_raw_x[app_state.calibration_point] = raw_x;
-    app_state.cal_raw_y[app_state.calibration_point] = raw_y;
+    touch_cal_point_t *point = &app_state.cal_points[app_state.calibration_point];
+    point->raw_x = raw_x;
+    point->raw_y = raw_y;
+    point->screen_x = calibration_targets[app_state.calibration_point][0];
+    point->screen_y = calibration_targets[app_state.calibration_point][1];
     
     // Move to next calibration point
     app_state.calibration_point++;
     
-    if (app_state.calibration_point >= 2) {
-        // All calibration points collected, calculate calibration
-        ESP_LOGI(TAG, "Calibration complete - calculating calibration data");
-        
-        // Point 0 is top-left (30, 70)
-        // Point 1 is bottom-right (290, 210)
-        
-        // For a 2-point calibration with axes potentially swapped:
-        // In normal operation, we swap axes: raw_y->screen_x, raw_x->screen_y (inverted)
-        // So for calibration:
-        //   Point 0 (screen 30, 70) should map to raw_y[0] and raw_x[0]
-        //   Point 1 (screen 290, 210) should map to raw_y[1] and raw_x[1]
-        
-        // Since raw_y maps to screen_x (increasing left to right):
-        // Point 0 has lower screen_x (30), Point 1 has higher screen_x (290)
-        // So raw_y[0] < raw_y[1] normally
-        
-        // Since raw_x maps to screen_y inverted (SCREEN_HEIGHT - raw_x):
-        // Point 0 has lower screen_y (70), Point 1 has higher screen_y (210)
-        // After inversion: Point 0 should have higher raw_x, Point 1 lower raw_x
-        // So raw_x[0] > raw_x[1] normally
-        
-        // Store the raw values for each axis (we'll handle inversion in map functions)
-        // For raw_y -> screen_x mapping:
-        if (app_state.cal_raw_y[0] < app_state.cal_raw_y[1]) {
-            app_state.calibration.raw_x_min = app_state.cal_raw_y[0];
-            app_state.calibration.raw_x_max = app_state.cal_raw_y[1];
-        } else {
-            app_state.calibration.raw_x_min = app_state.cal_raw_y[1];
-            app_state.calibration.raw_x_max = app_state.cal_raw_y[0];
-        }
+    if (app_state.calibration_point >= CALIBRATION_POINTS) {
+        // All calibration points collected: least-squares affine fit
+        ESP_LOGI(TAG, "Calibration complete - fitting %d points", CALIBRATION_POINTS);
         
-        // For raw_x -> screen_y mapping (inverted):
-        if (app_state.cal_raw_x[0] < app_state.cal_raw_x[1]) {
-            app_state.calibration.raw_y_min = app_state.cal_raw_x[0];
-            app_state.calibration.raw_y_max = app_state.cal_raw_x[1];
-        } else {
-            app_state.calibration.raw_y_min = app_state.cal_raw_x[1];
-            app_state.calibration.raw_y_max = app_state.cal_raw_x[0];
+        touch_cal_matrix_t matrix;
+        touch_cal_residual_t residual = { 0 };
+        app_state.calibration_point = 0;
+        
+        if (!touch_cal_fit(app_state.cal_points, CALIBRATION_POINTS, &matrix, &residual) ||
+            residual.max_px > CALIBRATION_MAX_ERROR) {
+            // Touches that do not fit an affine panel: a missed target, start over
+            ESP_LOGW(TAG, "Calibration rejected (max error %.1f px), restarting", residual.max_px);
+            ili9341_fill_screen(COLOR_RED);
+            ili9341_draw_string(10, 110, "Calibration failed, retry", COLOR_WHITE, COLOR_RED, 2);
+            vTaskDelay(pdMS_TO_TICKS(1500));
+            draw_calibration_screen();
+            return;
         }
         
+        app_state.calibration.matrix = matrix;
+        app_state.calibration.rms_error = residual.rms_px;
+        app_state.calibration.max_error = residual.max_px;
+        app_state.calibration.points = CALIBRATION_POINTS;
         app_state.calibration.is_calibrated = true;
+        touch_map_update();
         
-        ESP_LOGI(TAG, "Calibration calculated: raw_y->screen_x(%d-%d) raw_x->screen_y(%d-%d)",
-                 app_state.calibration.raw_x_min, app_state.calibration.raw_x_max,
-                 app_state.calibration.raw_y_min, app_state.calibration.raw_y_max);
+        ESP_LOGI(TAG, "Calibration fitted: x = (%ld*rx + %ld*ry + %ld) >> 16, y = (%ld*rx + %ld*ry + %ld) >> 16",
+                 (long)matrix.a, (long)matrix.b, (long)matrix.c, (long)matrix.d, (long)matrix.e, (long)matrix.f);
+        ESP_LOGI(TAG, "Calibration residual: %.1f px rms, %.1f px max", residual.rms_px, residual.max_px);
         
-        // Save calibration to NVS
-        save_calibration();
+        // Queue calibration for saving to NVS
+        storage_submit_calibration();
         
-        // Show success message
+        // Show success message with the fit quality
+        char error_line[40];
+        snprintf(error_line, sizeof(error_line), "Error: %.1f px rms, %.1f px max",
+                 residual.rms_px, residual.max_px);
         ili9341_fill_screen(COLOR_GREEN);
-        ili9341_draw_string(60, 110, "Calibration Complete!", COLOR_WHITE, COLOR_GREEN, 2);
+        ili9341_draw_string(60, 100, "Calibration Complete!", COLOR_WHITE, COLOR_GREEN, 2);
+        ili9341_draw_string((SCREEN_WIDTH - strlen(error_line) * 6) / 2, 130, error_line,
+                            COLOR_WHITE, COLOR_GREEN, 1);
         vTaskDelay(pdMS_TO_TICKS(1500));
         
         // Return to main screen
         app_state.mode = MODE_PLAYBACK;
-        app_state.calibration_point = 0;
         draw_main_screen();
     } else {
         // Show next calibration point
@@ -2461,73 +5021,81 @@ static void handle_calibration_touch(uint16_t raw_x, uint16_t raw_y)
 }
 
 /**
- * Map raw touch coordinate to screen X coordinate using calibration
- * Note: raw_y maps to screen_x in landscape mode (axes are swapped)
+ * Handle touch on the diagnostics screen
+ * BACK returns to playback mode, a touch anywhere else redraws with fresh numbers
  */
-static uint16_t map_touch_x(uint16_t raw_y)
+static void handle_diagnostics_touch(uint16_t x, uint16_t y)
 {
-    if (!app_state.calibration.is_calibrated) {
-        // No calibration, use default mapping
-        // raw_y maps to screen_x for landscape mode
-        return (raw_y * SCREEN_WIDTH) / 4095;
-    }
-    
-    // Apply calibration
-    // Clamp raw value to calibration range
-    if (raw_y < app_state.calibration.raw_x_min) {
-        raw_y = app_state.calibration.raw_x_min;
-    }
-    if (raw_y > app_state.calibration.raw_x_max) {
-        raw_y = app_state.calibration.raw_x_max;
-    }
+    latency_note_handler();
     
-    // Map to screen coordinates
-    uint32_t range = app_state.calibration.raw_x_max - app_state.calibration.raw_x_min;
-    if (range == 0) range = 1; // Prevent division by zero
-    
-    uint16_t screen_x = ((uint32_t)(raw_y - app_state.calibration.raw_x_min) * SCREEN_WIDTH) / range;
+    uint16_t back_btn_width = 100;
+    uint16_t back_btn_height = 30;
+    uint16_t back_btn_x = (SCREEN_WIDTH - back_btn_width) / 2;
+    uint16_t back_btn_y = SCREEN_HEIGHT - back_btn_height - 10;
     
-    // Clamp to screen bounds
-    if (screen_x >= SCREEN_WIDTH) {
-        screen_x = SCREEN_WIDTH - 1;
+    if (x >= back_btn_x && x < (back_btn_x + back_btn_width) &&
+        y >= back_btn_y && y < (back_btn_y + back_btn_height)) {
+        ESP_LOGI(TAG, "Back button pressed - returning to playback mode");
+        app_state.mode = MODE_PLAYBACK;
+        draw_main_screen();
+        return;
     }
     
-    return screen_x;
+    draw_diagnostics_screen();
 }
 
 /**
- * Map raw touch coordinate to screen Y coordinate using calibration
- * Note: raw_x maps to screen_y (inverted) in landscape mode
+ * Handle touch on the macro preview
+ * The fixed strip scrolls back/forward a half page or returns to the keyboard (OK)
  */
-static uint16_t map_touch_y(uint16_t raw_x)
+static void handle_preview_touch(uint16_t x, uint16_t y)
 {
-    if (!app_state.calibration.is_calibrated) {
-        // No calibration, use default mapping
-        // raw_x maps to screen_y inverted for landscape mode
-        return (raw_x * SCREEN_HEIGHT) / 4095;
+    latency_note_handler();
+    
+    if (x < PREVIEW_VIEW_WIDTH) {
+        return;
     }
     
-    // Apply calibration
-    // Clamp raw value to calibration range
-    if (raw_x < app_state.calibration.raw_y_min) {
-        raw_x = app_state.calibration.raw_y_min;
+    if (y < 80) {
+        preview_scroll_to(preview.offset > PREVIEW_SCROLL_PAGE ? preview.offset - PREVIEW_SCROLL_PAGE : 0);
+    } else if (y < 160) {
+        preview_scroll_to(preview.offset + PREVIEW_SCROLL_PAGE);
+    } else {
+        ESP_LOGI(TAG, "Preview closed - returning to keyboard");
+        ili9341_reset_scroll();
+        app_state.mode = MODE_EDIT_KEYBOARD;
+        draw_keyboard();
     }
-    if (raw_x > app_state.calibration.raw_y_max) {
-        raw_x = app_state.calibration.raw_y_max;
+}
+
+/**
+ * Rebuild touch_map after the calibration was loaded, fitted or erased
+ */
+static void touch_map_update(void)
+{
+    if (app_state.calibration.is_calibrated) {
+        touch_map = app_state.calibration.matrix;
+    } else {
+        // Default mapping: raw_y spans the width, raw_x the height
+        touch_cal_from_ranges(&touch_map, 0, TOUCH_RAW_MAX, SCREEN_WIDTH, 0, TOUCH_RAW_MAX, SCREEN_HEIGHT);
     }
+}
+
+/**
+ * Map a raw touch sample to screen coordinates
+ * Note: raw_y runs along screen X and raw_x along screen Y in landscape mode;
+ * a calibration matrix also corrects rotation and skew between the panels
+ */
+static void map_touch(uint16_t raw_x, uint16_t raw_y, uint16_t *screen_x, uint16_t *screen_y)
+{
+    int32_t x, y;
     
-    // Map to screen coordinates
-    uint32_t range = app_state.calibration.raw_y_max - app_state.calibration.raw_y_min;
-    if (range == 0) range = 1; // Prevent division by zero
-    
-    uint16_t screen_y = ((uint32_t)(raw_x - app_state.calibration.raw_y_min) * SCREEN_HEIGHT) / range;
+    // Two multiply-adds and a shift per axis, no division
+    touch_cal_apply(&touch_map, raw_x, raw_y, &x, &y);
     
     // Clamp to screen bounds
-    if (screen_y >= SCREEN_HEIGHT) {
-        screen_y = SCREEN_HEIGHT - 1;
-    }
-    
-    return screen_y;
+    *screen_x = (x < 0) ? 0 : (x >= SCREEN_WIDTH) ? SCREEN_WIDTH - 1 : (uint16_t)x;
+    *screen_y = (y < 0) ? 0 : (y >= SCREEN_HEIGHT) ? SCREEN_HEIGHT - 1 : (uint16_t)y;
 }
 
 /**
@@ -2539,89 +5107,182 @@ static uint16_t map_touch_y(uint16_t raw_x)
 static void handle_touch_task(void *pvParameters)
 {
     ESP_LOGI(TAG, "Touch task started");
+    latency_owner = xTaskGetCurrentTaskHandle();
+    
+    // Touches are only dispatched once the UI has drawn its first screen
+    xEventGroupWaitBits(boot_events, BOOT_BIT_UI, pdFALSE, pdTRUE, portMAX_DELAY);
     
-    uint16_t last_x = 0, last_y = 0;
+    gesture_recognizer_t gesture;
+    gesture_event_t event;
     bool was_touched = false;
-    uint32_t touch_start_time = 0;
+    uint16_t raw_x = 0, raw_y = 0;      // Last pressed sample (calibration uses raw values)
+    
+    gesture_init(&gesture);
+    touch_predict_init(&touch_track);
+    display_activity_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
     
     while (1) {
-        uint16_t raw_x, raw_y;
+        uint16_t sample_x, sample_y;
+        uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
         
         // Read raw touch coordinates from XPT2046
-        if (read_touch_coordinates(&raw_x, &raw_y)) {
+        if (read_touch_coordinates(&sample_x, &sample_y)) {
             // Touch detected
+            display_power_activity(now);
             if (!was_touched) {
                 // New touch started
-                touch_start_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
-                ESP_LOGI(TAG, "Touch started - Raw coordinates: X=%d, Y=%d", raw_x, raw_y);
+                latency_begin(&touch_latency, latency_now_us());
+                DLOGD(TOUCH, "Touch started - Raw coordinates: X=%d, Y=%d", sample_x, sample_y);
+                touch_predict_reset(&touch_track);
+                power_hold_cpu(true);
                 was_touched = true;
-                last_x = raw_x;
-                last_y = raw_y;
+            }
+            raw_x = sample_x;
+            raw_y = sample_y;
+            
+            // Calibration handles the landscape axis swap (and any skew)
+            uint16_t screen_x, screen_y;
+            map_touch(raw_x, raw_y, &screen_x, &screen_y);
+            touch_predict_update(&touch_track, screen_x, screen_y, now);
+            
+            // Drags act while the finger is down (calibration only wants the release)
+            if (gesture_touch(&gesture, screen_x, screen_y, now, &event) &&
+                app_state.mode != MODE_CALIBRATION) {
+                dispatch_gesture(&event);
+            }
+        } else if (was_touched) {
+            // Touch just released
+            was_touched = false;
+            if (!gesture_release(&gesture, now, &event)) {
+                power_hold_cpu(false);
+                vTaskDelay(pdMS_TO_TICKS(50));
+                continue;
+            }
+            DLOGI(TOUCH, "Touch released - Gesture %d, duration: %lu ms", event.type, event.duration_ms);
+            
+            // Handle touch based on current mode
+            // Follow this event through to the end of its redraw
+            app_mode_t dispatch_mode = app_state.mode;
+            latency_stamp(&touch_latency, LATENCY_RELEASE, latency_now_us());
+            latency_armed = true;
+            
+            perf_counters.events_dispatched++;
+            if (app_state.mode == MODE_CALIBRATION) {
+                // In calibration mode, use raw coordinates
+                handle_calibration_touch(raw_x, raw_y);
             } else {
-                // Touch continuing
-                // Only log if coordinates changed significantly
-                if (abs((int)raw_x - (int)last_x) > 50 || abs((int)raw_y - (int)last_y) > 50) {
-                    uint32_t duration = (xTaskGetTickCount() * portTICK_PERIOD_MS) - touch_start_time;
-                    ESP_LOGI(TAG, "Touch moved - Raw: X=%d, Y=%d, Duration: %lu ms", raw_x, raw_y, duration);
-                    last_x = raw_x;
-                    last_y = raw_y;
-                }
+                dispatch_gesture(&event);
             }
+            
+            // Polling SPI transfers are complete once the handler returns
+            latency_armed = false;
+            latency_finish(&touch_latency, dispatch_mode, latency_now_us());
+            power_hold_cpu(false);
         } else {
-            // No touch detected
-            if (was_touched) {
-                // Touch just released
-                uint32_t press_duration = (xTaskGetTickCount() * portTICK_PERIOD_MS) - touch_start_time;
-                ESP_LOGI(TAG, "Touch released - Duration: %lu ms", press_duration);
-                
-                // Handle touch based on current mode
-                if (app_state.mode == MODE_CALIBRATION) {
-                    // In calibration mode, use raw coordinates
-                    handle_calibration_touch(raw_x, raw_y);
-                } else {
-                    // For all other modes, map coordinates to screen space
-                    // Map raw coordinates to screen coordinates using calibration
-                    // XPT2046 typical range: 0-4095 for 12-bit ADC
-                    // Screen: 320x240 in landscape mode
-                    
-                    // Swap coordinates for landscape mode
-                    // This assumes the touch controller's orientation relative to display
-                    uint16_t screen_x = map_touch_x(raw_y);
-                    uint16_t screen_y = map_touch_y(raw_x);
-                    
-                    // Clamp to screen bounds
-                    if (screen_x >= SCREEN_WIDTH) screen_x = SCREEN_WIDTH - 1;
-                    if (screen_y >= SCREEN_HEIGHT) screen_y = SCREEN_HEIGHT - 1;
-                    
-                    ESP_LOGI(TAG, "Mapped touch to screen coordinates: X=%d, Y=%d", screen_x, screen_y);
-                    
-                    switch (app_state.mode) {
-                        case MODE_PLAYBACK:
-                            handle_playback_touch(screen_x, screen_y, press_duration);
-                            break;
-                        
-                        case MODE_CONFIG:
-                            handle_config_touch(screen_x, screen_y);
-                            break;
-                        
-                        case MODE_EDIT_KEYBOARD:
-                            handle_keyboard_touch(screen_x, screen_y);
-                            break;
-                        
-                        case MODE_BT_CONFIG:
-                            handle_bt_config_touch(screen_x, screen_y);
-                            break;
-                        
-                        default:
-                            break;
-                    }
-                }
-                
-                was_touched = false;
+            display_power_idle(now);
+            if (display_power == DISPLAY_ASLEEP) {
+                display_sleep_until_touch();
+                continue;
+            }
+            // Nothing pressed: no polling until the touch IRQ or the next backlight step.
+            // The IRQ is level-triggered, so a touch too light to read (or a finger
+            // lifting) keeps PENIRQ low and would end every wait at once: poll at the
+            // normal rate until the sample reads or PENIRQ goes high.
+            if (!touch_wait_irq(display_power_next_ms(xTaskGetTickCount() * portTICK_PERIOD_MS))) {
+                continue;
             }
         }
         
-        vTaskDelay(pdMS_TO_TICKS(50)); // 20Hz polling
+        vTaskDelay(pdMS_TO_TICKS(50)); // 20Hz polling while a finger is down
+    }
+}
+
+/**
+ * Route a gesture to the current mode
+ *
+ * Drags scroll the preview; swipes page the preview and the keyboard. Taps,
+ * long presses and moves no mode consumes become a touch at the gesture's
+ * position, with the press duration for the long-press thresholds.
+ */
+static void dispatch_gesture(const gesture_event_t *event)
+{
+    DLOGD(TOUCH, "Gesture %d at X=%d, Y=%d", event->type, event->x, event->y);
+    
+    switch (event->type) {
+        case GESTURE_DRAG:
+            if (app_state.mode == MODE_PREVIEW && (preview.dragging || event->x < PREVIEW_VIEW_WIDTH)) {
+                preview_drag(event);
+            }
+            return;
+        
+        case GESTURE_SWIPE:
+            if (app_state.mode == MODE_PREVIEW) {
+                preview_drag_end(event);
+                // Flick: continue by half a page in the direction of travel
+                if (event->direction == GESTURE_LEFT) {
+                    preview_scroll_to(preview.offset + PREVIEW_SCROLL_PAGE);
+                } else if (event->direction == GESTURE_RIGHT) {
+                    preview_scroll_to(preview.offset > PREVIEW_SCROLL_PAGE ? preview.offset - PREVIEW_SCROLL_PAGE : 0);
+                }
+                return;
+            }
+            if (app_state.mode == MODE_EDIT_KEYBOARD &&
+                (event->direction == GESTURE_LEFT || event->direction == GESTURE_RIGHT)) {
+                ESP_LOGI(TAG, "Keyboard swipe - switching page");
+                cycle_keyboard_page(event->direction == GESTURE_LEFT);
+                draw_keyboard();
+                return;
+            }
+            break;
+        
+        case GESTURE_DRAG_END:
+            if (app_state.mode == MODE_PREVIEW) {
+                preview_drag_end(event);
+                return;     // The drag already scrolled; ending it over the strip is not a press
+            }
+            break;
+        
+        default:
+            break;
+    }
+    
+    dispatch_touch((uint16_t)event->x, (uint16_t)event->y, event->duration_ms);
+}
+
+/**
+ * Dispatch a touch at a screen position to the current mode's handler
+ */
+static void dispatch_touch(uint16_t screen_x, uint16_t screen_y, uint32_t press_duration)
+{
+    DLOGD(TOUCH, "Touch at screen coordinates: X=%d, Y=%d", screen_x, screen_y);
+    
+    switch (app_state.mode) {
+        case MODE_PLAYBACK:
+            handle_playback_touch(screen_x, screen_y, press_duration);
+            break;
+        
+        case MODE_CONFIG:
+            handle_config_touch(screen_x, screen_y);
+            break;
+        
+        case MODE_EDIT_KEYBOARD:
+            handle_keyboard_touch(screen_x, screen_y);
+            break;
+        
+        case MODE_BT_CONFIG:
+            handle_bt_config_touch(screen_x, screen_y);
+            break;
+        
+        case MODE_DIAGNOSTICS:
+            handle_diagnostics_touch(screen_x, screen_y);
+            break;
+        
+        case MODE_PREVIEW:
+            handle_preview_touch(screen_x, screen_y);
+            break;
+        
+        default:
+            break;
     }
 }
 
@@ -2636,10 +5297,16 @@ static void ui_task(void *pvParameters)
 {
     ESP_LOGI(TAG, "UI task started");
     
+    // Wait for the boot jobs the first screen depends on (BLE is not needed to draw)
+    xEventGroupWaitBits(boot_events, BOOT_BIT_STORAGE | BOOT_BIT_DISPLAY,
+                        pdFALSE, pdTRUE, portMAX_DELAY);
+    boot_trace_mark("ui: dependencies ready");
+    
     // Check if we should run display test
     if (app_state.mode == MODE_DISPLAY_TEST) {
-        ESP_LOGI(TAG, "Running display test sequence...");
-        run_display_test();
+        int stage = boot_trace_begin("ui: display self-test");
+        run_startup_selftest();
+        boot_trace_end(stage);
         
         // After test completes, check if calibration is needed
         if (!app_state.calibration.is_calibrated) {
@@ -2660,31 +5327,500 @@ static void ui_task(void *pvParameters)
         // Draw initial screen based on current mode
         draw_main_screen();
     }
-    
-    uint32_t last_update = 0;
+    boot_trace_mark("ui: first screen");
+    xEventGroupSetBits(boot_events, BOOT_BIT_UI);
+    boot_trace_print_summary();
     
     while (1) {
         uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        TickType_t wait = portMAX_DELAY;
+        
+        // Report completed/failed background flash writes
+        storage_process_events();
         
         // Check for selection timeout (5 seconds)
         if (app_state.selected_macro >= 0 && app_state.send_button_visible) {
-            if (now - app_state.selection_time > SELECTION_TIMEOUT_MS) {
+            uint32_t elapsed = now - app_state.selection_time;
+            if (elapsed > SELECTION_TIMEOUT_MS) {
                 ESP_LOGI(TAG, "Selection timeout, clearing");
-                app_state.selected_macro = -1;
-                app_state.send_button_visible = false;
-                draw_main_screen();
+                set_macro_selection(-1);
+            } else {
+                wait = pdMS_TO_TICKS(SELECTION_TIMEOUT_MS - elapsed + 1);
             }
         }
         
-        // Redraw screen periodically if needed
-        if (now - last_update > 1000) {
-            // Update BLE status or other dynamic elements if needed
-            // For now, just update timestamp
-            last_update = now;
+        // No periodic wakeup: sleep until the timeout, a storage event or a new selection
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+// =============================================================================
+// CONSOLE COMMANDS
+// =============================================================================
+
+/**
+ * "boot" - print the boot trace summary
+ */
+static int cmd_boot(int argc, char **argv)
+{
+    boot_trace_print_summary();
+    return 0;
+}
+
+/**
+ * "perf [reset]" - print or clear the performance counters
+ */
+static int cmd_perf(int argc, char **argv)
+{
+    if (argc >= 2 && strcmp(argv[1], "reset") == 0) {
+        memset(&perf_counters, 0, sizeof(perf_counters));
+        printf("Performance counters cleared\n");
+        return 0;
+    }
+    
+    perf_print_report();
+    return 0;
+}
+
+/**
+ * "latency [reset]" - print or clear the touch-to-pixel latency report
+ */
+static int cmd_latency(int argc, char **argv)
+{
+    if (argc >= 2 && strcmp(argv[1], "reset") == 0) {
+        latency_reset(&touch_latency);
+        printf("Latency statistics cleared\n");
+        return 0;
+    }
+    
+    latency_print_report(&touch_latency, app_mode_names, APP_MODE_COUNT);
+    return 0;
+}
+
+/**
+ * "icons [runs]" - benchmark icon decode and blit against raw RGB565
+ *
+ * Draws into the top-left corner of the screen; the next redraw restores it.
+ */
+static int cmd_icons(int argc, char **argv)
+{
+    const icon_t *icon = &icon_keyboard;
+    uint32_t pixels = (uint32_t)icon->width * icon->height;
+    int runs = (argc >= 2) ? atoi(argv[1]) : ICON_BENCH_RUNS;
+    if (runs <= 0) {
+        printf("Usage: icons [runs]\n");
+        return 1;
+    }
+    if (display_spi == NULL || pixel_band_mutex == NULL) {
+        printf("Display not initialized\n");
+        return 1;
+    }
+    
+    // Raw reference copy of the same pixels, as a flash RGB565 image would be sent
+    uint16_t *raw = heap_caps_malloc(pixels * 2, MALLOC_CAP_DMA);
+    uint16_t *scratch = heap_caps_malloc(ICON_CHUNK_PIXELS * 2, MALLOC_CAP_DMA);
+    if (raw == NULL || scratch == NULL) {
+        printf("Out of DMA memory\n");
+        heap_caps_free(raw);
+        heap_caps_free(scratch);
+        return 1;
+    }
+    icon_decoder_t dec;
+    icon_decode_begin(&dec, icon, COLOR_BLACK);
+    icon_decode(&dec, raw, pixels);
+    
+    // Decode only (CPU cost of the compression)
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < runs; i++) {
+        icon_decode_begin(&dec, icon, COLOR_BLACK);
+        while (icon_decode(&dec, scratch, ICON_CHUNK_PIXELS) > 0) {
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(100)); // 10Hz update rate
     }
+    int64_t decode_us = esp_timer_get_time() - start;
+    
+    // Decode + blit through the ping-pong band
+    start = esp_timer_get_time();
+    for (int i = 0; i < runs; i++) {
+        ili9341_draw_icon(0, 0, icon, COLOR_BLACK);
+    }
+    int64_t blit_us = esp_timer_get_time() - start;
+    
+    // Raw RGB565 blit of the same area
+    start = esp_timer_get_time();
+    for (int i = 0; i < runs; i++) {
+        display_bus_lock();
+        ili9341_set_addr_window(0, 0, icon->width - 1, icon->height - 1);
+        ili9341_send_data((const uint8_t *)raw, pixels * 2);
+        display_bus_unlock();
+    }
+    int64_t raw_us = esp_timer_get_time() - start;
+    
+    heap_caps_free(raw);
+    heap_caps_free(scratch);
+    
+    printf("Icon %ux%u, %d runs: %lu bytes compressed, %lu bytes raw\n",
+           icon->width, icon->height, runs, (unsigned long)icon->data_size, (unsigned long)(pixels * 2));
+    printf("  decode only:   %6lu us/icon  %6lu kpixel/s\n",
+           (unsigned long)(decode_us / runs), (unsigned long)((int64_t)pixels * runs * 1000 / (decode_us ? decode_us : 1)));
+    printf("  decode + blit: %6lu us/icon  %6lu kpixel/s\n",
+           (unsigned long)(blit_us / runs), (unsigned long)((int64_t)pixels * runs * 1000 / (blit_us ? blit_us : 1)));
+    printf("  raw blit:      %6lu us/icon  %6lu kpixel/s\n",
+           (unsigned long)(raw_us / runs), (unsigned long)((int64_t)pixels * runs * 1000 / (raw_us ? raw_us : 1)));
+    return 0;
+}
+
+/**
+ * "touch [runs]" - compare XPT2046 reads as separate transactions and as one burst
+ *
+ * Both read the same conversions (pressure and TOUCH_BURST_SAMPLES per axis).
+ */
+static int cmd_touch(int argc, char **argv)
+{
+    uint8_t commands[1 + 2 * TOUCH_BURST_SAMPLES];
+    uint16_t values[1 + 2 * TOUCH_BURST_SAMPLES];
+    int count = xpt2046_touch_commands(TOUCH_BURST_SAMPLES, commands);
+    int runs = (argc >= 2) ? atoi(argv[1]) : TOUCH_BENCH_RUNS;
+    if (runs <= 0) {
+        printf("Usage: touch [runs]\n");
+        return 1;
+    }
+    if (touch_spi == NULL) {
+        printf("Touch not initialized\n");
+        return 1;
+    }
+    
+    // The bench's conversions pull PENIRQ low and wake the touch task; holding
+    // the bus makes its read wait until the bench is done
+    xSemaphoreTakeRecursive(touch_bus_mutex, portMAX_DELAY);
+    
+    // One 3-byte transaction per conversion
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < runs; i++) {
+        for (int c = 0; c < count; c++) {
+            xpt2046_burst(&commands[c], 1, &values[c]);
+        }
+    }
+    int64_t single_us = esp_timer_get_time() - start;
+    
+    // All conversions chained into one transaction
+    start = esp_timer_get_time();
+    for (int i = 0; i < runs; i++) {
+        xpt2046_burst(commands, count, values);
+    }
+    int64_t burst_us = esp_timer_get_time() - start;
+    xSemaphoreGiveRecursive(touch_bus_mutex);
+    
+    printf("XPT2046 on HSPI, %d conversions per sample, %d runs:\n", count, runs);
+    printf("  separate: %3d bytes %6lu us/sample  %5lu samples/s  %6lu conversions/s\n",
+           3 * count, (unsigned long)(single_us / runs),
+           (unsigned long)(runs * 1000000LL / (single_us ? single_us : 1)),
+           (unsigned long)(runs * count * 1000000LL / (single_us ? single_us : 1)));
+    printf("  burst:    %3d bytes %6lu us/sample  %5lu samples/s  %6lu conversions/s\n",
+           XPT2046_BURST_BYTES(count), (unsigned long)(burst_us / runs),
+           (unsigned long)(runs * 1000000LL / (burst_us ? burst_us : 1)),
+           (unsigned long)(runs * count * 1000000LL / (burst_us ? burst_us : 1)));
+    return 0;
+}
+
+/**
+ * "power [reset]" - power state residency and the modeled average current
+ */
+static int cmd_power(int argc, char **argv)
+{
+    uint64_t now = esp_timer_get_time();
+    
+    if (argc >= 2 && strcmp(argv[1], "reset") == 0) {
+        portENTER_CRITICAL(&power_lock);
+        power_residency_reset(&power_residency, power_residency.state, now);
+        portEXIT_CRITICAL(&power_lock);
+        printf("Power residency cleared\n");
+        return 0;
+    }
+    
+    power_residency_t res;
+    portENTER_CRITICAL(&power_lock);
+    res = power_residency;
+    portEXIT_CRITICAL(&power_lock);
+    
+    uint64_t time_us[POWER_STATE_COUNT], total_us = 0;
+    power_residency_snapshot(&res, now, time_us);
+    for (int i = 0; i < POWER_STATE_COUNT; i++) {
+        total_us += time_us[i];
+    }
+    
+#ifdef CONFIG_PM_ENABLE
+    printf("Automatic light sleep: enabled\n");
+#else
+    printf("Automatic light sleep: disabled (CONFIG_PM_ENABLE not set)\n");
+#endif
+    printf("Residency over %llu s (currents are per-state estimates, not measurements):\n", (unsigned long long)(total_us / 1000000));
+    for (int i = 0; i < POWER_STATE_COUNT; i++) {
+        printf("  %-8s %10llu ms %5lu.%lu%% %4lu mA%s\n", power_state_names[i],
+               (unsigned long long)(time_us[i] / 1000),
+               (unsigned long)(total_us ? time_us[i] * 100 / total_us : 0),
+               (unsigned long)(total_us ? time_us[i] * 1000 / total_us % 10 : 0),
+               (unsigned long)(power_state_ua[i] / 1000), (i == (int)res.state) ? "  <- now" : "");
+    }
+    
+    // HID stays out of "in use" until the HID transport sends real reports (BLE is a stub)
+    uint32_t in_use = power_residency_average_ua(&res, now, power_state_ua, 1u << POWER_ACTIVE);
+    uint32_t idle = power_residency_average_ua(&res, now, power_state_ua, (1u << POWER_DIMMED) | (1u << POWER_ASLEEP));
+    uint32_t overall = power_residency_average_ua(&res, now, power_state_ua, (1u << POWER_STATE_COUNT) - 1);
+    printf("Modeled average current: %lu.%lu mA in use (active), %lu.%lu mA idle (dimmed, asleep), %lu.%lu mA overall\n",
+           (unsigned long)(in_use / 1000), (unsigned long)(in_use % 1000 / 100),
+           (unsigned long)(idle / 1000), (unsigned long)(idle % 1000 / 100),
+           (unsigned long)(overall / 1000), (unsigned long)(overall % 1000 / 100));
+#ifdef CONFIG_PM_PROFILING
+    esp_pm_dump_locks(stdout);
+#endif
+    return 0;
+}
+
+/**
+ * Core column text for the "mem" and "cpu" reports
+ */
+static const char *core_name(BaseType_t core)
+{
+    return (core == 0) ? "0" : (core == 1) ? "1" : "any";
+}
+
+#if defined(CONFIG_FREERTOS_USE_TRACE_FACILITY) && defined(CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
+/**
+ * Copy every task's run-time counter, core and idle flag into a snapshot
+ * (console task only: the status array is static)
+ */
+static bool cpu_load_take(cpu_load_snapshot_t *snapshot)
+{
+    static TaskStatus_t status[CPU_LOAD_MAX_TASKS];
+    uint32_t total = 0;
+    UBaseType_t count = uxTaskGetSystemState(status, CPU_LOAD_MAX_TASKS, &total);
+    if (count == 0) {
+        return false;       // More tasks than CPU_LOAD_MAX_TASKS
+    }
+    
+    snapshot->total_run_time = total;
+    snapshot->count = (int)count;
+    for (UBaseType_t i = 0; i < count; i++) {
+        cpu_load_task_t *task = &snapshot->tasks[i];
+        BaseType_t core = xTaskGetAffinity(status[i].xHandle);
+        task->id = status[i].xTaskNumber;
+        strncpy(task->name, status[i].pcTaskName, CPU_LOAD_NAME_LEN - 1);
+        task->name[CPU_LOAD_NAME_LEN - 1] = '\0';
+        task->core = (core == 0 || core == 1) ? (int8_t)core : CPU_LOAD_NO_CORE;
+        task->idle = (task->core != CPU_LOAD_NO_CORE) &&
+                     (status[i].xHandle == xTaskGetIdleTaskHandleForCPU(task->core));
+        task->run_time = status[i].ulRunTimeCounter;
+    }
+    return true;
+}
+#endif
+
+/**
+ * "cpu [ms]" - per-core load and per-task share over a sampling window
+ *
+ * Checks the core affinity plan: with pinning on, Bluetooth and hid_task
+ * should only load the radio core and touch/UI rendering the app core.
+ */
+static int cmd_cpu(int argc, char **argv)
+{
+#if defined(CONFIG_FREERTOS_USE_TRACE_FACILITY) && defined(CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
+    // Static: about 2 KB, and only the console task runs this
+    static cpu_load_snapshot_t before, after;
+    static cpu_load_t load;
+    int window_ms = (argc >= 2) ? atoi(argv[1]) : CPU_LOAD_SAMPLE_MS;
+    if (window_ms <= 0) {
+        printf("Usage: cpu [ms]\n");
+        return 1;
+    }
+    
+    if (!cpu_load_take(&before)) {
+        printf("More than %d tasks, raise CPU_LOAD_MAX_TASKS\n", CPU_LOAD_MAX_TASKS);
+        return 1;
+    }
+    vTaskDelay(pdMS_TO_TICKS(window_ms));
+    if (!cpu_load_take(&after) || !cpu_load_compute(&before, &after, &load)) {
+        printf("No run time measured\n");
+        return 1;
+    }
+    
+#ifdef CONFIG_KEYBOT_PIN_TASKS
+    printf("CPU load over %d ms (radio core %d, app core %d):\n", window_ms, RADIO_CORE, APP_CORE);
+#else
+    printf("CPU load over %d ms (tasks not pinned):\n", window_ms);
+#endif
+    for (int c = 0; c < CPU_LOAD_CORES; c++) {
+        if (load.core_permille[c] != CPU_LOAD_UNKNOWN) {
+            printf("  core %d: %3u.%u%%\n", c, load.core_permille[c] / 10, load.core_permille[c] % 10);
+        }
+    }
+    printf("  %-16s %4s %7s\n", "task", "core", "load");
+    for (int i = 0; i < load.count; i++) {
+        const cpu_load_entry_t *task = &load.tasks[i];
+        printf("  %-16s %4s %3u.%u%%\n", task->name,
+               core_name(task->core == CPU_LOAD_NO_CORE ? tskNO_AFFINITY : task->core),
+               task->permille / 10, task->permille % 10);
+    }
+    return 0;
+#else
+    printf("Needs CONFIG_FREERTOS_USE_TRACE_FACILITY and CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS\n");
+    return 1;
+#endif
+}
+
+/**
+ * "mem" - heap headroom, static buffer sizes and per-task stack high-water marks
+ *
+ * The long-lived tasks, queues, mutexes and DMA buffers are all static, so the
+ * heap figures only move with ESP-IDF's own allocations (Wi-Fi/BT, console).
+ * A task whose unused stack drops below TASK_STACK_MARGIN is flagged.
+ */
+static int cmd_mem(int argc, char **argv)
+{
+    printf("Heap: %lu free, %lu minimum ever, %lu largest block\n",
+           (unsigned long)esp_get_free_heap_size(), (unsigned long)esp_get_minimum_free_heap_size(),
+           (unsigned long)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+    printf("DMA:  %lu free, %lu minimum ever, %lu largest block\n",
+           (unsigned long)heap_caps_get_free_size(MALLOC_CAP_DMA),
+           (unsigned long)heap_caps_get_minimum_free_size(MALLOC_CAP_DMA),
+           (unsigned long)heap_caps_get_largest_free_block(MALLOC_CAP_DMA));
+    
+    uint32_t stacks = 0;
+    for (int i = 0; i < task_record_count; i++) {
+        stacks += task_records[i].stack_bytes;
+    }
+    printf("Static buffers: render bands %u, pixel band %u, fill run %u, display lists %u, task stacks %lu\n",
+           (unsigned)sizeof(render_bands), (unsigned)sizeof(pixel_band), (unsigned)sizeof(fill_buffer),
+           (unsigned)sizeof(screen_lists), (unsigned long)stacks);
+    
+    printf("  %-14s %4s %6s %6s %6s\n", "task", "core", "stack", "used", "free");
+    for (int i = 0; i < task_record_count; i++) {
+        const task_record_t *task = &task_records[i];
+        // High-water mark is in StackType_t units, which are bytes on ESP-IDF
+        uint32_t free_bytes = uxTaskGetStackHighWaterMark(task->handle) * sizeof(StackType_t);
+        printf("  %-14s %4s %6lu %6lu %6lu%s\n", task->name, core_name(task->core), (unsigned long)task->stack_bytes,
+               (unsigned long)(task->stack_bytes - free_bytes), (unsigned long)free_bytes,
+               (free_bytes < TASK_STACK_MARGIN) ? "  <- below margin" : "");
+    }
+    return 0;
+}
+
+/**
+ * "selftest [always|first|never]" - show or set the startup self-test mode
+ */
+static int cmd_selftest(int argc, char **argv)
+{
+    static const char *mode_names[] = {"always", "first", "never"};
+    
+    if (argc < 2) {
+        printf("Self-test mode: %s\n", mode_names[app_state.boot_options.selftest_mode]);
+        return 0;
+    }
+    
+    for (int i = 0; i <= SELFTEST_NEVER; i++) {
+        if (strcmp(argv[1], mode_names[i]) == 0) {
+            app_state.boot_options.selftest_mode = (uint8_t)i;
+            storage_submit_boot_options();
+            printf("Self-test mode set to: %s\n", mode_names[i]);
+            return 0;
+        }
+    }
+    
+    printf("Usage: selftest [always|first|never]\n");
+    return 1;
+}
+
+/**
+ * Start the UART console REPL and register diagnostic commands
+ */
+static void init_console(void)
+{
+    esp_console_repl_t *repl = NULL;
+    esp_console_repl_config_t repl_config = ESP_CONSOLE_REPL_CONFIG_DEFAULT();
+    repl_config.prompt = "keybot>";
+    
+    esp_console_dev_uart_config_t uart_config = ESP_CONSOLE_DEV_UART_CONFIG_DEFAULT();
+    esp_err_t ret = esp_console_new_repl_uart(&uart_config, &repl_config, &repl);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Console init failed: %s", esp_err_to_name(ret));
+        return;
+    }
+    
+    esp_console_register_help_command();
+    
+    const esp_console_cmd_t boot_cmd = {
+        .command = "boot",
+        .help = "Print boot stage timings (sorted by duration)",
+        .hint = NULL,
+        .func = &cmd_boot,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&boot_cmd));
+    
+    const esp_console_cmd_t selftest_cmd = {
+        .command = "selftest",
+        .help = "Show or set the startup display self-test mode",
+        .hint = "[always|first|never]",
+        .func = &cmd_selftest,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&selftest_cmd));
+    
+    const esp_console_cmd_t perf_cmd = {
+        .command = "perf",
+        .help = "Print hot-path performance counters, or clear them with 'reset'",
+        .hint = "[reset]",
+        .func = &cmd_perf,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&perf_cmd));
+    
+    const esp_console_cmd_t latency_cmd = {
+        .command = "latency",
+        .help = "Print touch-to-pixel latency per UI mode, or clear it with 'reset'",
+        .hint = "[reset]",
+        .func = &cmd_latency,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&latency_cmd));
+    
+    const esp_console_cmd_t icons_cmd = {
+        .command = "icons",
+        .help = "Benchmark compressed icon decode + blit against raw RGB565",
+        .hint = "[runs]",
+        .func = &cmd_icons,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&icons_cmd));
+    
+    const esp_console_cmd_t touch_cmd = {
+        .command = "touch",
+        .help = "Benchmark XPT2046 reads: one transaction per conversion against one burst",
+        .hint = "[runs]",
+        .func = &cmd_touch,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&touch_cmd));
+    
+    const esp_console_cmd_t power_cmd = {
+        .command = "power",
+        .help = "Print power state residency and estimated average current, or clear it with 'reset'",
+        .hint = "[reset]",
+        .func = &cmd_power,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&power_cmd));
+    
+    const esp_console_cmd_t mem_cmd = {
+        .command = "mem",
+        .help = "Print heap headroom, static buffer sizes and task stack high-water marks",
+        .hint = NULL,
+        .func = &cmd_mem,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&mem_cmd));
+    
+    const esp_console_cmd_t cpu_cmd = {
+        .command = "cpu",
+        .help = "Print per-core CPU load and each task's share over a window (default 1000 ms)",
+        .hint = "[ms]",
+        .func = &cmd_cpu,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cpu_cmd));
+    
+    ESP_ERROR_CHECK(esp_console_start_repl(repl));
+    ESP_LOGI(TAG, "Console started (type 'help' for commands)");
 }
 
 // =============================================================================
@@ -2757,14 +5893,6 @@ static void reset_selection(void)
  * - "Display: Configuring control pins..."
  * - "Display: Adding SPI device..."
  * - "Display: Performing hardware reset..."
- * - "Display: Sending software reset command..."
- * - "Display: Configuring power control..."
- * - "Display: Setting power levels..."
- * - "Display: Setting orientation (landscape)..."
- * - "Display: Setting pixel format (RGB565)..."
- * - "Display: Configuring frame rate..."
- * - "Display: Configuring gamma correction..."
- * - "Display: Clearing screen to black..."
- * - "Display: Turning on display..."
+ * - "Display: ILI9341 init sequence sent (21 commands)"
  * - "Display: ILI9341 initialization complete!"
  */
@@ -0,0 +1,78 @@
+/*
+ * perf_stats.c - Fixed-size performance statistics
+ *
+ * See perf_stats.h.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "perf_stats.h"
+
+void perf_stat_reset(perf_stat_t *stat)
+{
+    memset(stat, 0, sizeof(*stat));
+}
+
+void perf_stat_record(perf_stat_t *stat, uint32_t value)
+{
+    if (stat->count == 0 || value < stat->min) {
+        stat->min = value;
+    }
+    if (value > stat->max) {
+        stat->max = value;
+    }
+    stat->count++;
+    stat->sum += value;
+    stat->hist[perf_stat_bucket(value)]++;
+}
+
+uint32_t perf_stat_avg(const perf_stat_t *stat)
+{
+    if (stat->count == 0) {
+        return 0;
+    }
+    return (uint32_t)(stat->sum / stat->count);
+}
+
+int perf_stat_bucket(uint32_t value)
+{
+    if (value < 64) {
+        return 0;
+    }
+
+    // Buckets are powers of 4 starting at 64: floor(log2(value)) 6-7 -> 1, 8-9 -> 2, ...
+    int log2 = 31 - __builtin_clz(value);
+    int bucket = (log2 - 6) / 2 + 1;
+    return (bucket < PERF_HIST_BUCKETS) ? bucket : PERF_HIST_BUCKETS - 1;
+}
+
+uint32_t perf_stat_bucket_limit(int bucket)
+{
+    if (bucket >= PERF_HIST_BUCKETS - 1) {
+        return UINT32_MAX;
+    }
+    return 64u << (2 * bucket);
+}
+
+void perf_stat_print(const char *name, const perf_stat_t *stat)
+{
+    if (stat->count == 0) {
+        printf("  %-16s no samples\n", name);
+        return;
+    }
+
+    printf("  %-16s n=%lu min=%lu avg=%lu max=%lu us\n", name,
+           (unsigned long)stat->count, (unsigned long)stat->min,
+           (unsigned long)perf_stat_avg(stat), (unsigned long)stat->max);
+    printf("  %-16s", "");
+    for (int i = 0; i < PERF_HIST_BUCKETS; i++) {
+        uint32_t limit = perf_stat_bucket_limit(i);
+        if (limit == UINT32_MAX) {
+            printf(" >=%lu:%lu", (unsigned long)perf_stat_bucket_limit(i - 1),
+                   (unsigned long)stat->hist[i]);
+        } else {
+            printf(" <%lu:%lu", (unsigned long)limit, (unsigned long)stat->hist[i]);
+        }
+    }
+    printf("\n");
+}
@@ -0,0 +1,57 @@
+/*
+ * perf_stats.h - Fixed-size performance statistics
+ *
+ * A perf_stat_t accumulates samples (normally microseconds) into count, min,
+ * max, sum and a log4 histogram. Recording is a few integer operations with
+ * no allocation or locking, so it can be called on every hot path.
+ *
+ * Plain C with no ESP-IDF dependencies so the unit test app can link it.
+ */
+
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <stdint.h>
+
+// Histogram buckets (us): <64, <256, <1k, <4k, <16k, <64k, <256k, >=256k
+#define PERF_HIST_BUCKETS   8
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;                       // Valid only when count > 0
+    uint32_t max;
+    uint64_t sum;
+    uint32_t hist[PERF_HIST_BUCKETS];
+} perf_stat_t;
+
+/**
+ * Clear all samples (a zero-initialized perf_stat_t is already reset)
+ */
+void perf_stat_reset(perf_stat_t *stat);
+
+/**
+ * Add one sample
+ */
+void perf_stat_record(perf_stat_t *stat, uint32_t value);
+
+/**
+ * Mean of all samples, 0 if there are none
+ */
+uint32_t perf_stat_avg(const perf_stat_t *stat);
+
+/**
+ * Histogram bucket index (0 to PERF_HIST_BUCKETS - 1) for a value
+ */
+int perf_stat_bucket(uint32_t value);
+
+/**
+ * Exclusive upper bound of a bucket, UINT32_MAX for the last one
+ */
+uint32_t perf_stat_bucket_limit(int bucket);
+
+/**
+ * Print a statistic and its histogram to stdout (two lines, indented)
+ */
+void perf_stat_print(const char *name, const perf_stat_t *stat);
+
+#endif // PERF_STATS_H
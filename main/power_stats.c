@@ -0,0 +1,73 @@
+/*
+ * power_stats.c - Power state residency and modeled average current
+ *
+ * See power_stats.h.
+ */
+
+#include <string.h>
+#include "power_stats.h"
+
+void power_residency_reset(power_residency_t *res, power_state_t state, uint64_t now_us)
+{
+    memset(res, 0, sizeof(*res));
+    res->state = state;
+    res->resume = state;
+    res->since_us = now_us;
+}
+
+static void switch_state(power_residency_t *res, power_state_t state, uint64_t now_us)
+{
+    if (now_us > res->since_us) {
+        res->time_us[res->state] += now_us - res->since_us;
+    }
+    res->state = state;
+    res->since_us = now_us;
+}
+
+power_state_t power_residency_enter(power_residency_t *res, power_state_t state, uint64_t now_us)
+{
+    power_state_t previous = res->state;
+
+    if (previous == POWER_HID && state != POWER_HID) {
+        res->resume = state;
+        return previous;
+    }
+    if (state == POWER_HID && previous != POWER_HID) {
+        res->resume = previous;
+    }
+    switch_state(res, state, now_us);
+    return previous;
+}
+
+power_state_t power_residency_leave_hid(power_residency_t *res, uint64_t now_us)
+{
+    if (res->state == POWER_HID) {
+        switch_state(res, res->resume, now_us);
+    }
+    return res->state;
+}
+
+void power_residency_snapshot(const power_residency_t *res, uint64_t now_us, uint64_t time_us[POWER_STATE_COUNT])
+{
+    memcpy(time_us, res->time_us, sizeof(res->time_us));
+    if (now_us > res->since_us) {
+        time_us[res->state] += now_us - res->since_us;
+    }
+}
+
+uint32_t power_residency_average_ua(const power_residency_t *res, uint64_t now_us,
+                                    const uint32_t current_ua[POWER_STATE_COUNT], uint32_t mask)
+{
+    uint64_t time_us[POWER_STATE_COUNT];
+    uint64_t total_us = 0;
+    double charge = 0;      // uA * us
+
+    power_residency_snapshot(res, now_us, time_us);
+    for (int i = 0; i < POWER_STATE_COUNT; i++) {
+        if (mask & (1u << i)) {
+            total_us += time_us[i];
+            charge += (double)current_ua[i] * time_us[i];
+        }
+    }
+    return total_us ? (uint32_t)(charge / total_us + 0.5) : 0;
+}
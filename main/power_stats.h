@@ -0,0 +1,70 @@
+/*
+ * power_stats.h - Power state residency and modeled average current
+ *
+ * The firmware cannot measure its supply current, but it knows which power
+ * state it is in: display on, dimmed, asleep, sending HID reports. Time spent
+ * in each state is accumulated, and weighting it by a per-state current
+ * (a table of estimates, to be replaced with bench measurements of the unit)
+ * gives a modeled average current over any window, e.g. idle on the desk
+ * versus typing macros. It is only as good as that table.
+ *
+ * POWER_HID overlays the display states: entering it remembers the state it
+ * interrupted, a display state entered meanwhile (the panel dimming while a
+ * macro is typed) replaces the remembered one instead of ending HID, and
+ * power_residency_leave_hid() returns to it.
+ *
+ * Timestamps are plain microsecond counters supplied by the caller, so the
+ * unit tests replay scripted sequences and get the same report as the device.
+ */
+
+#ifndef POWER_STATS_H
+#define POWER_STATS_H
+
+#include <stdint.h>
+
+typedef enum {
+    POWER_ACTIVE,           // Display on at full brightness, CPU awake
+    POWER_DIMMED,           // Display on, backlight dimmed
+    POWER_ASLEEP,           // Backlight off, panel asleep, CPU in light sleep if enabled
+    POWER_HID,              // Sending HID reports over the radio
+    POWER_STATE_COUNT
+} power_state_t;
+
+typedef struct {
+    power_state_t state;
+    power_state_t resume;                       // While in POWER_HID: display state to return to
+    uint64_t since_us;                          // Entry into the current state
+    uint64_t time_us[POWER_STATE_COUNT];        // Completed residency per state
+} power_residency_t;
+
+/**
+ * Start counting from now in the given state, with all residency cleared
+ */
+void power_residency_reset(power_residency_t *res, power_state_t state, uint64_t now_us);
+
+/**
+ * Switch state; the time since the last switch goes to the state left.
+ * Returns the state before the call. While in POWER_HID a display state is
+ * only remembered for power_residency_leave_hid().
+ */
+power_state_t power_residency_enter(power_residency_t *res, power_state_t state, uint64_t now_us);
+
+/**
+ * End POWER_HID: switch to the display state it interrupted (or the one
+ * entered meanwhile) and return it; no change if not in POWER_HID
+ */
+power_state_t power_residency_leave_hid(power_residency_t *res, uint64_t now_us);
+
+/**
+ * Residency per state up to now, including the current state's open interval
+ */
+void power_residency_snapshot(const power_residency_t *res, uint64_t now_us, uint64_t time_us[POWER_STATE_COUNT]);
+
+/**
+ * Time-weighted average current (uA) of the states selected by mask (bit per
+ * power_state_t), with current_ua[] per state; 0 if no time was spent in them
+ */
+uint32_t power_residency_average_ua(const power_residency_t *res, uint64_t now_us,
+                                    const uint32_t current_ua[POWER_STATE_COUNT], uint32_t mask);
+
+#endif // POWER_STATS_H
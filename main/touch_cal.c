@@ -0,0 +1,127 @@
+/*
+ * touch_cal.c - Affine touch calibration (least-squares fit, Q16 mapping)
+ *
+ * See touch_cal.h.
+ */
+
+#include <math.h>
+#include "touch_cal.h"
+
+// Reject fits whose raw points are this close to a line (1 - correlation^2)
+#define TOUCH_CAL_MIN_SPREAD    0.01
+
+// Smallest raw span accepted by touch_cal_from_ranges()
+#define TOUCH_CAL_MIN_RANGE     256
+
+/**
+ * Least-squares a, b, c for target = a * u + b * v + c over centered raw
+ * coordinates (sum u = sum v = 0, so c is just the mean of the targets)
+ */
+static void fit_axis(double suu, double suv, double svv, double det,
+                     double sut, double svt, double mean_t,
+                     double *a, double *b, double *c)
+{
+    *a = (sut * svv - svt * suv) / det;
+    *b = (svt * suu - sut * suv) / det;
+    *c = mean_t;
+}
+
+static bool to_q16(double value, long limit, int32_t *out)
+{
+    double scaled = value * (1L << TOUCH_CAL_SHIFT);
+    if (!(fabs(scaled) < (double)limit)) {
+        return false;       // Also rejects NaN
+    }
+    *out = (int32_t)lround(scaled);
+    return true;
+}
+
+bool touch_cal_fit(const touch_cal_point_t *points, int count,
+                   touch_cal_matrix_t *matrix, touch_cal_residual_t *residual)
+{
+    if (count < TOUCH_CAL_MIN_POINTS || count > TOUCH_CAL_MAX_POINTS) {
+        return false;
+    }
+
+    // Center the raw coordinates so the normal equations stay well conditioned
+    double mean_u = 0, mean_v = 0, mean_x = 0, mean_y = 0;
+    for (int i = 0; i < count; i++) {
+        mean_u += points[i].raw_x;
+        mean_v += points[i].raw_y;
+        mean_x += points[i].screen_x;
+        mean_y += points[i].screen_y;
+    }
+    mean_u /= count;
+    mean_v /= count;
+    mean_x /= count;
+    mean_y /= count;
+
+    double suu = 0, suv = 0, svv = 0, sux = 0, svx = 0, suy = 0, svy = 0;
+    for (int i = 0; i < count; i++) {
+        double u = points[i].raw_x - mean_u;
+        double v = points[i].raw_y - mean_v;
+        suu += u * u;
+        suv += u * v;
+        svv += v * v;
+        sux += u * points[i].screen_x;
+        svx += v * points[i].screen_x;
+        suy += u * points[i].screen_y;
+        svy += v * points[i].screen_y;
+    }
+
+    double det = suu * svv - suv * suv;
+    if (suu <= 0 || svv <= 0 || det <= TOUCH_CAL_MIN_SPREAD * suu * svv) {
+        return false;
+    }
+
+    double a, b, c, d, e, f;
+    fit_axis(suu, suv, svv, det, sux, svx, mean_x, &a, &b, &c);
+    fit_axis(suu, suv, svv, det, suy, svy, mean_y, &d, &e, &f);
+
+    // Back from centered coordinates to raw ones
+    c -= a * mean_u + b * mean_v;
+    f -= d * mean_u + e * mean_v;
+
+    touch_cal_matrix_t fitted;
+    if (!to_q16(a, TOUCH_CAL_COEF_LIMIT, &fitted.a) || !to_q16(b, TOUCH_CAL_COEF_LIMIT, &fitted.b) ||
+        !to_q16(c, TOUCH_CAL_OFFSET_LIMIT, &fitted.c) || !to_q16(d, TOUCH_CAL_COEF_LIMIT, &fitted.d) ||
+        !to_q16(e, TOUCH_CAL_COEF_LIMIT, &fitted.e) || !to_q16(f, TOUCH_CAL_OFFSET_LIMIT, &fitted.f)) {
+        return false;
+    }
+    *matrix = fitted;
+
+    if (residual) {
+        double sum_sq = 0, max_sq = 0;
+        for (int i = 0; i < count; i++) {
+            int32_t x, y;
+            touch_cal_apply(&fitted, points[i].raw_x, points[i].raw_y, &x, &y);
+            double dx = x - points[i].screen_x;
+            double dy = y - points[i].screen_y;
+            double sq = dx * dx + dy * dy;
+            sum_sq += sq;
+            if (sq > max_sq) {
+                max_sq = sq;
+            }
+        }
+        residual->rms_px = (float)sqrt(sum_sq / count);
+        residual->max_px = (float)sqrt(max_sq);
+    }
+    return true;
+}
+
+void touch_cal_from_ranges(touch_cal_matrix_t *matrix,
+                           uint16_t x_raw_min, uint16_t x_raw_max, uint16_t width,
+                           uint16_t y_raw_min, uint16_t y_raw_max, uint16_t height)
+{
+    // Degenerate ranges are widened so the coefficients stay within the limits
+    int32_t x_range = (x_raw_max > x_raw_min + TOUCH_CAL_MIN_RANGE) ? x_raw_max - x_raw_min : TOUCH_CAL_MIN_RANGE;
+    int32_t y_range = (y_raw_max > y_raw_min + TOUCH_CAL_MIN_RANGE) ? y_raw_max - y_raw_min : TOUCH_CAL_MIN_RANGE;
+
+    // Rounded scales: at most 1/2^17 px per raw count off the exact ratio
+    matrix->a = 0;
+    matrix->b = (int32_t)((((int64_t)width << TOUCH_CAL_SHIFT) + x_range / 2) / x_range);
+    matrix->c = -matrix->b * x_raw_min;
+    matrix->d = (int32_t)((((int64_t)height << TOUCH_CAL_SHIFT) + y_range / 2) / y_range);
+    matrix->e = 0;
+    matrix->f = -matrix->d * y_raw_min;
+}
@@ -0,0 +1,80 @@
+/*
+ * touch_cal.h - Affine touch calibration (least-squares fit, Q16 mapping)
+ *
+ * The touch panel is not mounted perfectly aligned with the display: its axes
+ * may be swapped, mirrored, slightly rotated and skewed. All of that is an
+ * affine transform from raw ADC readings to screen pixels:
+ *
+ *   screen_x = a * raw_x + b * raw_y + c
+ *   screen_y = d * raw_x + e * raw_y + f
+ *
+ * The six coefficients are fitted by least squares to 3 or more touched
+ * targets (3 solve it exactly; more average out the finger's imprecision and
+ * give a meaningful residual). They are stored as Q16 fixed point so mapping
+ * a sample is four integer multiply-adds and two shifts, with no division.
+ */
+
+#ifndef TOUCH_CAL_H
+#define TOUCH_CAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TOUCH_CAL_MIN_POINTS    3
+#define TOUCH_CAL_MAX_POINTS    9
+#define TOUCH_CAL_SHIFT         16              // Q16 coefficients
+#define TOUCH_CAL_COEF_LIMIT    (1L << 17)      // |a|, |b|, |d|, |e| < 2 px per raw count
+#define TOUCH_CAL_OFFSET_LIMIT  (1L << 29)      // |c|, |f| < 8192 px
+
+typedef struct {
+    int32_t a, b, c;        // screen_x = (a * raw_x + b * raw_y + c) >> 16
+    int32_t d, e, f;        // screen_y = (d * raw_x + e * raw_y + f) >> 16
+} touch_cal_matrix_t;
+
+// One calibration target: where it was drawn and what the panel reported
+typedef struct {
+    uint16_t raw_x;
+    uint16_t raw_y;
+    int16_t screen_x;
+    int16_t screen_y;
+} touch_cal_point_t;
+
+// Distance between the targets and where the fitted matrix maps their touches
+typedef struct {
+    float rms_px;
+    float max_px;
+} touch_cal_residual_t;
+
+/**
+ * Fit a matrix to count points (TOUCH_CAL_MIN_POINTS..TOUCH_CAL_MAX_POINTS)
+ *
+ * Returns false, leaving matrix untouched, if there are too few points, the
+ * touches are (nearly) collinear, or a coefficient is out of range. residual
+ * may be NULL.
+ */
+bool touch_cal_fit(const touch_cal_point_t *points, int count,
+                   touch_cal_matrix_t *matrix, touch_cal_residual_t *residual);
+
+/**
+ * Matrix for a panel whose raw_y spans [x_raw_min, x_raw_max] across the
+ * width and whose raw_x spans [y_raw_min, y_raw_max] down the height (the
+ * original two-point calibration, and the uncalibrated default over the
+ * whole ADC range). Mapped values are the exact ratio rounded to the
+ * nearest pixel, within 1/16 px.
+ */
+void touch_cal_from_ranges(touch_cal_matrix_t *matrix,
+                           uint16_t x_raw_min, uint16_t x_raw_max, uint16_t width,
+                           uint16_t y_raw_min, uint16_t y_raw_max, uint16_t height);
+
+/**
+ * Map a raw sample to screen coordinates (unclamped; may be negative)
+ */
+static inline void touch_cal_apply(const touch_cal_matrix_t *matrix, uint16_t raw_x, uint16_t raw_y,
+                                   int32_t *screen_x, int32_t *screen_y)
+{
+    const int32_t round = 1L << (TOUCH_CAL_SHIFT - 1);
+    *screen_x = (matrix->a * raw_x + matrix->b * raw_y + matrix->c + round) >> TOUCH_CAL_SHIFT;
+    *screen_y = (matrix->d * raw_x + matrix->e * raw_y + matrix->f + round) >> TOUCH_CAL_SHIFT;
+}
+
+#endif // TOUCH_CAL_H
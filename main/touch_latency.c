@@ -0,0 +1,81 @@
+/*
+ * touch_latency.c - Touch-to-pixel latency tracking
+ *
+ * See touch_latency.h.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "touch_latency.h"
+
+#define STAGE_BIT(stage)    (1u << (stage))
+
+void latency_reset(latency_tracker_t *tracker)
+{
+    memset(tracker, 0, sizeof(*tracker));
+}
+
+void latency_begin(latency_tracker_t *tracker, uint32_t now_us)
+{
+    tracker->seen = STAGE_BIT(LATENCY_TOUCH_DOWN);
+    tracker->stamp_us[LATENCY_TOUCH_DOWN] = now_us;
+}
+
+void latency_stamp(latency_tracker_t *tracker, latency_stage_t stage, uint32_t now_us)
+{
+    if (tracker->seen & STAGE_BIT(stage)) {
+        return;
+    }
+    tracker->seen |= STAGE_BIT(stage);
+    tracker->stamp_us[stage] = now_us;
+}
+
+void latency_finish(latency_tracker_t *tracker, int mode, uint32_t now_us)
+{
+    const uint32_t required = STAGE_BIT(LATENCY_TOUCH_DOWN) | STAGE_BIT(LATENCY_RELEASE) |
+                              STAGE_BIT(LATENCY_HANDLER);
+    const uint32_t *t = tracker->stamp_us;
+
+    if (mode < 0 || mode >= LATENCY_MAX_MODES || (tracker->seen & required) != required) {
+        tracker->seen = 0;
+        return;
+    }
+
+    latency_stamp(tracker, LATENCY_FLUSH, now_us);
+    latency_mode_stats_t *stats = &tracker->modes[mode];
+
+    // Unsigned differences stay correct across a 32-bit timestamp wrap
+    perf_stat_record(&stats->hold, t[LATENCY_RELEASE] - t[LATENCY_TOUCH_DOWN]);
+    perf_stat_record(&stats->dispatch, t[LATENCY_HANDLER] - t[LATENCY_RELEASE]);
+
+    if (tracker->seen & STAGE_BIT(LATENCY_FIRST_SPI)) {
+        perf_stat_record(&stats->render, t[LATENCY_FIRST_SPI] - t[LATENCY_HANDLER]);
+        perf_stat_record(&stats->transfer, t[LATENCY_FLUSH] - t[LATENCY_FIRST_SPI]);
+        perf_stat_record(&stats->total, t[LATENCY_FLUSH] - t[LATENCY_RELEASE]);
+    } else {
+        stats->no_redraw++;
+    }
+
+    tracker->seen = 0;
+}
+
+void latency_print_report(const latency_tracker_t *tracker,
+                          const char *const *mode_names, int mode_count)
+{
+    printf("Touch-to-pixel latency (us, total = release -> flush)\n");
+
+    for (int i = 0; i < mode_count && i < LATENCY_MAX_MODES; i++) {
+        const latency_mode_stats_t *stats = &tracker->modes[i];
+        if (stats->hold.count == 0) {
+            continue;
+        }
+
+        printf("%s: %lu event(s), %lu without redraw\n", mode_names[i],
+               (unsigned long)stats->hold.count, (unsigned long)stats->no_redraw);
+        perf_stat_print("total", &stats->total);
+        perf_stat_print("dispatch", &stats->dispatch);
+        perf_stat_print("render", &stats->render);
+        perf_stat_print("transfer", &stats->transfer);
+        perf_stat_print("hold", &stats->hold);
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * touch_latency.h - Touch-to-pixel latency tracking
+ *
+ * One touch event at a time is followed through the pipeline:
+ *
+ *   TOUCH_DOWN -> RELEASE -> HANDLER -> FIRST_SPI -> FLUSH
+ *
+ * The firmware acts on release, so "total" is measured from RELEASE to
+ * FLUSH (the redraw is fully on the panel). The hold time is reported
+ * separately. Results are accumulated per UI mode (the mode that handled the
+ * event) into perf_stat_t records.
+ *
+ * Timestamps are plain microsecond counters supplied by the caller, so the
+ * unit tests can replay scripted touch sequences and get the same report as
+ * the device.
+ */
+
+#ifndef TOUCH_LATENCY_H
+#define TOUCH_LATENCY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "perf_stats.h"
+
+#define LATENCY_MAX_MODES   8
+
+typedef enum {
+    LATENCY_TOUCH_DOWN,     // First sample with pressure
+    LATENCY_RELEASE,        // Release detected, event about to be dispatched
+    LATENCY_HANDLER,        // Mode handler entered
+    LATENCY_FIRST_SPI,      // First display SPI transaction of the redraw
+    LATENCY_FLUSH,          // Handler returned with all SPI transfers complete
+    LATENCY_STAGE_COUNT
+} latency_stage_t;
+
+// Accumulated latencies for one UI mode (microseconds)
+typedef struct {
+    perf_stat_t hold;       // TOUCH_DOWN -> RELEASE
+    perf_stat_t dispatch;   // RELEASE -> HANDLER
+    perf_stat_t render;     // HANDLER -> FIRST_SPI
+    perf_stat_t transfer;   // FIRST_SPI -> FLUSH
+    perf_stat_t total;      // RELEASE -> FLUSH
+    uint32_t no_redraw;     // Events whose handler sent nothing to the display
+} latency_mode_stats_t;
+
+typedef struct {
+    uint32_t stamp_us[LATENCY_STAGE_COUNT];   // In-flight event
+    uint32_t seen;                            // Bit per stamped stage
+    latency_mode_stats_t modes[LATENCY_MAX_MODES];
+} latency_tracker_t;
+
+/**
+ * Clear the in-flight event and all accumulated statistics
+ */
+void latency_reset(latency_tracker_t *tracker);
+
+/**
+ * Start a new event at touch-down (discards an unfinished one)
+ */
+void latency_begin(latency_tracker_t *tracker, uint32_t now_us);
+
+/**
+ * Timestamp a stage of the in-flight event; only the first stamp of each
+ * stage counts, so every display transaction may call this for FIRST_SPI
+ */
+void latency_stamp(latency_tracker_t *tracker, latency_stage_t stage, uint32_t now_us);
+
+/**
+ * Stamp FLUSH and add the event to the statistics of the given mode
+ */
+void latency_finish(latency_tracker_t *tracker, int mode, uint32_t now_us);
+
+/**
+ * Print the per-mode report to stdout; modes without events are skipped
+ */
+void latency_print_report(const latency_tracker_t *tracker,
+                          const char *const *mode_names, int mode_count);
+
+#endif // TOUCH_LATENCY_H
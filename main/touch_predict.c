@@ -0,0 +1,89 @@
+/*
+ * touch_predict.c - Short-horizon touch position prediction for drags
+ *
+ * See touch_predict.h.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "touch_predict.h"
+
+void touch_predict_init(touch_predict_t *p)
+{
+    memset(p, 0, sizeof(*p));
+    p->alpha = TOUCH_PREDICT_ALPHA;
+    p->beta = TOUCH_PREDICT_BETA;
+}
+
+void touch_predict_reset(touch_predict_t *p)
+{
+    float alpha = p->alpha, beta = p->beta;
+    memset(p, 0, sizeof(*p));
+    p->alpha = alpha;
+    p->beta = beta;
+}
+
+/**
+ * One axis of the alpha-beta update
+ */
+static void track_axis(const touch_predict_t *p, float *pos, float *vel, float sample, float dt)
+{
+    float predicted = *pos + *vel * dt;
+    float residual = sample - predicted;
+    *pos = predicted + p->alpha * residual;
+    *vel += p->beta * residual / dt;
+}
+
+void touch_predict_update(touch_predict_t *p, int16_t x, int16_t y, uint32_t now_ms)
+{
+    uint32_t dt = now_ms - p->last_ms;
+
+    if (!p->valid || dt > TOUCH_PREDICT_MAX_GAP) {
+        // First sample, or the finger paused long enough that its old speed means nothing
+        p->valid = true;
+        p->x = x;
+        p->y = y;
+        p->vx = p->vy = 0;
+        p->step_vx = p->step_vy = 0;
+    } else if (dt > 0) {
+        track_axis(p, &p->x, &p->vx, x, (float)dt);
+        track_axis(p, &p->y, &p->vy, y, (float)dt);
+        p->step_vx = (float)(x - p->last_x) / dt;
+        p->step_vy = (float)(y - p->last_y) / dt;
+    }
+    p->last_x = x;
+    p->last_y = y;
+    p->last_ms = now_ms;
+}
+
+/**
+ * Filtered velocity, no faster than the latest step and zero against it
+ */
+static float limit_velocity(float filtered, float step)
+{
+    if (filtered * step <= 0) {
+        return 0;
+    }
+    return (fabsf(filtered) < fabsf(step)) ? filtered : step;
+}
+
+static int16_t round_px(float v)
+{
+    if (v > INT16_MAX) return INT16_MAX;
+    if (v < INT16_MIN) return INT16_MIN;
+    return (int16_t)lroundf(v);
+}
+
+void touch_predict_at(const touch_predict_t *p, uint32_t horizon_ms, int16_t *x, int16_t *y)
+{
+    if (!p->valid) {
+        *x = p->last_x;
+        *y = p->last_y;
+        return;
+    }
+    if (horizon_ms > TOUCH_PREDICT_MAX_HORIZON) {
+        horizon_ms = TOUCH_PREDICT_MAX_HORIZON;
+    }
+    *x = round_px(p->last_x + limit_velocity(p->vx, p->step_vx) * horizon_ms);
+    *y = round_px(p->last_y + limit_velocity(p->vy, p->step_vy) * horizon_ms);
+}
@@ -0,0 +1,68 @@
+/*
+ * touch_predict.h - Short-horizon touch position prediction for drags
+ *
+ * A dragged view is redrawn after the sample that moved it was read, so the
+ * content trails the finger by the render time. An alpha-beta filter over the
+ * timestamped samples tracks the finger's velocity:
+ *
+ *   predicted  = position + velocity * dt
+ *   residual   = sample - predicted
+ *   position   = predicted + alpha * residual
+ *   velocity  += beta * residual / dt
+ *
+ * and touch_predict_at() extrapolates the latest sample by that velocity over
+ * the render latency, so the frame lands where the finger will be.
+ *
+ * Extrapolation is what overshoots when the finger stops or turns. Per axis
+ * it is therefore limited to the speed of the latest step and dropped when
+ * that step goes the other way: a finger that stops is reported exactly where
+ * it stopped at the next sample, with no filtered momentum carried past it.
+ *
+ * Timestamps come from the caller (milliseconds), so the unit tests replay
+ * recorded traces.
+ */
+
+#ifndef TOUCH_PREDICT_H
+#define TOUCH_PREDICT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TOUCH_PREDICT_ALPHA         0.5f
+#define TOUCH_PREDICT_BETA          0.3f
+#define TOUCH_PREDICT_MAX_HORIZON   80      // ms; longer predictions are mostly guesswork
+#define TOUCH_PREDICT_MAX_GAP       200     // ms between samples before the track restarts
+
+typedef struct {
+    float alpha;
+    float beta;
+    bool valid;                 // At least one sample since the reset
+    uint32_t last_ms;
+    int16_t last_x, last_y;     // Latest sample
+    float step_vx, step_vy;     // Velocity of the latest step, px/ms
+    float x, y;                 // Filtered position
+    float vx, vy;               // Filtered velocity, px/ms
+} touch_predict_t;
+
+/**
+ * Default gains, no track
+ */
+void touch_predict_init(touch_predict_t *p);
+
+/**
+ * Forget the track (call at touch-down)
+ */
+void touch_predict_reset(touch_predict_t *p);
+
+/**
+ * Add a sample taken at now_ms
+ */
+void touch_predict_update(touch_predict_t *p, int16_t x, int16_t y, uint32_t now_ms);
+
+/**
+ * Where the finger is expected horizon_ms after the latest sample (clamped
+ * to TOUCH_PREDICT_MAX_HORIZON); the latest sample itself without a track
+ */
+void touch_predict_at(const touch_predict_t *p, uint32_t horizon_ms, int16_t *x, int16_t *y);
+
+#endif // TOUCH_PREDICT_H
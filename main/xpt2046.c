@@ -0,0 +1,62 @@
+/*
+ * xpt2046.c - XPT2046 burst conversion framing and sample filtering
+ *
+ * See xpt2046.h.
+ */
+
+#include <string.h>
+#include "xpt2046.h"
+
+int xpt2046_touch_commands(int samples, uint8_t *commands)
+{
+    int n = 0;
+
+    commands[n++] = XPT2046_CMD_Z1 | XPT2046_PD_ADC_ON;
+    for (int i = 0; i < samples; i++) {
+        commands[n++] = XPT2046_CMD_X | XPT2046_PD_ADC_ON;
+    }
+    for (int i = 0; i < samples; i++) {
+        commands[n++] = XPT2046_CMD_Y | XPT2046_PD_ADC_ON;
+    }
+    commands[n - 1] &= ~XPT2046_PD_ADC_ON;     // Power down, PENIRQ back on
+    return n;
+}
+
+size_t xpt2046_burst_frame(const uint8_t *commands, int count, uint8_t *tx)
+{
+    size_t len = XPT2046_BURST_BYTES(count);
+
+    memset(tx, 0, len);
+    for (int i = 0; i < count; i++) {
+        tx[2 * i] = commands[i];
+    }
+    return len;
+}
+
+void xpt2046_burst_decode(const uint8_t *rx, int count, uint16_t *values)
+{
+    for (int i = 0; i < count; i++) {
+        uint16_t word = ((uint16_t)rx[1 + 2 * i] << 8) | rx[2 + 2 * i];
+        values[i] = (word >> 3) & 0xFFF;
+    }
+}
+
+uint16_t xpt2046_filter(const uint16_t *samples, int count)
+{
+    uint32_t sum = 0;
+    uint16_t lo = 0xFFFF, hi = 0;
+
+    if (count <= 0) {
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+        if (samples[i] < lo) lo = samples[i];
+        if (samples[i] > hi) hi = samples[i];
+    }
+    if (count >= 3) {
+        sum -= lo + hi;
+        count -= 2;
+    }
+    return (uint16_t)((sum + count / 2) / count);
+}
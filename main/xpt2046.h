@@ -0,0 +1,56 @@
+/*
+ * xpt2046.h - XPT2046 burst conversion framing and sample filtering
+ *
+ * Each XPT2046 conversion is a control byte followed by 16 clocks that shift
+ * out the 12-bit result (bits [14:3]). The controller accepts the next
+ * control byte during the last 8 of those clocks, so N conversions chain
+ * into one transfer of 1 + 2N bytes instead of N transfers of 3 bytes:
+ *
+ *   MOSI:  C0  00  C1  00  C2  ...  C(N-1)  00  00
+ *   MISO:  --  R0hi R0lo/--  R1hi  ...             R(N-1)lo
+ *
+ * where result i arrives in bytes 1 + 2i and 2 + 2i.
+ *
+ * Plain C with no ESP-IDF dependencies; the SPI transfer itself is in main.c.
+ */
+
+#ifndef XPT2046_H
+#define XPT2046_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Control bytes: start bit, channel, 12-bit mode, differential reference
+#define XPT2046_CMD_X           0xD0    // X position
+#define XPT2046_CMD_Y           0x90    // Y position
+#define XPT2046_CMD_Z1          0xB0    // Pressure (Z1)
+#define XPT2046_PD_ADC_ON       0x01    // Keep the ADC on after this conversion (PENIRQ off)
+
+#define XPT2046_BURST_BYTES(n)  (1 + 2 * (n))
+#define XPT2046_BURST_MAX       31      // 64-byte non-DMA SPI transfer limit
+
+/**
+ * Control bytes for one touch read: Z1, then samples conversions each of X
+ * and Y. The ADC stays on between them; the last one powers it down and
+ * re-enables PENIRQ. Returns the number of conversions (1 + 2 * samples).
+ */
+int xpt2046_touch_commands(int samples, uint8_t *commands);
+
+/**
+ * Build the overlapped transmit buffer for count conversions; tx must hold
+ * XPT2046_BURST_BYTES(count). Returns the transfer length in bytes.
+ */
+size_t xpt2046_burst_frame(const uint8_t *commands, int count, uint8_t *tx);
+
+/**
+ * Extract the count 12-bit results from the received buffer
+ */
+void xpt2046_burst_decode(const uint8_t *rx, int count, uint16_t *values);
+
+/**
+ * Combine repeated samples of one axis: with 3 or more the lowest and
+ * highest are dropped and the rest averaged, otherwise the plain average
+ */
+uint16_t xpt2046_filter(const uint16_t *samples, int count);
+
+#endif // XPT2046_H
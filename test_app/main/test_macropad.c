@@ -17,6 +17,19 @@
 #include "nvs.h"
 #include "esp_system.h"
 #include "esp_log.h"
+#include "perf_stats.h"
+#include "touch_latency.h"
+#include "glyph_cache.h"
+#include "aa_font.h"
+#include "icon.h"
+#include "display_list.h"
+#include "touch_cal.h"
+#include "gesture.h"
+#include "touch_predict.h"
+#include "xpt2046.h"
+#include "power_stats.h"
+#include "cpu_load.h"
+#include <math.h>
 
 static const char *TAG = "TEST";
 
@@ -534,6 +547,1158 @@ TEST_CASE("Timeout: Exact timeout boundary", "[timeout]")
     TEST_ASSERT_TRUE(timed_out);
 }
 
+// =============================================================================
+// PERFORMANCE STATISTICS TESTS
+// =============================================================================
+
+TEST_CASE("Perf: Empty stat reports zero average", "[perf]")
+{
+    perf_stat_t stat = {0};
+    
+    TEST_ASSERT_EQUAL(0, stat.count);
+    TEST_ASSERT_EQUAL(0, perf_stat_avg(&stat));
+}
+
+TEST_CASE("Perf: Min, max and average", "[perf]")
+{
+    perf_stat_t stat;
+    perf_stat_reset(&stat);
+    
+    perf_stat_record(&stat, 300);
+    perf_stat_record(&stat, 100);
+    perf_stat_record(&stat, 200);
+    
+    TEST_ASSERT_EQUAL(3, stat.count);
+    TEST_ASSERT_EQUAL(100, stat.min);
+    TEST_ASSERT_EQUAL(300, stat.max);
+    TEST_ASSERT_EQUAL(200, perf_stat_avg(&stat));
+}
+
+TEST_CASE("Perf: Histogram bucket boundaries", "[perf]")
+{
+    TEST_ASSERT_EQUAL(0, perf_stat_bucket(0));
+    TEST_ASSERT_EQUAL(0, perf_stat_bucket(63));
+    TEST_ASSERT_EQUAL(1, perf_stat_bucket(64));
+    TEST_ASSERT_EQUAL(1, perf_stat_bucket(255));
+    TEST_ASSERT_EQUAL(2, perf_stat_bucket(256));
+    TEST_ASSERT_EQUAL(6, perf_stat_bucket(262143));
+    TEST_ASSERT_EQUAL(7, perf_stat_bucket(262144));
+    TEST_ASSERT_EQUAL(7, perf_stat_bucket(UINT32_MAX));
+    
+    // Every value falls below its own bucket's limit
+    for (int i = 0; i < PERF_HIST_BUCKETS - 1; i++) {
+        uint32_t limit = perf_stat_bucket_limit(i);
+        TEST_ASSERT_EQUAL(i, perf_stat_bucket(limit - 1));
+        TEST_ASSERT_EQUAL(i + 1, perf_stat_bucket(limit));
+    }
+}
+
+TEST_CASE("Perf: Histogram counts every sample", "[perf]")
+{
+    perf_stat_t stat = {0};
+    uint32_t total = 0;
+    
+    for (uint32_t v = 1; v < 200000; v *= 3) {
+        perf_stat_record(&stat, v);
+    }
+    for (int i = 0; i < PERF_HIST_BUCKETS; i++) {
+        total += stat.hist[i];
+    }
+    
+    TEST_ASSERT_EQUAL(stat.count, total);
+}
+
+// =============================================================================
+// TOUCH LATENCY TESTS
+// =============================================================================
+
+// One scripted touch: stage timestamps in microseconds (first_spi 0 = no redraw)
+typedef struct {
+    int mode;
+    uint32_t down, release, handler, first_spi, flush;
+} scripted_touch_t;
+
+/**
+ * Replay scripted touches through the tracker the way handle_touch_task does
+ */
+static void replay_touches(latency_tracker_t *tracker, const scripted_touch_t *touches, int count)
+{
+    for (int i = 0; i < count; i++) {
+        const scripted_touch_t *t = &touches[i];
+        latency_begin(tracker, t->down);
+        latency_stamp(tracker, LATENCY_RELEASE, t->release);
+        latency_stamp(tracker, LATENCY_HANDLER, t->handler);
+        if (t->first_spi) {
+            latency_stamp(tracker, LATENCY_FIRST_SPI, t->first_spi);
+            latency_stamp(tracker, LATENCY_FIRST_SPI, t->first_spi + 500);  // Later transactions ignored
+        }
+        latency_finish(tracker, t->mode, t->flush);
+    }
+}
+
+TEST_CASE("Latency: Scripted replay per mode", "[latency]")
+{
+    static latency_tracker_t tracker;
+    const scripted_touch_t script[] = {
+        // mode                down     release  handler  first_spi flush
+        { MODE_PLAYBACK,       0,       120000,  120050,  120300,   160300 },
+        { MODE_PLAYBACK,       500000,  650000,  650050,  650100,   710100 },
+        { MODE_PLAYBACK,       900000,  1000000, 1000040, 0,        1000100 },  // Touch outside buttons
+        { MODE_CONFIG,         2000000, 2100000, 2100030, 2100200,  2300200 },
+    };
+    const char *const names[] = {"playback", "config", "keyboard"};  // Test app_mode_t order
+    
+    latency_reset(&tracker);
+    replay_touches(&tracker, script, sizeof(script) / sizeof(script[0]));
+    
+    const latency_mode_stats_t *playback = &tracker.modes[MODE_PLAYBACK];
+    TEST_ASSERT_EQUAL(3, playback->hold.count);
+    TEST_ASSERT_EQUAL(1, playback->no_redraw);
+    TEST_ASSERT_EQUAL(2, playback->total.count);
+    TEST_ASSERT_EQUAL(40300, playback->total.min);
+    TEST_ASSERT_EQUAL(60100, playback->total.max);
+    TEST_ASSERT_EQUAL(250, playback->render.max);
+    TEST_ASSERT_EQUAL(60000, playback->transfer.max);
+    
+    const latency_mode_stats_t *config = &tracker.modes[MODE_CONFIG];
+    TEST_ASSERT_EQUAL(1, config->total.count);
+    TEST_ASSERT_EQUAL(200200, config->total.max);
+    TEST_ASSERT_EQUAL(30, config->dispatch.max);
+    
+    // Same report format as the "latency" console command
+    latency_print_report(&tracker, names, 3);
+}
+
+TEST_CASE("Latency: Timestamp wrap and incomplete events", "[latency]")
+{
+    static latency_tracker_t tracker;
+    latency_reset(&tracker);
+    
+    // 32-bit microsecond counter wraps between release and flush
+    latency_begin(&tracker, 0xFFFF0000u);
+    latency_stamp(&tracker, LATENCY_RELEASE, 0xFFFFFF00u);
+    latency_stamp(&tracker, LATENCY_HANDLER, 0xFFFFFF80u);
+    latency_stamp(&tracker, LATENCY_FIRST_SPI, 0x00000080u);
+    latency_finish(&tracker, MODE_PLAYBACK, 0x00001100u);
+    TEST_ASSERT_EQUAL(0x1200, tracker.modes[MODE_PLAYBACK].total.max);
+    
+    // An event without a release stamp is discarded
+    latency_begin(&tracker, 100);
+    latency_finish(&tracker, MODE_PLAYBACK, 200);
+    TEST_ASSERT_EQUAL(1, tracker.modes[MODE_PLAYBACK].hold.count);
+}
+
+// =============================================================================
+// GLYPH CACHE TESTS
+// =============================================================================
+
+// Font with only '!' (a vertical bar in column 2) and '"' (top-left pixel) set
+static uint8_t test_font[95][5] = {
+    [1] = {0x00, 0x00, 0x7F, 0x00, 0x00},
+    [2] = {0x01, 0x00, 0x00, 0x00, 0x00},
+};
+
+#define SWAP16(c) ((uint16_t)(((c) << 8) | ((c) >> 8)))
+
+TEST_CASE("Glyph cache: Cell pixels in panel byte order", "[glyph]")
+{
+    static glyph_cache_t cache;
+    glyph_cache_init(&cache, (const uint8_t (*)[5])test_font, 4096);
+    
+    const uint16_t *cell = glyph_cache_get(&cache, '"', 0xF800, 0x001F, 2);
+    TEST_ASSERT_NOT_NULL(cell);
+    
+    // Size 2: 12x14 cell, top-left 2x2 block is foreground, the rest background
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xF800), cell[0]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xF800), cell[1]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xF800), cell[12]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x001F), cell[2]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x001F), cell[24]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x001F), cell[12 * 14 - 1]);
+    
+    glyph_cache_clear(&cache);
+}
+
+TEST_CASE("Glyph cache: Hit after miss", "[glyph]")
+{
+    static glyph_cache_t cache;
+    glyph_cache_init(&cache, (const uint8_t (*)[5])test_font, 4096);
+    
+    const uint16_t *first = glyph_cache_get(&cache, '!', 0xFFFF, 0x0000, 1);
+    const uint16_t *second = glyph_cache_get(&cache, '!', 0xFFFF, 0x0000, 1);
+    const uint16_t *other_bg = glyph_cache_get(&cache, '!', 0xFFFF, 0x1082, 1);
+    
+    TEST_ASSERT_EQUAL_PTR(first, second);
+    TEST_ASSERT_TRUE(other_bg != first);
+    TEST_ASSERT_EQUAL(1, cache.stats.hits);
+    TEST_ASSERT_EQUAL(2, cache.stats.misses);
+    TEST_ASSERT_EQUAL(2 * 6 * 7 * 2, cache.stats.bytes_used);
+    
+    glyph_cache_clear(&cache);
+    TEST_ASSERT_EQUAL(0, cache.stats.bytes_used);
+}
+
+TEST_CASE("Glyph cache: LRU eviction under budget", "[glyph]")
+{
+    static glyph_cache_t cache;
+    const uint32_t cell_bytes = 6 * 7 * 2;  // Size 1
+    glyph_cache_init(&cache, (const uint8_t (*)[5])test_font, 2 * cell_bytes);
+    
+    glyph_cache_get(&cache, 'a', 0xFFFF, 0x0000, 1);
+    glyph_cache_get(&cache, 'b', 0xFFFF, 0x0000, 1);
+    glyph_cache_get(&cache, 'a', 0xFFFF, 0x0000, 1);   // 'b' is now least recently used
+    glyph_cache_get(&cache, 'c', 0xFFFF, 0x0000, 1);   // Evicts 'b'
+    
+    TEST_ASSERT_EQUAL(1, cache.stats.evictions);
+    TEST_ASSERT_EQUAL(2, cache.stats.entries);
+    TEST_ASSERT_TRUE(cache.stats.bytes_used <= 2 * cell_bytes);
+    
+    uint32_t hits = cache.stats.hits;
+    glyph_cache_get(&cache, 'a', 0xFFFF, 0x0000, 1);
+    TEST_ASSERT_EQUAL(hits + 1, cache.stats.hits);
+    glyph_cache_get(&cache, 'b', 0xFFFF, 0x0000, 1);
+    TEST_ASSERT_EQUAL(hits + 1, cache.stats.hits);
+    
+    // A cell bigger than the whole budget is never cached
+    TEST_ASSERT_NULL(glyph_cache_get(&cache, 'a', 0xFFFF, 0x0000, 3));
+    TEST_ASSERT_EQUAL(1, cache.stats.uncached);
+    
+    glyph_cache_clear(&cache);
+}
+
+// =============================================================================
+// ANTI-ALIASED FONT TESTS
+// =============================================================================
+
+// Two-glyph font: ' ' (empty, advance 3) and '!' (2x2 block, alpha 15/0/8/15, advance 4)
+static const uint8_t aa_test_bitmaps[] = {0xF0, 0x8F};
+static const aa_glyph_t aa_test_glyphs[] = {
+    {0, 0, 0, 0, 0, 3},
+    {0, 2, 2, 1, 1, 4},
+};
+static const uint8_t aa_test_advances[] = {3, 4};
+static const aa_font_t aa_test_font = {
+    .bitmaps = aa_test_bitmaps,
+    .glyphs = aa_test_glyphs,
+    .advances = aa_test_advances,
+    .first_char = ' ',
+    .last_char = '!',
+    .ascent = 3,
+    .line_height = 4,
+};
+
+TEST_CASE("AA font: Width and fit from advances", "[font]")
+{
+    TEST_ASSERT_EQUAL(0, aa_font_text_width(&aa_test_font, ""));
+    TEST_ASSERT_EQUAL(11, aa_font_text_width(&aa_test_font, "! !"));
+    TEST_ASSERT_EQUAL(7, aa_font_text_width_n(&aa_test_font, "! !", 2));
+    
+    // Characters outside the font measure as space
+    TEST_ASSERT_EQUAL(7, aa_font_text_width(&aa_test_font, "!~"));
+    
+    uint16_t fit_width = 0;
+    TEST_ASSERT_EQUAL(2, aa_font_fit_chars(&aa_test_font, "! !", 10, &fit_width));
+    TEST_ASSERT_EQUAL(7, fit_width);
+    TEST_ASSERT_EQUAL(3, aa_font_fit_chars(&aa_test_font, "! !", 11, &fit_width));
+    TEST_ASSERT_EQUAL(0, aa_font_fit_chars(&aa_test_font, "!", 3, NULL));
+    
+    // Generated font: the packed advance table matches the glyph records
+    for (int c = font_sans15.first_char; c <= font_sans15.last_char; c++) {
+        int i = c - font_sans15.first_char;
+        TEST_ASSERT_EQUAL(font_sans15.glyphs[i].advance, font_sans15.advances[i]);
+    }
+}
+
+TEST_CASE("AA font: Blend into band buffer", "[font]")
+{
+    // 6x4 band, background blue, text in white
+    uint16_t band[6 * 4];
+    for (int i = 0; i < 6 * 4; i++) {
+        band[i] = SWAP16(0x001F);
+    }
+    aa_font_draw(&aa_test_font, "!", 1, 0xFFFF, band, 6, 4, 0, 0, 0);
+    
+    // Glyph at (1, 1): full alpha replaces, zero alpha keeps the background
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xFFFF), band[1 * 6 + 1]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x001F), band[1 * 6 + 2]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xFFFF), band[2 * 6 + 2]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x001F), band[0]);
+    
+    // Alpha 8/15 lands roughly halfway between the colors per channel
+    uint16_t mixed = SWAP16(band[2 * 6 + 1]);
+    TEST_ASSERT_INT_WITHIN(1, 17, mixed >> 11);
+    TEST_ASSERT_INT_WITHIN(1, 34, (mixed >> 5) & 0x3F);
+    TEST_ASSERT_EQUAL(31, mixed & 0x1F);
+}
+
+TEST_CASE("AA font: Band clipping", "[font]")
+{
+    // Band holding text rows 2..3 only: the glyph's second row lands on band row 0
+    uint16_t band[6 * 2];
+    memset(band, 0, sizeof(band));
+    aa_font_draw(&aa_test_font, "!", 1, 0xFFFF, band, 6, 2, 2, 0, 0);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xFFFF), band[2]);
+    TEST_ASSERT_EQUAL_HEX16(0, band[6 + 1]);
+    
+    // Pen left of the band and a band too narrow for the glyph: clipped, no overrun
+    uint16_t narrow[2 * 4 + 1];
+    memset(narrow, 0, sizeof(narrow));
+    aa_font_draw(&aa_test_font, "!!", 2, 0xFFFF, narrow, 2, 4, 0, -2, 0);
+    TEST_ASSERT_EQUAL_HEX16(0, narrow[1 * 2 + 0]);                 // Glyph (1, 0), alpha 0
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xFFFF), narrow[2 * 2 + 0]);    // Glyph (1, 1), alpha 15
+    TEST_ASSERT_EQUAL_HEX16(0, narrow[2 * 4]);
+}
+
+// =============================================================================
+// ICON TESTS
+// =============================================================================
+
+// 5x2 icon: row 0 = T T R R R, row 1 = R G G G G (T transparent); runs cross the row boundary
+static const uint16_t icon_test_palette[] = {0x0000, 0xF800, 0x07E0};
+static const uint8_t icon_test_data[] = {0x10, 0x31, 0x32};
+static const icon_t icon_test = {
+    .width = 5,
+    .height = 2,
+    .palette = icon_test_palette,
+    .palette_size = 3,
+    .transparent = 0,
+    .data = icon_test_data,
+    .data_size = sizeof(icon_test_data),
+};
+
+TEST_CASE("Icon: Decode with transparent background", "[icon]")
+{
+    icon_decoder_t dec;
+    uint16_t out[12];
+    
+    icon_decode_begin(&dec, &icon_test, 0x001F);
+    TEST_ASSERT_EQUAL(10, icon_decode(&dec, out, 12));
+    TEST_ASSERT_EQUAL(0, icon_decode(&dec, out, 12));
+    
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x001F), out[0]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x001F), out[1]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xF800), out[2]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xF800), out[5]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x07E0), out[6]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x07E0), out[9]);
+}
+
+TEST_CASE("Icon: Chunked decode matches whole decode", "[icon]")
+{
+    const icon_t *icon = &icon_keyboard;
+    uint32_t pixels = (uint32_t)icon->width * icon->height;
+    static uint16_t whole[24 * 14];
+    static uint16_t chunked[24 * 14];
+    TEST_ASSERT_EQUAL(sizeof(whole) / 2, pixels);
+    
+    icon_decoder_t dec;
+    icon_decode_begin(&dec, icon, 0x1234);
+    TEST_ASSERT_EQUAL(pixels, icon_decode(&dec, whole, pixels));
+    
+    // Odd chunk size so chunk edges fall inside runs
+    uint32_t total = 0;
+    uint32_t n;
+    icon_decode_begin(&dec, icon, 0x1234);
+    while ((n = icon_decode(&dec, chunked + total, 7)) > 0) {
+        TEST_ASSERT_TRUE(n <= 7);
+        total += n;
+    }
+    TEST_ASSERT_EQUAL(pixels, total);
+    TEST_ASSERT_EQUAL_MEMORY(whole, chunked, sizeof(whole));
+    
+    // Corners are transparent, the top edge is the black outline
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x1234), whole[0]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x0000), whole[1]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x1234), whole[pixels - 1]);
+}
+
+TEST_CASE("Icon: Truncated data stops early", "[icon]")
+{
+    icon_t truncated = icon_test;
+    truncated.data_size = 2;        // Row 1 runs missing
+    
+    icon_decoder_t dec;
+    uint16_t out[10];
+    icon_decode_begin(&dec, &truncated, 0x0000);
+    TEST_ASSERT_EQUAL(6, icon_decode(&dec, out, 10));
+    TEST_ASSERT_EQUAL(0, icon_decode(&dec, out, 10));
+}
+
+// =============================================================================
+// DISPLAY LIST TESTS
+// =============================================================================
+
+#define DL_TEST_W 40
+#define DL_TEST_H 30
+
+TEST_CASE("Display list: Painter's order and clear color", "[dlist]")
+{
+    static display_list_t list;
+    static uint16_t band[DL_TEST_W * DL_TEST_H];
+    dl_init(&list, DL_TEST_W, DL_TEST_H, (const uint8_t (*)[5])test_font, &aa_test_font);
+    dl_clear(&list, 0x001F);
+    
+    TEST_ASSERT_TRUE(dl_fill(&list, 0, 0, 10, 10, 0xF800));
+    TEST_ASSERT_TRUE(dl_fill(&list, 5, 5, 100, 100, 0x07E0));     // Clipped to the target
+    dl_render_band(&list, 0, DL_TEST_H, band);
+    
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xF800), band[0]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x07E0), band[5 * DL_TEST_W + 5]);       // Later item on top
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x07E0), band[DL_TEST_H * DL_TEST_W - 1]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x001F), band[DL_TEST_W - 1]);           // Uncovered
+}
+
+TEST_CASE("Display list: Bands match a single pass", "[dlist]")
+{
+    static display_list_t list;
+    static uint16_t whole[DL_TEST_W * DL_TEST_H];
+    static uint16_t banded[DL_TEST_W * DL_TEST_H];
+    dl_init(&list, DL_TEST_W, DL_TEST_H, (const uint8_t (*)[5])test_font, &aa_test_font);
+    dl_clear(&list, 0x0000);
+    
+    // Every primitive type, each straddling a band edge at rows 5, 10, ...
+    char text[] = "!\"!";
+    dl_fill(&list, 2, 3, 30, 20, 0x1082);
+    dl_text(&list, 1, 4, text, 0xFFFF, 0x1082, 2);
+    text[0] = '"';                  // The list keeps its own copy
+    dl_text(&list, 20, 9, "!", 0xF800, 0xF800, 1);
+    dl_text_aa(&list, 10, 18, "!!", 2, 0xFFE0);
+    dl_icon(&list, 30, 22, &icon_test, 0x1082);
+    
+    dl_render_band(&list, 0, DL_TEST_H, whole);
+    for (uint16_t y = 0; y < DL_TEST_H; y += 5) {
+        dl_render_band(&list, y, 5, banded + y * DL_TEST_W);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(whole, banded, sizeof(whole));
+    
+    // Spot checks: '!' at size 2 is a bar in dot column 2 (x = 1 + 4), icon red row
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xFFFF), whole[4 * DL_TEST_W + 5]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x1082), whole[4 * DL_TEST_W + 1]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0xF800), whole[22 * DL_TEST_W + 32]);
+    TEST_ASSERT_EQUAL_HEX16(SWAP16(0x1082), whole[22 * DL_TEST_W + 30]);    // Transparent icon pixel
+}
+
+TEST_CASE("Display list: Full list rejects items", "[dlist]")
+{
+    static display_list_t list;
+    dl_init(&list, DL_TEST_W, DL_TEST_H, (const uint8_t (*)[5])test_font, &aa_test_font);
+    
+    for (int i = 0; i < DL_MAX_ITEMS; i++) {
+        TEST_ASSERT_TRUE(dl_fill(&list, 0, 0, 1, 1, 0xFFFF));
+    }
+    TEST_ASSERT_FALSE(dl_has_room(&list, 0));
+    TEST_ASSERT_FALSE(dl_fill(&list, 0, 0, 1, 1, 0xFFFF));
+    TEST_ASSERT_EQUAL(DL_MAX_ITEMS, list.count);
+    
+    // Text pool limit is separate from the item limit
+    dl_clear(&list, 0x0000);
+    TEST_ASSERT_TRUE(dl_has_room(&list, DL_TEXT_POOL - 1));
+    TEST_ASSERT_FALSE(dl_has_room(&list, DL_TEXT_POOL));
+}
+
+/**
+ * Four quadrant buttons with labels; confirm replaces quadrant 3 with a white button
+ */
+static void dl_test_buttons(display_list_t *list, bool confirm)
+{
+    static const uint16_t colors[4] = { 0xF800, 0x07E0, 0x001F, 0xFFE0 };
+    dl_clear(list, 0x0000);
+    for (int i = 0; i < 4; i++) {
+        uint16_t x = (i % 2) * 20, y = (i / 2) * 15;
+        bool replaced = confirm && i == 3;
+        dl_fill(list, x, y, 20, 15, replaced ? 0xFFFF : colors[i]);
+        dl_text(list, x + 2, y + 4, replaced ? "\"" : "!", 0x0000, 0x0000, 1);
+    }
+}
+
+TEST_CASE("Display list: Diff damages only changed items", "[dlist]")
+{
+    static display_list_t prev, next;
+    dl_rect_t rects[DL_MAX_DAMAGE];
+    dl_init(&prev, DL_TEST_W, DL_TEST_H, (const uint8_t (*)[5])test_font, &aa_test_font);
+    dl_init(&next, DL_TEST_W, DL_TEST_H, (const uint8_t (*)[5])test_font, &aa_test_font);
+    
+    dl_test_buttons(&prev, false);
+    dl_test_buttons(&next, false);
+    TEST_ASSERT_EQUAL(0, dl_diff(&prev, &next, rects, DL_MAX_DAMAGE));
+    
+    // One quadrant changes; its label box spans to the right edge, inside the quadrant here
+    dl_test_buttons(&next, true);
+    TEST_ASSERT_EQUAL(1, dl_diff(&prev, &next, rects, DL_MAX_DAMAGE));
+    TEST_ASSERT_EQUAL(20, rects[0].x);
+    TEST_ASSERT_EQUAL(15, rects[0].y);
+    TEST_ASSERT_EQUAL(20, rects[0].w);
+    TEST_ASSERT_EQUAL(15, rects[0].h);
+    
+    // A different clear color changes every uncovered pixel
+    dl_test_buttons(&next, false);
+    next.clear_color = 0x1082;
+    TEST_ASSERT_EQUAL(1, dl_diff(&prev, &next, rects, DL_MAX_DAMAGE));
+    TEST_ASSERT_EQUAL(DL_TEST_W, rects[0].w);
+    TEST_ASSERT_EQUAL(DL_TEST_H, rects[0].h);
+}
+
+TEST_CASE("Display list: Patch replaces the items of one area", "[dlist]")
+{
+    static display_list_t shown, patched, full;
+    static uint16_t expected[DL_TEST_W * DL_TEST_H];
+    static uint16_t actual[DL_TEST_W * DL_TEST_H];
+    dl_rect_t rects[DL_MAX_DAMAGE];
+    const dl_rect_t quadrant = { 20, 15, 20, 15 };
+    dl_init(&shown, DL_TEST_W, DL_TEST_H, (const uint8_t (*)[5])test_font, &aa_test_font);
+    dl_init(&patched, DL_TEST_W, DL_TEST_H, (const uint8_t (*)[5])test_font, &aa_test_font);
+    dl_init(&full, DL_TEST_W, DL_TEST_H, (const uint8_t (*)[5])test_font, &aa_test_font);
+    
+    dl_test_buttons(&shown, false);
+    dl_copy_except(&patched, &shown, &quadrant, 1);
+    TEST_ASSERT_EQUAL(shown.count - 2, patched.count);      // Fill and label removed
+    
+    dl_fill(&patched, 20, 15, 20, 15, 0xFFFF);
+    dl_text(&patched, 22, 19, "\"", 0x0000, 0x0000, 1);
+    TEST_ASSERT_EQUAL(1, dl_diff(&shown, &patched, rects, DL_MAX_DAMAGE));
+    TEST_ASSERT_EQUAL(quadrant.x, rects[0].x);
+    TEST_ASSERT_EQUAL(quadrant.y, rects[0].y);
+    
+    dl_test_buttons(&full, true);
+    dl_render_band(&full, 0, DL_TEST_H, expected);
+    dl_render_band(&patched, 0, DL_TEST_H, actual);
+    TEST_ASSERT_EQUAL_MEMORY(expected, actual, sizeof(actual));
+}
+
+TEST_CASE("Display list: Damage repaint matches a full redraw", "[dlist]")
+{
+    static display_list_t prev, next;
+    static uint16_t panel[DL_TEST_W * DL_TEST_H];
+    static uint16_t expected[DL_TEST_W * DL_TEST_H];
+    static uint16_t area[DL_TEST_W * DL_TEST_H];
+    dl_rect_t rects[DL_MAX_DAMAGE];
+    dl_init(&prev, DL_TEST_W, DL_TEST_H, (const uint8_t (*)[5])test_font, &aa_test_font);
+    dl_init(&next, DL_TEST_W, DL_TEST_H, (const uint8_t (*)[5])test_font, &aa_test_font);
+    
+    // Previous screen: a panel with an icon on it, and a small label
+    dl_fill(&prev, 2, 2, 16, 10, 0x1082);
+    dl_icon(&prev, 4, 4, &icon_test, 0x1082);
+    dl_text_aa(&prev, 24, 20, "!", 1, 0xFFFF);
+    dl_render_band(&prev, 0, DL_TEST_H, panel);
+    
+    // Next screen: the panel moves below the icon (so the icon's surroundings
+    // change too), the label disappears and a fill appears elsewhere
+    dl_fill(&next, 2, 6, 16, 10, 0x1082);
+    dl_icon(&next, 4, 4, &icon_test, 0x1082);
+    dl_fill(&next, 30, 2, 6, 4, 0xF800);
+    dl_render_band(&next, 0, DL_TEST_H, expected);
+    
+    int count = dl_diff(&prev, &next, rects, DL_MAX_DAMAGE);
+    TEST_ASSERT_GREATER_THAN(0, count);
+    uint32_t damaged = 0;
+    for (int i = 0; i < count; i++) {
+        dl_render_rect(&next, &rects[i], area);
+        for (uint16_t row = 0; row < rects[i].h; row++) {
+            memcpy(&panel[(rects[i].y + row) * DL_TEST_W + rects[i].x], &area[row * rects[i].w],
+                   rects[i].w * sizeof(uint16_t));
+        }
+        damaged += rects[i].w * rects[i].h;
+    }
+    TEST_ASSERT_EQUAL_MEMORY(expected, panel, sizeof(panel));
+    TEST_ASSERT_LESS_THAN(DL_TEST_W * DL_TEST_H, damaged);
+}
+
+// =============================================================================
+// TOUCH CALIBRATION TESTS
+// =============================================================================
+
+/**
+ * Raw reading of a synthetic 320x240 panel touched at (sx, sy): axes swapped
+ * (raw_y across, raw_x down, inverted), rotated by angle_deg and skewed
+ */
+static void touch_cal_synth(double sx, double sy, double angle_deg, double skew,
+                            uint16_t *raw_x, uint16_t *raw_y)
+{
+    double angle = angle_deg * 3.14159265358979 / 180.0;
+    double u = (sx - 160) * cos(angle) - (sy - 120) * sin(angle);
+    double v = (sx - 160) * sin(angle) + (sy - 120) * cos(angle);
+    u += skew * v;
+    *raw_y = (uint16_t)lround(2048 + u * 11.5);
+    *raw_x = (uint16_t)lround(2048 - v * 14.5);
+}
+
+static const int16_t touch_cal_grid[9][2] = {
+    { 30, 70 }, { 290, 70 }, { 30, 210 }, { 290, 210 }, { 160, 140 },
+    { 160, 70 }, { 160, 210 }, { 30, 140 }, { 290, 140 }
+};
+
+TEST_CASE("Touch calibration: Exact fit on a rotated, skewed panel", "[touchcal]")
+{
+    touch_cal_point_t points[3];
+    touch_cal_matrix_t matrix;
+    touch_cal_residual_t residual;
+    
+    for (int i = 0; i < 3; i++) {
+        points[i].screen_x = touch_cal_grid[i][0];
+        points[i].screen_y = touch_cal_grid[i][1];
+        touch_cal_synth(points[i].screen_x, points[i].screen_y, 3.0, 0.04, &points[i].raw_x, &points[i].raw_y);
+    }
+    TEST_ASSERT_TRUE(touch_cal_fit(points, 3, &matrix, &residual));
+    TEST_ASSERT_TRUE(residual.max_px <= 1.0f);
+    
+    // Everywhere else on the screen, including outside the touched triangle
+    for (int sy = 0; sy < 240; sy += 20) {
+        for (int sx = 0; sx < 320; sx += 20) {
+            uint16_t rx, ry;
+            int32_t x, y;
+            touch_cal_synth(sx, sy, 3.0, 0.04, &rx, &ry);
+            touch_cal_apply(&matrix, rx, ry, &x, &y);
+            TEST_ASSERT_INT_WITHIN(1, sx, x);
+            TEST_ASSERT_INT_WITHIN(1, sy, y);
+        }
+    }
+}
+
+TEST_CASE("Touch calibration: Least squares averages noisy touches", "[touchcal]")
+{
+    // Finger error of up to 2 px per target, in a fixed pattern
+    static const int8_t noise[9][2] = {
+        { 2, -1 }, { -2, 1 }, { 1, 2 }, { -1, -2 }, { 0, 1 }, { 2, 0 }, { -1, 1 }, { 1, -1 }, { -2, -1 }
+    };
+    touch_cal_point_t points[9];
+    touch_cal_matrix_t matrix;
+    touch_cal_residual_t residual;
+    
+    for (int i = 0; i < 9; i++) {
+        points[i].screen_x = touch_cal_grid[i][0];
+        points[i].screen_y = touch_cal_grid[i][1];
+        touch_cal_synth(points[i].screen_x + noise[i][0], points[i].screen_y + noise[i][1],
+                        -2.0, 0.03, &points[i].raw_x, &points[i].raw_y);
+    }
+    TEST_ASSERT_TRUE(touch_cal_fit(points, 9, &matrix, &residual));
+    TEST_ASSERT_TRUE(residual.rms_px > 0.5f && residual.rms_px < 3.0f);
+    TEST_ASSERT_TRUE(residual.max_px >= residual.rms_px && residual.max_px < 4.0f);
+    
+    // The fit lands closer to the true mapping than any single noisy touch
+    for (int i = 0; i < 9; i++) {
+        uint16_t rx, ry;
+        int32_t x, y;
+        touch_cal_synth(touch_cal_grid[i][0], touch_cal_grid[i][1], -2.0, 0.03, &rx, &ry);
+        touch_cal_apply(&matrix, rx, ry, &x, &y);
+        TEST_ASSERT_INT_WITHIN(2, touch_cal_grid[i][0], x);
+        TEST_ASSERT_INT_WITHIN(2, touch_cal_grid[i][1], y);
+    }
+}
+
+TEST_CASE("Touch calibration: Degenerate input rejected", "[touchcal]")
+{
+    touch_cal_point_t points[4] = {
+        { 1000, 1000, 30, 70 }, { 2000, 2000, 160, 140 }, { 3000, 3000, 290, 210 }, { 3500, 3500, 300, 220 }
+    };
+    touch_cal_matrix_t matrix = { 1, 2, 3, 4, 5, 6 };
+    
+    TEST_ASSERT_FALSE(touch_cal_fit(points, 2, &matrix, NULL));         // Too few
+    TEST_ASSERT_FALSE(touch_cal_fit(points, 4, &matrix, NULL));         // Collinear touches
+    TEST_ASSERT_FALSE(touch_cal_fit(points, TOUCH_CAL_MAX_POINTS + 1, &matrix, NULL));
+    TEST_ASSERT_EQUAL(1, matrix.a);                                     // Left untouched
+    TEST_ASSERT_EQUAL(6, matrix.f);
+}
+
+TEST_CASE("Touch calibration: Two-point ranges match the per-axis mapping", "[touchcal]")
+{
+    touch_cal_matrix_t matrix;
+    touch_cal_from_ranges(&matrix, 300, 3800, 320, 250, 3900, 240);
+    
+    for (uint16_t raw = 300; raw <= 3800; raw += 100) {
+        int32_t x, y;
+        touch_cal_apply(&matrix, raw, raw, &x, &y);
+        TEST_ASSERT_INT_WITHIN(1, (raw - 300) * 320 / 3500, x);     // raw_y across
+        if (raw >= 250 && raw <= 3900) {
+            TEST_ASSERT_INT_WITHIN(1, (raw - 250) * 240 / 3650, y); // raw_x down
+        }
+    }
+}
+
+TEST_CASE("Touch calibration: Precomputed default mapping rounds exactly", "[touchcal]")
+{
+    // The axes are independent (a = e = 0), so one sweep per axis covers all 4096 x 4096 samples
+    touch_cal_matrix_t matrix;
+    touch_cal_from_ranges(&matrix, 0, 4095, 320, 0, 4095, 240);
+    TEST_ASSERT_EQUAL(0, matrix.a);
+    TEST_ASSERT_EQUAL(0, matrix.e);
+    
+    for (uint32_t raw = 0; raw <= 4095; raw++) {
+        int32_t x, y;
+        touch_cal_apply(&matrix, 0, raw, &x, &y);
+        TEST_ASSERT_TRUE(fabs(x - raw * 320.0 / 4095) <= 0.5 + 1.0 / 16);
+        touch_cal_apply(&matrix, raw, 0, &x, &y);
+        TEST_ASSERT_TRUE(fabs(y - raw * 240.0 / 4095) <= 0.5 + 1.0 / 16);
+    }
+}
+
+// =============================================================================
+// GESTURE TESTS
+// =============================================================================
+
+// One recorded touch sample at the touch task's 20 Hz poll; x < 0 marks the release
+typedef struct {
+    uint32_t t;
+    int16_t x;
+    int16_t y;
+} gesture_sample_t;
+
+#define GESTURE_RELEASE -1
+
+/**
+ * Replay a recorded sequence; returns the number of events, the last one in *last
+ */
+static int replay_gesture(const gesture_sample_t *samples, int count, gesture_event_t *events, int max,
+                          gesture_event_t *last)
+{
+    gesture_recognizer_t g;
+    gesture_event_t event;
+    int n = 0;
+    
+    gesture_init(&g);
+    for (int i = 0; i < count; i++) {
+        bool got = (samples[i].x == GESTURE_RELEASE)
+            ? gesture_release(&g, samples[i].t, &event)
+            : gesture_touch(&g, samples[i].x, samples[i].y, samples[i].t, &event);
+        if (got) {
+            if (n < max) {
+                events[n] = event;
+            }
+            *last = event;
+            n++;
+        }
+    }
+    return n;
+}
+
+TEST_CASE("Gesture: Jittery press inside the slop is a tap or long press", "[gesture]")
+{
+    gesture_event_t events[8], last;
+    
+    // Finger settles a few pixels around (100, 120) and lifts after 200 ms
+    const gesture_sample_t tap[] = {
+        { 0, 100, 120 }, { 50, 104, 117 }, { 100, 97, 123 }, { 150, 102, 121 }, { 200, GESTURE_RELEASE, 0 }
+    };
+    TEST_ASSERT_EQUAL(1, replay_gesture(tap, 5, events, 8, &last));
+    TEST_ASSERT_EQUAL(GESTURE_TAP, last.type);
+    TEST_ASSERT_EQUAL(100, last.x);         // Press position, not the wobble
+    TEST_ASSERT_EQUAL(120, last.y);
+    TEST_ASSERT_EQUAL(200, last.duration_ms);
+    
+    // Same wobble held for a second
+    const gesture_sample_t hold[] = {
+        { 0, 60, 60 }, { 300, 66, 58 }, { 600, 55, 63 }, { 900, 61, 61 }, { 1000, GESTURE_RELEASE, 0 }
+    };
+    TEST_ASSERT_EQUAL(1, replay_gesture(hold, 5, events, 8, &last));
+    TEST_ASSERT_EQUAL(GESTURE_LONG_PRESS, last.type);
+    TEST_ASSERT_EQUAL(1000, last.duration_ms);
+    
+    // The slop is a circle: 9 px on both axes is inside the square but 12.7 px away
+    const gesture_sample_t diagonal[] = {
+        { 0, 100, 120 }, { 50, 109, 129 }, { 100, GESTURE_RELEASE, 0 }
+    };
+    replay_gesture(diagonal, 3, events, 8, &last);
+    TEST_ASSERT_EQUAL(GESTURE_DRAG, events[0].type);
+    TEST_ASSERT_EQUAL(GESTURE_DRAG_END, last.type);
+}
+
+TEST_CASE("Gesture: Fast strokes are swipes in four directions", "[gesture]")
+{
+    const struct {
+        int16_t dx, dy;
+        gesture_dir_t direction;
+    } strokes[] = {
+        { -30, 0, GESTURE_LEFT }, { 30, 0, GESTURE_RIGHT }, { 0, -25, GESTURE_UP }, { 0, 25, GESTURE_DOWN }
+    };
+    
+    for (int s = 0; s < 4; s++) {
+        // Four 50 ms steps with a little cross-axis drift: 600 px/s along the stroke
+        gesture_sample_t samples[6];
+        for (int i = 0; i < 5; i++) {
+            samples[i].t = i * 50;
+            samples[i].x = 160 + strokes[s].dx * i + (i & 1);
+            samples[i].y = 120 + strokes[s].dy * i - (i & 1);
+        }
+        samples[5] = (gesture_sample_t){ 250, GESTURE_RELEASE, 0 };
+        
+        gesture_event_t events[8], last;
+        int n = replay_gesture(samples, 6, events, 8, &last);
+        TEST_ASSERT_TRUE(n >= 2);                       // Drags, then the swipe
+        TEST_ASSERT_EQUAL(GESTURE_DRAG, events[0].type);
+        TEST_ASSERT_EQUAL(GESTURE_SWIPE, last.type);
+        TEST_ASSERT_EQUAL(strokes[s].direction, last.direction);
+    }
+}
+
+TEST_CASE("Gesture: Drags report movement since the last drag", "[gesture]")
+{
+    // Slow pan right: 10 px per 50 ms (200 px/s), first step stays inside the slop
+    const gesture_sample_t pan[] = {
+        { 0, 50, 100 }, { 50, 60, 100 }, { 100, 70, 101 }, { 150, 80, 101 }, { 200, 90, 102 },
+        { 250, 100, 102 }, { 300, GESTURE_RELEASE, 0 }
+    };
+    gesture_event_t events[8], last;
+    int n = replay_gesture(pan, 7, events, 8, &last);
+    
+    TEST_ASSERT_EQUAL(5, n);                // Four drags and the end
+    TEST_ASSERT_EQUAL(GESTURE_DRAG, events[0].type);
+    TEST_ASSERT_EQUAL(20, events[0].dx);    // Drag starts from the press position
+    TEST_ASSERT_EQUAL(1, events[0].dy);
+    int total = 0;
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(GESTURE_DRAG, events[i].type);
+        total += events[i].dx;
+    }
+    TEST_ASSERT_EQUAL(50, total);
+    TEST_ASSERT_INT_WITHIN(20, 200, events[3].vx);
+    
+    // Too slow for a swipe although it travelled 50 px
+    TEST_ASSERT_EQUAL(GESTURE_DRAG_END, last.type);
+    TEST_ASSERT_EQUAL(50, last.dx);
+    TEST_ASSERT_EQUAL(100, last.x);
+}
+
+TEST_CASE("Gesture: Release without a press is ignored", "[gesture]")
+{
+    gesture_recognizer_t g;
+    gesture_event_t event;
+    
+    gesture_init(&g);
+    TEST_ASSERT_FALSE(gesture_release(&g, 100, &event));
+    
+    // A short flick back to where it started is not a swipe
+    const gesture_sample_t back[] = {
+        { 0, 100, 100 }, { 50, 140, 100 }, { 100, 104, 100 }, { 150, GESTURE_RELEASE, 0 }
+    };
+    gesture_event_t events[8], last;
+    replay_gesture(back, 4, events, 8, &last);
+    TEST_ASSERT_EQUAL(GESTURE_DRAG_END, last.type);
+}
+
+// =============================================================================
+// TOUCH PREDICTION TESTS
+// =============================================================================
+
+// Recorded drags, one sample per 50 ms touch poll (screen x; y held near 120)
+static const int16_t trace_pan[] = {        // Steady pan right, ~240 px/s with jitter
+    40, 53, 64, 77, 88, 101, 112, 125, 136, 149, 160, 173, 184, 197, 208
+};
+static const int16_t trace_stop[] = {       // Flick that decelerates and stops at 141
+    40, 60, 80, 100, 116, 128, 136, 140, 141, 141, 141, 141
+};
+static const int16_t trace_turn[] = {       // Drag right, turn at 142, back left
+    100, 114, 126, 135, 140, 142, 141, 136, 128, 118
+};
+
+#define TRACE_PERIOD_MS     50
+#define TRACE_LEN(t)        ((int)(sizeof(t) / sizeof((t)[0])))
+
+/**
+ * Feed a trace and predict one sample ahead each step; returns the largest
+ * prediction past limit (overshoot) and the mean error against the next sample
+ */
+static int replay_prediction(const int16_t *trace, int count, int16_t limit, float *mean_error)
+{
+    touch_predict_t p;
+    int overshoot = 0;
+    float error = 0;
+    
+    touch_predict_init(&p);
+    for (int i = 0; i < count - 1; i++) {
+        touch_predict_update(&p, trace[i], 120 + (i & 1), i * TRACE_PERIOD_MS);
+        int16_t x, y;
+        touch_predict_at(&p, TRACE_PERIOD_MS, &x, &y);
+        error += abs(x - trace[i + 1]);
+        if (x - limit > overshoot) {
+            overshoot = x - limit;
+        }
+    }
+    *mean_error = error / (count - 1);
+    return overshoot;
+}
+
+TEST_CASE("Touch prediction: Steady pan is predicted within a few pixels", "[predict]")
+{
+    float predicted, trailing = 0;
+    replay_prediction(trace_pan, TRACE_LEN(trace_pan), INT16_MAX, &predicted);
+    
+    // Drawing the latest sample trails the finger by a whole step
+    for (int i = 0; i < TRACE_LEN(trace_pan) - 1; i++) {
+        trailing += trace_pan[i + 1] - trace_pan[i];
+    }
+    trailing /= TRACE_LEN(trace_pan) - 1;
+    
+    printf("Pan: mean error %.2f px predicted, %.2f px trailing\n", predicted, trailing);
+    TEST_ASSERT_TRUE(predicted < 4.0f);
+    TEST_ASSERT_TRUE(predicted < trailing / 2);
+}
+
+TEST_CASE("Touch prediction: Stops and turns barely overshoot", "[predict]")
+{
+    float error;
+    
+    int overshoot = replay_prediction(trace_stop, TRACE_LEN(trace_stop), 141, &error);
+    printf("Stop: overshoot %d px, mean error %.2f px\n", overshoot, error);
+    TEST_ASSERT_TRUE(overshoot <= 4);
+    
+    overshoot = replay_prediction(trace_turn, TRACE_LEN(trace_turn), 142, &error);
+    printf("Turn: overshoot %d px, mean error %.2f px\n", overshoot, error);
+    TEST_ASSERT_TRUE(overshoot <= 4);
+    
+    // Once the finger is still the prediction is exactly where it is
+    touch_predict_t p;
+    touch_predict_init(&p);
+    for (int i = 0; i < TRACE_LEN(trace_stop); i++) {
+        touch_predict_update(&p, trace_stop[i], 120, i * TRACE_PERIOD_MS);
+    }
+    int16_t x, y;
+    touch_predict_at(&p, TRACE_PERIOD_MS, &x, &y);
+    TEST_ASSERT_EQUAL(141, x);
+    TEST_ASSERT_EQUAL(120, y);
+}
+
+TEST_CASE("Touch prediction: Horizon is clamped and pauses restart the track", "[predict]")
+{
+    touch_predict_t p;
+    int16_t x, y;
+    
+    touch_predict_init(&p);
+    touch_predict_at(&p, 50, &x, &y);           // No track yet
+    TEST_ASSERT_EQUAL(0, x);
+    
+    for (int i = 0; i < 8; i++) {
+        touch_predict_update(&p, 100 + i * 10, 50, i * TRACE_PERIOD_MS);     // 0.2 px/ms
+    }
+    touch_predict_at(&p, 10000, &x, &y);
+    TEST_ASSERT_INT_WITHIN(2, 170 + TOUCH_PREDICT_MAX_HORIZON / 5, x);
+    
+    // Resuming after a pause does not carry the old speed
+    touch_predict_update(&p, 180, 50, 7 * TRACE_PERIOD_MS + TOUCH_PREDICT_MAX_GAP + 1);
+    touch_predict_at(&p, 50, &x, &y);
+    TEST_ASSERT_EQUAL(180, x);
+}
+
+// =============================================================================
+// XPT2046 BURST TESTS
+// =============================================================================
+
+/**
+ * What the controller shifts out for a burst: result i in bits [14:3] of
+ * bytes 1 + 2i and 2 + 2i, the unused low bits driven low
+ */
+static void xpt2046_simulate(const uint16_t *results, int count, uint8_t *rx)
+{
+    memset(rx, 0, XPT2046_BURST_BYTES(count));
+    for (int i = 0; i < count; i++) {
+        uint16_t word = (uint16_t)(results[i] << 3);
+        rx[1 + 2 * i] = word >> 8;
+        rx[2 + 2 * i] = word & 0xFF;
+    }
+}
+
+TEST_CASE("XPT2046: Touch read chains all conversions into one frame", "[xpt2046]")
+{
+    uint8_t commands[1 + 2 * 4];
+    uint8_t tx[XPT2046_BURST_BYTES(9)];
+    
+    int count = xpt2046_touch_commands(4, commands);
+    TEST_ASSERT_EQUAL(9, count);
+    TEST_ASSERT_EQUAL_HEX8(XPT2046_CMD_Z1 | XPT2046_PD_ADC_ON, commands[0]);
+    TEST_ASSERT_EQUAL_HEX8(XPT2046_CMD_X | XPT2046_PD_ADC_ON, commands[1]);
+    TEST_ASSERT_EQUAL_HEX8(XPT2046_CMD_Y | XPT2046_PD_ADC_ON, commands[7]);
+    TEST_ASSERT_EQUAL_HEX8(XPT2046_CMD_Y, commands[8]);      // Last powers down (PENIRQ on)
+    
+    // 1 + 2N bytes; each control byte overlaps the low byte of the previous result
+    TEST_ASSERT_EQUAL(19, xpt2046_burst_frame(commands, count, tx));
+    for (int i = 0; i < 19; i++) {
+        if (i % 2 == 0 && i / 2 < count) {
+            TEST_ASSERT_EQUAL_HEX8(commands[i / 2], tx[i]);
+        } else {
+            TEST_ASSERT_EQUAL_HEX8(0, tx[i]);
+        }
+    }
+}
+
+TEST_CASE("XPT2046: Burst results decode from the overlapped stream", "[xpt2046]")
+{
+    const uint16_t results[5] = { 0x000, 0xFFF, 0x800, 0x123, 0xABC };
+    uint8_t rx[XPT2046_BURST_BYTES(5)];
+    uint16_t values[5];
+    
+    xpt2046_simulate(results, 5, rx);
+    rx[0] = 0xFF;                           // Clocked out during the first command: ignored
+    xpt2046_burst_decode(rx, 5, values);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(results, values, 5);
+    
+    // A single conversion is the classic 3-byte transaction
+    TEST_ASSERT_EQUAL(3, XPT2046_BURST_BYTES(1));
+}
+
+TEST_CASE("XPT2046: Filter drops the extreme samples", "[xpt2046]")
+{
+    const uint16_t noisy[4] = { 2000, 2010, 3900, 2004 };     // One spike
+    const uint16_t pair[2] = { 1001, 1002 };
+    
+    TEST_ASSERT_EQUAL(2007, xpt2046_filter(noisy, 4));
+    TEST_ASSERT_EQUAL(1002, xpt2046_filter(pair, 2));     // Average, rounded
+    TEST_ASSERT_EQUAL(0, xpt2046_filter(noisy, 0));
+}
+
+// =============================================================================
+// POWER RESIDENCY TESTS
+// =============================================================================
+
+static const uint32_t test_power_ua[POWER_STATE_COUNT] = { 100000, 50000, 2000, 150000 };
+
+TEST_CASE("Power: Residency accumulates per state", "[power]")
+{
+    power_residency_t res;
+    uint64_t time_us[POWER_STATE_COUNT];
+    
+    power_residency_reset(&res, POWER_ACTIVE, 1000000);
+    power_residency_enter(&res, POWER_DIMMED, 31000000);    // 30 s active
+    power_residency_enter(&res, POWER_ASLEEP, 61000000);    // 30 s dimmed
+    power_residency_enter(&res, POWER_ACTIVE, 661000000);   // 600 s asleep
+    
+    // The open interval of the current state is included
+    power_residency_snapshot(&res, 671000000, time_us);
+    TEST_ASSERT_EQUAL(40000000, time_us[POWER_ACTIVE]);
+    TEST_ASSERT_EQUAL(30000000, time_us[POWER_DIMMED]);
+    TEST_ASSERT_EQUAL(600000000, time_us[POWER_ASLEEP]);
+    TEST_ASSERT_EQUAL(0, time_us[POWER_HID]);
+    
+    // A clock that has not moved adds nothing
+    power_residency_enter(&res, POWER_HID, 661000000);
+    power_residency_snapshot(&res, 661000000, time_us);
+    TEST_ASSERT_EQUAL(0, time_us[POWER_HID]);
+}
+
+TEST_CASE("Power: Average current weights states by residency", "[power]")
+{
+    power_residency_t res;
+    const uint32_t all = (1u << POWER_STATE_COUNT) - 1;
+    
+    // Typing session: 9 s with the display on, 1 s sending reports
+    power_residency_reset(&res, POWER_ACTIVE, 0);
+    TEST_ASSERT_EQUAL(POWER_ACTIVE, power_residency_enter(&res, POWER_HID, 9000000));
+    TEST_ASSERT_EQUAL(POWER_ACTIVE, power_residency_leave_hid(&res, 10000000));
+    TEST_ASSERT_EQUAL(105000, power_residency_average_ua(&res, 10000000, test_power_ua, all));
+    
+    // Then on the desk: 30 s dimmed, an hour asleep
+    power_residency_enter(&res, POWER_DIMMED, 10000000);
+    power_residency_enter(&res, POWER_ASLEEP, 40000000);
+    uint64_t end = 3640000000ULL;
+    uint32_t idle = power_residency_average_ua(&res, end, test_power_ua,
+                                               (1u << POWER_DIMMED) | (1u << POWER_ASLEEP));
+    TEST_ASSERT_INT_WITHIN(1, (50000 * 30 + 2000 * 3600) / 3630, idle);
+    TEST_ASSERT_EQUAL(105000, power_residency_average_ua(&res, end, test_power_ua,
+                                                         (1u << POWER_ACTIVE) | (1u << POWER_HID)));
+    
+    // No time in the selected states
+    power_residency_reset(&res, POWER_ACTIVE, 0);
+    TEST_ASSERT_EQUAL(0, power_residency_average_ua(&res, 5000, test_power_ua, 1u << POWER_ASLEEP));
+}
+
+TEST_CASE("Power: HID overlays the display state", "[power]")
+{
+    power_residency_t res;
+    uint64_t time_us[POWER_STATE_COUNT];
+    
+    // The panel dims 2 s into a 5 s macro: typing continues, then the dimmed state follows
+    power_residency_reset(&res, POWER_ACTIVE, 0);
+    power_residency_enter(&res, POWER_HID, 1000000);
+    TEST_ASSERT_EQUAL(POWER_HID, power_residency_enter(&res, POWER_DIMMED, 3000000));
+    TEST_ASSERT_EQUAL(POWER_HID, res.state);
+    TEST_ASSERT_EQUAL(POWER_DIMMED, power_residency_leave_hid(&res, 6000000));
+    
+    power_residency_snapshot(&res, 8000000, time_us);
+    TEST_ASSERT_EQUAL(1000000, time_us[POWER_ACTIVE]);
+    TEST_ASSERT_EQUAL(5000000, time_us[POWER_HID]);
+    TEST_ASSERT_EQUAL(2000000, time_us[POWER_DIMMED]);
+    
+    // Leaving HID when not in it changes nothing
+    TEST_ASSERT_EQUAL(POWER_DIMMED, power_residency_leave_hid(&res, 9000000));
+}
+
+// =============================================================================
+// CPU LOAD TESTS
+// =============================================================================
+
+static void test_cpu_task(cpu_load_snapshot_t *snap, uint32_t id, const char *name, int core, bool idle,
+                          uint32_t run_time)
+{
+    cpu_load_task_t *task = &snap->tasks[snap->count++];
+    task->id = id;
+    strncpy(task->name, name, CPU_LOAD_NAME_LEN - 1);
+    task->name[CPU_LOAD_NAME_LEN - 1] = '\0';
+    task->core = (int8_t)core;
+    task->idle = idle;
+    task->run_time = run_time;
+}
+
+TEST_CASE("CPU load: Core load from idle time, tasks busiest first", "[cpuload]")
+{
+    static cpu_load_snapshot_t before, after;
+    static cpu_load_t load;
+    memset(&before, 0, sizeof(before));
+    memset(&after, 0, sizeof(after));
+    
+    before.total_run_time = 1000000;
+    test_cpu_task(&before, 1, "IDLE0", 0, true, 500000);
+    test_cpu_task(&before, 2, "IDLE1", 1, true, 400000);
+    test_cpu_task(&before, 3, "btc_task", 0, false, 10000);
+    test_cpu_task(&before, 4, "touch_task", 1, false, 20000);
+    test_cpu_task(&before, 5, "storage_task", CPU_LOAD_NO_CORE, false, 3000);
+    
+    // One second later: core 0 idle 900 ms, core 1 idle 700 ms
+    after.total_run_time = 2000000;
+    test_cpu_task(&after, 1, "IDLE0", 0, true, 1400000);
+    test_cpu_task(&after, 2, "IDLE1", 1, true, 1100000);
+    test_cpu_task(&after, 3, "btc_task", 0, false, 90000);
+    test_cpu_task(&after, 4, "touch_task", 1, false, 270000);
+    test_cpu_task(&after, 5, "storage_task", CPU_LOAD_NO_CORE, false, 3000);
+    
+    TEST_ASSERT_TRUE(cpu_load_compute(&before, &after, &load));
+    TEST_ASSERT_EQUAL(1000000, load.elapsed);
+    TEST_ASSERT_EQUAL(100, load.core_permille[0]);
+    TEST_ASSERT_EQUAL(300, load.core_permille[1]);
+    
+    // Idle tasks are not listed
+    TEST_ASSERT_EQUAL(3, load.count);
+    TEST_ASSERT_EQUAL_STRING("touch_task", load.tasks[0].name);
+    TEST_ASSERT_EQUAL(250, load.tasks[0].permille);
+    TEST_ASSERT_EQUAL(1, load.tasks[0].core);
+    TEST_ASSERT_EQUAL_STRING("btc_task", load.tasks[1].name);
+    TEST_ASSERT_EQUAL(80, load.tasks[1].permille);
+    TEST_ASSERT_EQUAL_STRING("storage_task", load.tasks[2].name);
+    TEST_ASSERT_EQUAL(0, load.tasks[2].run_time);
+    TEST_ASSERT_EQUAL(CPU_LOAD_NO_CORE, load.tasks[2].core);
+}
+
+TEST_CASE("CPU load: New tasks, counter wrap and missing cores", "[cpuload]")
+{
+    static cpu_load_snapshot_t before, after;
+    static cpu_load_t load;
+    memset(&before, 0, sizeof(before));
+    memset(&after, 0, sizeof(after));
+    
+    // The run-time clock wraps between the snapshots; single core build
+    before.total_run_time = 0xFFFF0000u;
+    test_cpu_task(&before, 1, "IDLE0", 0, true, 0xFFF00000u);
+    after.total_run_time = 0x00010000u;                             // 0x20000 later
+    test_cpu_task(&after, 1, "IDLE0", 0, true, 0xFFF10000u);        // Idle half the time
+    test_cpu_task(&after, 7, "hid_task", 0, false, 0x8000);         // Created in between
+    
+    TEST_ASSERT_TRUE(cpu_load_compute(&before, &after, &load));
+    TEST_ASSERT_EQUAL(0x20000, load.elapsed);
+    TEST_ASSERT_EQUAL(500, load.core_permille[0]);
+    TEST_ASSERT_EQUAL(CPU_LOAD_UNKNOWN, load.core_permille[1]);
+    TEST_ASSERT_EQUAL(1, load.count);
+    TEST_ASSERT_EQUAL(250, load.tasks[0].permille);
+    
+    // No time between the snapshots
+    TEST_ASSERT_FALSE(cpu_load_compute(&after, &after, &load));
+}
+
 // =============================================================================
 // INTEGRATION TESTS
 // =============================================================================
@@ -0,0 +1,128 @@
+/*
+ * bench_touch_map.c - Host benchmark of the touch mapping (main/touch_cal.c)
+ *
+ * Maps every raw (x, y) pair of the 12-bit XPT2046 range, 4096 x 4096, with
+ * the per-sample division the firmware used to do and with the precomputed
+ * Q16 matrix it uses now, for the uncalibrated default and for a two-point
+ * calibration. Reports time per sample, how often the two disagree and the
+ * worst distance of each from the exact (real-valued) mapping.
+ *
+ * Build and run from the repository root:
+ *     cc -O2 -Imain tools/bench_touch_map.c main/touch_cal.c -lm -o bench_touch_map
+ *     ./bench_touch_map
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "touch_cal.h"
+
+#define RAW_MAX     4095
+#define WIDTH       320
+#define HEIGHT      240
+
+typedef struct {
+    const char *name;
+    uint16_t x_min, x_max;      // raw_y range across the width
+    uint16_t y_min, y_max;      // raw_x range down the height
+} range_case_t;
+
+static const range_case_t cases[] = {
+    { "uncalibrated", 0, RAW_MAX, 0, RAW_MAX },
+    { "two-point",    312, 3781, 247, 3890 },
+};
+
+static volatile uint32_t sink;      // Keeps the loops from being optimized out
+
+/**
+ * The former per-sample mapping: clamp to the range, then divide
+ */
+static inline uint16_t map_divide(uint16_t raw, uint16_t min, uint16_t max, uint16_t size)
+{
+    if (raw < min) raw = min;
+    if (raw > max) raw = max;
+    uint32_t range = max - min;
+    if (range == 0) range = 1;
+    uint16_t v = ((uint32_t)(raw - min) * size) / range;
+    return v >= size ? size - 1 : v;
+}
+
+static inline uint16_t clamp(int32_t v, uint16_t size)
+{
+    return (v < 0) ? 0 : (v >= size) ? size - 1 : (uint16_t)v;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double exact(uint16_t raw, uint16_t min, uint16_t max, uint16_t size)
+{
+    double v = (double)((int)raw - (int)min) * size / (max - min);
+    return (v < 0) ? 0 : (v > size - 1) ? size - 1 : v;
+}
+
+int main(void)
+{
+    const double samples = (double)(RAW_MAX + 1) * (RAW_MAX + 1);
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const range_case_t *rc = &cases[c];
+        touch_cal_matrix_t m;
+        touch_cal_from_ranges(&m, rc->x_min, rc->x_max, WIDTH, rc->y_min, rc->y_max, HEIGHT);
+
+        // Timing passes
+        uint32_t acc = 0;
+        double t0 = now_s();
+        for (uint32_t rx = 0; rx <= RAW_MAX; rx++) {
+            for (uint32_t ry = 0; ry <= RAW_MAX; ry++) {
+                acc += map_divide(ry, rc->x_min, rc->x_max, WIDTH);
+                acc += map_divide(rx, rc->y_min, rc->y_max, HEIGHT);
+            }
+        }
+        double t1 = now_s();
+        for (uint32_t rx = 0; rx <= RAW_MAX; rx++) {
+            for (uint32_t ry = 0; ry <= RAW_MAX; ry++) {
+                int32_t x, y;
+                touch_cal_apply(&m, rx, ry, &x, &y);
+                acc += clamp(x, WIDTH) + clamp(y, HEIGHT);
+            }
+        }
+        double t2 = now_s();
+        sink = acc;
+
+        // Accuracy pass
+        uint64_t differ = 0;
+        double worst_divide = 0, worst_q16 = 0;
+        for (uint32_t rx = 0; rx <= RAW_MAX; rx++) {
+            for (uint32_t ry = 0; ry <= RAW_MAX; ry++) {
+                int32_t x, y;
+                touch_cal_apply(&m, rx, ry, &x, &y);
+                uint16_t qx = clamp(x, WIDTH), qy = clamp(y, HEIGHT);
+                uint16_t dx = map_divide(ry, rc->x_min, rc->x_max, WIDTH);
+                uint16_t dy = map_divide(rx, rc->y_min, rc->y_max, HEIGHT);
+                double ex = exact(ry, rc->x_min, rc->x_max, WIDTH);
+                double ey = exact(rx, rc->y_min, rc->y_max, HEIGHT);
+
+                differ += (qx != dx) || (qy != dy);
+                worst_divide = fmax(worst_divide, fmax(fabs(dx - ex), fabs(dy - ey)));
+                worst_q16 = fmax(worst_q16, fmax(fabs(qx - ex), fabs(qy - ey)));
+            }
+        }
+
+        printf("%s: %.0f samples\n", rc->name, samples);
+        printf("  divide: %5.2f ns/sample, worst error %.3f px\n", (t1 - t0) * 1e9 / samples, worst_divide);
+        printf("  q16:    %5.2f ns/sample, worst error %.3f px\n", (t2 - t1) * 1e9 / samples, worst_q16);
+        printf("  %llu samples (%.2f%%) map to a different pixel (truncation -> rounding)\n",
+               (unsigned long long)differ, differ * 100.0 / samples);
+
+        if (worst_q16 > 0.5 + 1.0 / 16) {
+            printf("  FAIL: Q16 mapping is off by more than half a pixel\n");
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,393 @@
+#!/usr/bin/env python3
+"""
+gen_font.py - Generate an anti-aliased proportional bitmap font for the firmware
+
+Rasterizes the printable ASCII range (32-126) of a TrueType font into 4-bit
+coverage bitmaps and writes a C source file with the packed glyph data, the
+per-glyph metrics and the advance table used by main/aa_font.c.
+
+Pure Python (standard library only): parses the cmap/loca/glyf/hmtx tables
+itself and rasterizes outlines with 4x4 supersampling and the non-zero
+winding rule. No hinting is applied; the baseline is snapped to a pixel row.
+
+Usage:
+    python3 tools/gen_font.py FONT.ttf PIXEL_SIZE NAME OUTPUT.c [--notice TEXT] [--license PATH]
+
+    --notice TEXT   Copyright/license notice copied into the file header
+    --license PATH  Full license text shipped with the repo, referenced from the header
+
+Example (the font shipped in main/font_sans15.c, Lato under the SIL OFL 1.1):
+    python3 tools/gen_font.py Lato-Regular.ttf 15 sans15 main/font_sans15.c \
+        --notice "<the Lato notice from the header of main/font_sans15.c>" \
+        --license licenses/OFL-Lato.txt
+
+Packed format (see aa_font.h):
+    Each glyph bitmap is width*height 4-bit alpha values, row-major, two per
+    byte (first pixel in the high nibble), padded to a whole byte per glyph.
+"""
+
+import math
+import struct
+import sys
+
+FIRST_CHAR = 32
+LAST_CHAR = 126
+SUPERSAMPLE = 4         # 4x4 samples per pixel -> 17 coverage levels, quantized to 0-15
+CURVE_STEPS = 8         # Line segments per quadratic curve
+
+
+# =============================================================================
+# TRUETYPE PARSING
+# =============================================================================
+
+class TrueTypeFont:
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        self.tables = {}
+        num_tables = struct.unpack_from('>H', self.data, 4)[0]
+        for i in range(num_tables):
+            tag, _, offset, length = struct.unpack_from('>4sIII', self.data, 12 + 16 * i)
+            self.tables[tag.decode('latin-1')] = (offset, length)
+
+        head = self.tables['head'][0]
+        self.units_per_em = struct.unpack_from('>H', self.data, head + 18)[0]
+        self.index_to_loc_format = struct.unpack_from('>h', self.data, head + 50)[0]
+
+        hhea = self.tables['hhea'][0]
+        self.ascender, self.descender, self.line_gap = struct.unpack_from('>hhh', self.data, hhea + 4)
+        self.num_hmetrics = struct.unpack_from('>H', self.data, hhea + 34)[0]
+
+        self.num_glyphs = struct.unpack_from('>H', self.data, self.tables['maxp'][0] + 4)[0]
+        self.cmap = self._parse_cmap()
+
+    def _parse_cmap(self):
+        base = self.tables['cmap'][0]
+        num_subtables = struct.unpack_from('>H', self.data, base + 2)[0]
+        for i in range(num_subtables):
+            platform, encoding, offset = struct.unpack_from('>HHI', self.data, base + 4 + 8 * i)
+            sub = base + offset
+            fmt = struct.unpack_from('>H', self.data, sub)[0]
+            if fmt == 4 and (platform, encoding) in ((3, 1), (0, 3), (0, 4)):
+                return self._parse_cmap4(sub)
+        raise ValueError('no Unicode BMP (format 4) cmap subtable')
+
+    def _parse_cmap4(self, sub):
+        seg_count = struct.unpack_from('>H', self.data, sub + 6)[0] // 2
+        end_codes = sub + 14
+        start_codes = end_codes + 2 * seg_count + 2
+        id_deltas = start_codes + 2 * seg_count
+        id_range_offsets = id_deltas + 2 * seg_count
+        mapping = {}
+        for seg in range(seg_count):
+            end = struct.unpack_from('>H', self.data, end_codes + 2 * seg)[0]
+            start = struct.unpack_from('>H', self.data, start_codes + 2 * seg)[0]
+            delta = struct.unpack_from('>h', self.data, id_deltas + 2 * seg)[0]
+            range_offset = struct.unpack_from('>H', self.data, id_range_offsets + 2 * seg)[0]
+            for code in range(start, min(end, 0x7F) + 1):
+                if range_offset == 0:
+                    glyph = (code + delta) & 0xFFFF
+                else:
+                    addr = id_range_offsets + 2 * seg + range_offset + 2 * (code - start)
+                    glyph = struct.unpack_from('>H', self.data, addr)[0]
+                    if glyph != 0:
+                        glyph = (glyph + delta) & 0xFFFF
+                mapping[code] = glyph
+        return mapping
+
+    def advance_width(self, glyph):
+        hmtx = self.tables['hmtx'][0]
+        index = min(glyph, self.num_hmetrics - 1)
+        return struct.unpack_from('>H', self.data, hmtx + 4 * index)[0]
+
+    def _glyph_location(self, glyph):
+        loca = self.tables['loca'][0]
+        if self.index_to_loc_format == 0:
+            start, end = struct.unpack_from('>HH', self.data, loca + 2 * glyph)
+            start, end = start * 2, end * 2
+        else:
+            start, end = struct.unpack_from('>II', self.data, loca + 4 * glyph)
+        return self.tables['glyf'][0] + start, end - start
+
+    def contours(self, glyph):
+        """Return the outline as a list of contours of (x, y, on_curve) points"""
+        offset, length = self._glyph_location(glyph)
+        if length == 0:
+            return []
+        num_contours = struct.unpack_from('>h', self.data, offset)[0]
+        if num_contours >= 0:
+            return self._simple_contours(offset, num_contours)
+        return self._composite_contours(offset)
+
+    def _simple_contours(self, offset, num_contours):
+        pos = offset + 10
+        end_points = struct.unpack_from('>%dH' % num_contours, self.data, pos)
+        pos += 2 * num_contours
+        instruction_len = struct.unpack_from('>H', self.data, pos)[0]
+        pos += 2 + instruction_len
+        num_points = end_points[-1] + 1 if num_contours else 0
+
+        flags = []
+        while len(flags) < num_points:
+            flag = self.data[pos]
+            pos += 1
+            flags.append(flag)
+            if flag & 0x08:
+                repeat = self.data[pos]
+                pos += 1
+                flags.extend([flag] * repeat)
+        flags = flags[:num_points]
+
+        def read_coords(short_bit, same_bit):
+            nonlocal pos
+            values, value = [], 0
+            for flag in flags:
+                if flag & short_bit:
+                    delta = self.data[pos]
+                    pos += 1
+                    value += delta if flag & same_bit else -delta
+                elif not flag & same_bit:
+                    value += struct.unpack_from('>h', self.data, pos)[0]
+                    pos += 2
+                values.append(value)
+            return values
+
+        xs = read_coords(0x02, 0x10)
+        ys = read_coords(0x04, 0x20)
+
+        contours, start = [], 0
+        for end in end_points:
+            contours.append([(xs[i], ys[i], bool(flags[i] & 0x01)) for i in range(start, end + 1)])
+            start = end + 1
+        return contours
+
+    def _composite_contours(self, offset):
+        pos = offset + 10
+        contours = []
+        while True:
+            flags, glyph = struct.unpack_from('>HH', self.data, pos)
+            pos += 4
+            if flags & 0x0001:
+                dx, dy = struct.unpack_from('>hh', self.data, pos)
+                pos += 4
+            else:
+                dx, dy = struct.unpack_from('>bb', self.data, pos)
+                pos += 2
+            scale = (1.0, 0.0, 0.0, 1.0)
+            if flags & 0x0008:
+                s = struct.unpack_from('>h', self.data, pos)[0] / 16384.0
+                scale = (s, 0.0, 0.0, s)
+                pos += 2
+            elif flags & 0x0040:
+                sx, sy = struct.unpack_from('>hh', self.data, pos)
+                scale = (sx / 16384.0, 0.0, 0.0, sy / 16384.0)
+                pos += 4
+            elif flags & 0x0080:
+                scale = tuple(v / 16384.0 for v in struct.unpack_from('>hhhh', self.data, pos))
+                pos += 8
+            if not flags & 0x0002:
+                raise ValueError('point-matched composite glyphs are not supported')
+            a, b, c, d = scale
+            for contour in self.contours(glyph):
+                contours.append([(a * x + c * y + dx, b * x + d * y + dy, on) for x, y, on in contour])
+            if not flags & 0x0020:
+                break
+        return contours
+
+
+# =============================================================================
+# RASTERIZATION
+# =============================================================================
+
+def flatten(contour, scale):
+    """Convert a quadratic TrueType contour into a closed polyline in pixels"""
+    points = [(x * scale, y * scale, on) for x, y, on in contour]
+    if not points:
+        return []
+
+    # Start on an on-curve point (insert an implied one if there is none)
+    start = next((i for i, p in enumerate(points) if p[2]), None)
+    if start is None:
+        a, b = points[0], points[1]
+        points.insert(0, ((a[0] + b[0]) / 2, (a[1] + b[1]) / 2, True))
+        start = 0
+    points = points[start:] + points[:start]
+
+    polyline = [(points[0][0], points[0][1])]
+    control = None
+    for x, y, on in points[1:] + [points[0]]:
+        if on:
+            if control is None:
+                polyline.append((x, y))
+            else:
+                polyline.extend(quad(polyline[-1], control, (x, y)))
+                control = None
+        else:
+            if control is not None:
+                mid = ((control[0] + x) / 2, (control[1] + y) / 2)
+                polyline.extend(quad(polyline[-1], control, mid))
+            control = (x, y)
+    return polyline
+
+
+def quad(p0, p1, p2):
+    result = []
+    for step in range(1, CURVE_STEPS + 1):
+        t = step / CURVE_STEPS
+        u = 1 - t
+        result.append((u * u * p0[0] + 2 * u * t * p1[0] + t * t * p2[0],
+                       u * u * p0[1] + 2 * u * t * p1[1] + t * t * p2[1]))
+    return result
+
+
+def rasterize(polylines, x0, y_top, width, height):
+    """4-bit coverage bitmap; x0/y_top are the pixel coordinates of the top-left corner"""
+    edges = []
+    for poly in polylines:
+        for (ax, ay), (bx, by) in zip(poly, poly[1:] + poly[:1]):
+            if ay != by:
+                edges.append((ax, ay, bx, by))
+
+    coverage = [[0] * width for _ in range(height)]
+    n = SUPERSAMPLE
+    for row in range(height):
+        for sub_y in range(n):
+            # Font units have y up; bitmap rows go down
+            y = y_top - (row + (sub_y + 0.5) / n)
+            crossings = []
+            for ax, ay, bx, by in edges:
+                if (ay <= y < by) or (by <= y < ay):
+                    x = ax + (y - ay) * (bx - ax) / (by - ay)
+                    crossings.append((x, 1 if by > ay else -1))
+            crossings.sort()
+            winding = 0
+            for i, (x, direction) in enumerate(crossings):
+                previous = winding
+                winding += direction
+                if previous == 0 and winding != 0:
+                    span_start = x
+                elif previous != 0 and winding == 0:
+                    fill_span(coverage[row], span_start - x0, x - x0, n)
+    return [[min(15, (c * 15 + (n * n) // 2) // (n * n)) for c in line] for line in coverage]
+
+
+def fill_span(line, start, end, n):
+    """Add the sub-samples of one sub-scanline between start and end (pixel units)"""
+    first = max(0, int(math.floor(start * n - 0.5)))
+    last = min(len(line) * n - 1, int(math.ceil(end * n - 0.5)))
+    for sample in range(first, last + 1):
+        center = (sample + 0.5) / n
+        if start <= center < end:
+            line[sample // n] += 1
+
+
+# =============================================================================
+# OUTPUT
+# =============================================================================
+
+def build(font, pixel_size):
+    scale = pixel_size / font.units_per_em
+    ascent = int(math.ceil(font.ascender * scale))
+    descent = int(math.ceil(-font.descender * scale))
+    glyphs, bitmap = [], bytearray()
+
+    for code in range(FIRST_CHAR, LAST_CHAR + 1):
+        glyph = font.cmap.get(code, 0)
+        advance = int(round(font.advance_width(glyph) * scale))
+        polylines = [flatten(c, scale) for c in font.contours(glyph)]
+        points = [p for poly in polylines for p in poly]
+        if not points:
+            glyphs.append((len(bitmap), 0, 0, 0, 0, advance))
+            continue
+
+        x_min = int(math.floor(min(p[0] for p in points)))
+        x_max = int(math.ceil(max(p[0] for p in points)))
+        y_min = int(math.floor(min(p[1] for p in points)))
+        y_max = int(math.ceil(max(p[1] for p in points)))
+        width, height = x_max - x_min, y_max - y_min
+
+        alpha = rasterize(polylines, x_min, y_max, width, height)
+        pixels = [a for line in alpha for a in line]
+        if len(pixels) % 2:
+            pixels.append(0)
+        offset = len(bitmap)
+        for i in range(0, len(pixels), 2):
+            bitmap.append((pixels[i] << 4) | pixels[i + 1])
+
+        # x offset from the pen position, y offset from the top of the line
+        glyphs.append((offset, width, height, x_min, ascent - y_max, advance))
+
+    return glyphs, bitmap, ascent, ascent + descent
+
+
+def write_source(path, name, pixel_size, font_file, notice, license_path, glyphs, bitmap, ascent, line_height):
+    out = []
+    out.append('/*')
+    out.append(' * %s - %d px anti-aliased proportional font (4-bit alpha)' % (path.split('/')[-1], pixel_size))
+    out.append(' *')
+    out.append(' * GENERATED FILE - do not edit. Regenerate with:')
+    out.append(' *   python3 tools/gen_font.py %s %d %s %s' % (font_file.split('/')[-1], pixel_size, name, path))
+    if notice:
+        out.append(' *')
+        for line in notice.split('\n'):
+            out.append((' * ' + line).rstrip())
+    if license_path:
+        out.append(' *')
+        out.append(' * Full license text: %s' % license_path)
+    out.append(' */')
+    out.append('')
+    out.append('#include "aa_font.h"')
+    out.append('')
+    out.append('static const uint8_t %s_bitmaps[%d] = {' % (name, len(bitmap)))
+    for i in range(0, len(bitmap), 16):
+        out.append('    ' + ' '.join('0x%02X,' % b for b in bitmap[i:i + 16]))
+    out.append('};')
+    out.append('')
+    out.append('static const aa_glyph_t %s_glyphs[%d] = {' % (name, len(glyphs)))
+    out.append('    // offset  w   h   x    y   adv')
+    for code, (offset, width, height, x_off, y_off, advance) in zip(range(FIRST_CHAR, LAST_CHAR + 1), glyphs):
+        label = {ord('\\'): 'backslash', ord("'"): 'quote'}.get(code, chr(code))
+        out.append('    { %5d, %2d, %2d, %3d, %3d, %2d },   // %s' %
+                   (offset, width, height, x_off, y_off, advance, label))
+    out.append('};')
+    out.append('')
+    out.append('static const uint8_t %s_advances[%d] = {' % (name, len(glyphs)))
+    advances = [g[5] for g in glyphs]
+    for i in range(0, len(advances), 16):
+        out.append('    ' + ' '.join('%d,' % a for a in advances[i:i + 16]))
+    out.append('};')
+    out.append('')
+    out.append('const aa_font_t font_%s = {' % name)
+    out.append('    .bitmaps = %s_bitmaps,' % name)
+    out.append('    .glyphs = %s_glyphs,' % name)
+    out.append('    .advances = %s_advances,' % name)
+    out.append('    .first_char = %d,' % FIRST_CHAR)
+    out.append('    .last_char = %d,' % LAST_CHAR)
+    out.append('    .ascent = %d,' % ascent)
+    out.append('    .line_height = %d,' % line_height)
+    out.append('};')
+    with open(path, 'w') as f:
+        f.write('\n'.join(out) + '\n')
+
+
+def main(argv):
+    if len(argv) < 5:
+        print(__doc__)
+        return 1
+    font_file, pixel_size, name, output = argv[1], int(argv[2]), argv[3], argv[4]
+    notice = ''
+    if '--notice' in argv:
+        notice = argv[argv.index('--notice') + 1]
+    license_path = ''
+    if '--license' in argv:
+        license_path = argv[argv.index('--license') + 1]
+
+    font = TrueTypeFont(font_file)
+    glyphs, bitmap, ascent, line_height = build(font, pixel_size)
+    write_source(output, name, pixel_size, font_file, notice, license_path, glyphs, bitmap, ascent, line_height)
+    print('%s: %d glyphs, %d bitmap bytes, line height %d' % (output, len(glyphs), len(bitmap), line_height))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
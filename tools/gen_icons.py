@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""
+gen_icons.py - Generate palette + run-length compressed icons for the firmware
+
+Reads ASCII-art icon definitions and writes a C source file with one const
+icon_t per icon, in the format decoded by main/icon.c.
+
+Usage:
+    python3 tools/gen_icons.py tools/icons.txt main/icons.c
+
+Source format (see tools/icons.txt):
+    icon NAME
+    CHAR = 0xRRGG           RGB565 color for CHAR
+    CHAR = transparent      CHAR is drawn in the background color
+    <pixel rows>            one character per pixel, all rows the same width
+
+Packed format (see icon.h):
+    Pixels are palette indices (at most 16 colors), row-major, as runs of
+    1-16 pixels: one byte per run, (length - 1) << 4 | index.
+"""
+
+import sys
+
+MAX_COLORS = 16
+MAX_RUN = 16
+OPAQUE = 0xFF
+
+
+def parse(path):
+    icons = []
+    current = None
+    with open(path) as f:
+        for number, raw in enumerate(f, 1):
+            line = raw.rstrip('\n')
+            if not line.strip() or line.startswith('#'):
+                continue
+            where = '%s:%d' % (path, number)
+            if line.startswith('icon '):
+                current = {'name': line.split()[1], 'colors': {}, 'rows': [], 'where': where}
+                icons.append(current)
+            elif current is None:
+                sys.exit('%s: pixel data before the first "icon" line' % where)
+            elif len(line) > 2 and line[1:].lstrip().startswith('=') and not current['rows']:
+                char, value = line[0], line.split('=', 1)[1].strip()
+                current['colors'][char] = None if value == 'transparent' else int(value, 16)
+            else:
+                if current['rows'] and len(line) != len(current['rows'][0]):
+                    sys.exit('%s: row width %d, expected %d' % (where, len(line), len(current['rows'][0])))
+                current['rows'].append(line)
+    return icons
+
+
+def encode(icon):
+    chars = list(icon['colors'])
+    if len(chars) > MAX_COLORS:
+        sys.exit('%s: %d colors (maximum %d)' % (icon['where'], len(chars), MAX_COLORS))
+
+    palette = [icon['colors'][c] or 0 for c in chars]
+    transparent = OPAQUE
+    for i, c in enumerate(chars):
+        if icon['colors'][c] is None:
+            transparent = i
+
+    pixels = []
+    for row in icon['rows']:
+        for c in row:
+            if c not in icon['colors']:
+                sys.exit('%s: undefined color %r in %s' % (icon['where'], c, icon['name']))
+            pixels.append(chars.index(c))
+
+    runs = bytearray()
+    i = 0
+    while i < len(pixels):
+        length = 1
+        while i + length < len(pixels) and length < MAX_RUN and pixels[i + length] == pixels[i]:
+            length += 1
+        runs.append(((length - 1) << 4) | pixels[i])
+        i += length
+    return palette, transparent, runs
+
+
+def write_source(path, source, icons):
+    out = []
+    out.append('/*')
+    out.append(' * %s - Palette + run-length compressed icons' % path.split('/')[-1])
+    out.append(' *')
+    out.append(' * GENERATED FILE - do not edit. Edit %s and regenerate with:' % source)
+    out.append(' *   python3 tools/gen_icons.py %s %s' % (source, path))
+    out.append(' */')
+    out.append('')
+    out.append('#include "icon.h"')
+
+    for icon in icons:
+        name = icon['name']
+        palette, transparent, runs = encode(icon)
+        width, height = len(icon['rows'][0]), len(icon['rows'])
+        out.append('')
+        out.append('// %s: %dx%d, %d colors, %d bytes (%d as raw RGB565)' %
+                   (name, width, height, len(palette), len(runs), width * height * 2))
+        out.append('static const uint16_t %s_palette[%d] = {' % (name, len(palette)))
+        out.append('    ' + ' '.join('0x%04X,' % c for c in palette))
+        out.append('};')
+        out.append('')
+        out.append('static const uint8_t %s_data[%d] = {' % (name, len(runs)))
+        for i in range(0, len(runs), 16):
+            out.append('    ' + ' '.join('0x%02X,' % b for b in runs[i:i + 16]))
+        out.append('};')
+        out.append('')
+        out.append('const icon_t icon_%s = {' % name)
+        out.append('    .width = %d,' % width)
+        out.append('    .height = %d,' % height)
+        out.append('    .palette = %s_palette,' % name)
+        out.append('    .palette_size = %d,' % len(palette))
+        out.append('    .transparent = %s,' % ('ICON_OPAQUE' if transparent == OPAQUE else transparent))
+        out.append('    .data = %s_data,' % name)
+        out.append('    .data_size = sizeof(%s_data),' % name)
+        out.append('};')
+
+    with open(path, 'w') as f:
+        f.write('\n'.join(out) + '\n')
+
+
+def main(argv):
+    if len(argv) != 3:
+        print(__doc__)
+        return 1
+    icons = parse(argv[1])
+    write_source(argv[2], argv[1], icons)
+    for icon in icons:
+        _, _, runs = encode(icon)
+        raw = len(icon['rows'][0]) * len(icon['rows']) * 2
+        print('%s: %d bytes (%d raw)' % (icon['name'], len(runs), raw))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))